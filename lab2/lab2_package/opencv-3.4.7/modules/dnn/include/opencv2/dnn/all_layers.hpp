@@ -267,6 +267,21 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
         static Ptr<PoolingLayer> create(const LayerParams& params);
     };
 
+    /**
+     * @brief Spatial pyramid pooling (fast) block of YOLOv5 and later detectors.
+     *
+     * Concatenates input with @p numPools chained max poolings by square kernel
+     * of @p kernelSize (stride 1, same padding) along channels. Output shape is
+     * [N, C * (numPools + 1), H, W].
+     */
+    class CV_EXPORTS SPPFLayer : public Layer
+    {
+    public:
+        int kernelSize, numPools;
+
+        static Ptr<SPPFLayer> create(const LayerParams& params);
+    };
+
     class CV_EXPORTS SoftmaxLayer : public Layer
     {
     public:
@@ -468,6 +483,13 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
         static Ptr<SigmoidLayer> create(const LayerParams &params);
     };
 
+    /** @brief Swish (SiLU) activation: \f$ y = x \cdot sigmoid(x) \f$ */
+    class CV_EXPORTS SwishLayer : public ActivationLayer
+    {
+    public:
+        static Ptr<SwishLayer> create(const LayerParams &params);
+    };
+
     class CV_EXPORTS BNLLLayer : public ActivationLayer
     {
     public:
@@ -560,6 +582,40 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
         static Ptr<DetectionOutputLayer> create(const LayerParams& params);
     };
 
+    /**
+     * @brief Decodes outputs of YOLO detection heads and applies non-maximum suppression.
+     *
+     * Takes raw outputs of the detection heads, one input per head, either in
+     * [N x anchors*(5 + classes) x H x W] (Darknet) or [N x anchors x H x W x (5 + classes)]
+     * (YOLOv5) layout, or already decoded boxes [N x numBoxes x (5 + classes)].
+     * Anchors with objectness below the confidence threshold are skipped before
+     * class scores are read.
+     *
+     * Output is a blob of [1 x 1 x N*keep_top_k x 7] with rows of
+     * [image_id, label, confidence, xmin, ymin, xmax, ymax] like DetectionOutputLayer's.
+     * Rows after the last detection are filled by zeros.
+     *
+     * @param decode Type of boxes decoding: "darknet" (default), "yolov5" or "none"
+     *               if the input is already decoded. Decoded boxes are normalized by
+     *               the network input size; for "none" coordinates are kept as is.
+     * @param anchors Anchors sizes in pixels as (width, height) pairs, sequentially for every head.
+     * @param strides Strides of the heads in pixels.
+     * @param sigmoid Whether to apply logistic activation to the inputs (default true,
+     *                false for "none" decoding).
+     * @param classes Number of classes, inferred from the input shape by default.
+     * @param confidence_threshold Minimal confidence (objectness times class score) of a detection.
+     * @param nms_threshold IoU threshold of non-maximum suppression, 0 to disable.
+     * @param keep_top_k Maximal number of detections per image after non-maximum suppression.
+     * @param top_k Maximal number of candidates with the highest confidences which
+     *              non-maximum suppression is applied to, 0 (default) means all of them.
+     * @param class_agnostic Suppress overlapping boxes of different classes.
+     */
+    class CV_EXPORTS YoloDetectionOutputLayer : public Layer
+    {
+    public:
+        static Ptr<YoloDetectionOutputLayer> create(const LayerParams& params);
+    };
+
     /**
      * @brief \f$ L_p \f$ - normalization layer.
      * @param p Normalization factor. The most common `p = 1` for \f$ L_1 \f$ -
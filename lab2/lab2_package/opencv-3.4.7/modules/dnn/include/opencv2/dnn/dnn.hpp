@@ -90,7 +90,8 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
         DNN_TARGET_OPENCL,
         DNN_TARGET_OPENCL_FP16,
         DNN_TARGET_MYRIAD,
-        DNN_TARGET_FPGA  //!< FPGA device with CPU fallbacks using Inference Engine's Heterogeneous plugin.
+        DNN_TARGET_FPGA,  //!< FPGA device with CPU fallbacks using Inference Engine's Heterogeneous plugin.
+        DNN_TARGET_CPU_FP16  //!< CPU with weights of convolution and fully connected layers kept in half precision.
     };
 
     CV_EXPORTS std::vector< std::pair<Backend, Target> > getAvailableBackends();
@@ -357,6 +358,26 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
         virtual ~Layer();
     };
 
+    /** @brief Profiling record of a single layer for the latest forward pass.
+     * @see Net::getLayersProfile
+     */
+    struct CV_EXPORTS LayerProfile
+    {
+        int id;                 //!< Layer id.
+        String name;            //!< Layer name.
+        String type;            //!< Layer type.
+        String kernel;          //!< Implementation which computed the layer: "AVX2", "SIMD128", "OpenCL", "Halide", "fused", etc.
+        int64 startTicks;       //!< Start of the layer computations relatively to the beginning of forward pass (in ticks).
+        int64 ticks;            //!< Computation time (in ticks).
+        int64 flops;            //!< Number of floating point operations, see Layer::getFLOPS().
+        size_t bytesRead;       //!< Size of layer's inputs and learned parameters.
+        size_t bytesWritten;    //!< Size of layer's outputs.
+        size_t allocatedBytes;  //!< Memory which was allocated for outputs and internal buffers of the layer at network setup.
+                                //!< It's zero if all of them reuse memory of the released blobs or are computed in-place.
+
+        LayerProfile() : id(-1), startTicks(0), ticks(0), flops(0), bytesRead(0), bytesWritten(0), allocatedBytes(0) {}
+    };
+
     /** @brief This class allows to create and manipulate comprehensive artificial neural networks.
      *
      * Neural network is presented as directed acyclic graph (DAG), where vertices are Layer instances,
@@ -382,9 +403,31 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
          */
         CV_WRAP static Net readFromModelOptimizer(const String& xml, const String& bin);
 
+        /** @brief Create a network from a cache file written by writeCache().
+         *  @param path path to the cache file.
+         *  @returns Net object.
+         *  @see readNetFromCache()
+         */
+        CV_WRAP static Net readFromCache(const String& path);
+
         /** Returns true if there are no layers in the network. */
         CV_WRAP bool empty() const;
 
+        /** @brief Creates an independent copy of the network which shares learned weights with this one.
+         *  @returns Net object with the same topology, preferable backend and target.
+         *  Every copy allocates its own intermediate blobs, so copies can be forwarded
+         *  concurrently from different threads while weights are kept in memory only once.
+         *
+         *  The copy gets the layers with their LayerParams (learned blobs are shared, not
+         *  duplicated), names of the network inputs, preferable backend and target, Halide
+         *  scheduling file, fusion flag and the limit set by setMaxAllocationPlans().
+         *  Everything created during allocation is not copied: layer instances, intermediate
+         *  blobs and allocation plans are made anew by the first forward() of the copy.
+         *  Input blobs set by setInput() are not copied as well, and neither are blobs
+         *  replaced by setParam(): the copy uses the blobs the layers were created with.
+         */
+        CV_WRAP Net clone() const;
+
         /** @brief Dump net to String
          *  @returns String with structure, hyperparameters, backend, target and fusion
          *  Call method after setInput(). To see correct backend, target and fusion run after forward().
@@ -395,6 +438,17 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
          *  @see dump()
          */
         CV_WRAP void dumpToFile(const String& path);
+
+        /** @brief Writes the network into a binary cache file.
+         *  @param path path to output file, `.dnncache` extension is recognized by readNet().
+         *
+         *  The cache keeps imported layers with their parameters and learned weights, connections,
+         *  inputs names, preferable backend, target and fusion flag. Reading it back with
+         *  readNetFromCache() skips parsing of the original model. Weights are aligned in the file
+         *  so they are used from the memory mapped file directly and shared between processes.
+         *  Cache files are not portable between OpenCV versions and platforms with different byte order.
+         */
+        CV_WRAP void writeCache(const String& path) const;
         /** @brief Adds new layer to the net.
          *  @param name   unique name of the adding layer.
          *  @param type   typename of the adding layer (type must be registered in LayerRegister).
@@ -526,6 +580,13 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
          * | DNN_TARGET_OPENCL_FP16 |                  + |                            + |                    |
          * | DNN_TARGET_MYRIAD      |                    |                            + |                    |
          * | DNN_TARGET_FPGA        |                    |                            + |                    |
+         * | DNN_TARGET_CPU_FP16    |                  + |                              |                    |
+         *
+         * DNN_TARGET_CPU_FP16 computes in single precision but convolution and fully connected
+         * layers keep their working copies of weights in half precision only and expand small
+         * tiles of them on the fly. It halves the memory traffic of weights at the cost of
+         * a small accuracy loss. Learned parameters of the network (see getParam(), clone())
+         * stay in single precision, so switching to another target restores the accuracy.
          */
         CV_WRAP void setPreferableTarget(int targetId);
 
@@ -653,6 +714,18 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
                                           const MatShape& netInputShape,
                                           CV_OUT size_t& weights, CV_OUT size_t& blobs) const;
 
+        /** @brief Computes bytes number which are required to store
+         * all weights and intermediate blobs for model considering reusing of blobs memory.
+         * @param netInputShapes vector of shapes for all net inputs.
+         * @param weights output parameter to store resulting bytes for weights.
+         * @param blobs output parameter to store resulting bytes for intermediate blobs.
+         * @param plannedBlobs output parameter to store bytes of memory arena where
+         * intermediate blobs are placed by the memory planner. Network inputs are not included.
+         */
+        void getMemoryConsumption(const std::vector<MatShape>& netInputShapes,
+                                  CV_OUT size_t& weights, CV_OUT size_t& blobs,
+                                  CV_OUT size_t& plannedBlobs) const;
+
         /** @brief Computes bytes number which are required to store
          * all weights and intermediate blobs for each layer.
          * @param netInputShapes vector of shapes for all net inputs.
@@ -675,6 +748,28 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
          */
         CV_WRAP void enableFusion(bool fusion);
 
+        /** @brief Sets the number of allocation plans kept for different input shapes.
+         * @param maxPlans maximal number of plans. Zero disables the plans (default).
+         *
+         * Every change of input shapes leads to shapes inference, memory planning and
+         * reallocation of the network blobs. With enabled plans, blobs allocated for
+         * recently used input shapes are kept so switching between a few input resolutions
+         * only finalizes and fuses layers. Each plan holds its own intermediate memory.
+         * Used by DNN_BACKEND_OPENCV with CPU targets only.
+         */
+        CV_WRAP void setMaxAllocationPlans(int maxPlans);
+
+        /** @brief Allocates the network for specified input shapes in advance.
+         * @param netInputShapes shapes of all the network inputs.
+         * @param outBlobNames names of the outputs which will be requested by forward().
+         * The latest layer of the network is used by default.
+         *
+         * Requires enabled allocation plans, see setMaxAllocationPlans().
+         * Inputs of the network set by setInput() are kept.
+         */
+        CV_WRAP void prepareAllocationPlan(const std::vector<MatShape>& netInputShapes,
+                                           const std::vector<String>& outBlobNames = std::vector<String>());
+
         /** @brief Returns overall time for inference and timings (in ticks) for layers.
          * Indexes in returned vector correspond to layers ids. Some layers can be fused with others,
          * in this case zero ticks count will be return for that skipped layers.
@@ -683,6 +778,27 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
          */
         CV_WRAP int64 getPerfProfile(CV_OUT std::vector<double>& timings);
 
+        /** @brief Returns detailed profile of the latest forward pass.
+         * @param profile records for all layers except the network's input layer. Layers which
+         * weren't computed at the latest forward pass have zero ticks. Layers fused into
+         * others have "fused" kernel.
+         * @return overall ticks for model inference.
+         */
+        int64 getLayersProfile(std::vector<LayerProfile>& profile);
+
+        /** @brief Serializes profile of the latest forward pass into JSON.
+         * @param chromeTrace if true the output uses Chrome trace event format which could be
+         *                    opened with chrome://tracing or https://ui.perfetto.dev. Otherwise
+         *                    it's a "layers" array of LayerProfile records.
+         * @see getLayersProfile()
+         */
+        CV_WRAP String dumpProfile(bool chromeTrace = false);
+        /** @brief Writes profile of the latest forward pass to a file.
+         *  @param path         path to output file with .json extension
+         *  @param chromeTrace  output format, see dumpProfile()
+         */
+        CV_WRAP void dumpProfileToFile(const String& path, bool chromeTrace = false);
+
     private:
         struct Impl;
         Ptr<Impl> impl;
@@ -813,6 +929,7 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
       *                  * `*.pbtxt` (TensorFlow, https://www.tensorflow.org/)
       *                  * `*.cfg` (Darknet, https://pjreddie.com/darknet/)
       *                  * `*.xml` (DLDT, https://software.intel.com/openvino-toolkit)
+      *                  * `*.dnncache` (network cache, see Net::writeCache())
       * @param[in] framework Explicit framework name tag to determine a format.
       * @returns Net object.
       *
@@ -849,6 +966,13 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
      */
     CV_EXPORTS_W Net readNetFromModelOptimizer(const String &xml, const String &bin);
 
+    /** @brief Reads a network from a cache file written by Net::writeCache().
+     *  @param path path to the cache file.
+     *  @returns Net object.
+     *  The file is mapped into memory and learned weights of the network refer to the mapped pages.
+     */
+    CV_EXPORTS_W Net readNetFromCache(const String &path);
+
     /** @brief Reads a network model <a href="https://onnx.ai/">ONNX</a>.
      *  @param onnxFile path to the .onnx file with text description of the network architecture.
      *  @returns Network object that ready to do forward, throw an exception in failure cases.
@@ -996,6 +1120,148 @@ CV__DNN_EXPERIMENTAL_NS_BEGIN
                              CV_OUT std::vector<int>& indices,
                              const float eta = 1.f, const int top_k = 0);
 
+    //! Overlap measures of boxes used by NMSBoxesBatched().
+    enum NMSMethod
+    {
+        NMS_IOU = 0,  //!< intersection over union
+        NMS_DIOU = 1  //!< distance-IoU: IoU reduced by normalized squared distance between boxes centers
+    };
+
+    /** @brief Performs non maximum suppression for every class separately.
+
+     * Boxes of different classes never suppress each other. Indices of the kept boxes of all
+     * the classes are sorted by scores.
+     * @param bboxes a set of bounding boxes to apply NMS.
+     * @param scores a set of corresponding confidences.
+     * @param class_ids a set of corresponding class ids.
+     * @param score_threshold a threshold used to filter boxes by score.
+     * @param nms_threshold a threshold used in non maximum suppression.
+     * @param indices the kept indices of bboxes after NMS.
+     * @param eta a coefficient in adaptive threshold formula: \f$nms\_threshold_{i+1}=eta\cdot nms\_threshold_i\f$.
+     * @param top_k if `>0`, keep at most @p top_k boxes with the highest scores before NMS.
+     * @param method overlap measure, one of #NMSMethod.
+     */
+    CV_EXPORTS_W void NMSBoxesBatched(const std::vector<Rect>& bboxes, const std::vector<float>& scores,
+                                      const std::vector<int>& class_ids,
+                                      const float score_threshold, const float nms_threshold,
+                                      CV_OUT std::vector<int>& indices,
+                                      const float eta = 1.f, const int top_k = 0,
+                                      const int method = NMS_IOU);
+
+    CV_EXPORTS_W void NMSBoxesBatched(const std::vector<Rect2d>& bboxes, const std::vector<float>& scores,
+                                      const std::vector<int>& class_ids,
+                                      const float score_threshold, const float nms_threshold,
+                                      CV_OUT std::vector<int>& indices,
+                                      const float eta = 1.f, const int top_k = 0,
+                                      const int method = NMS_IOU);
+
+    //! Score decay functions of soft non maximum suppression, see softNMSBoxes().
+    enum SoftNMSMethod
+    {
+        SOFTNMS_LINEAR = 1,   //!< \f$score \cdot (1 - IoU)\f$ for boxes with IoU higher than nms_threshold
+        SOFTNMS_GAUSSIAN = 2  //!< \f$score \cdot exp(-IoU^2 / sigma)\f$
+    };
+
+    /** @brief Performs soft non maximum suppression given boxes and corresponding scores.
+     * Reference: https://arxiv.org/abs/1704.04503
+
+     * Instead of removing the boxes, their scores are decayed by overlaps with the picked boxes.
+     * @param bboxes a set of bounding boxes to apply Soft NMS.
+     * @param scores a set of corresponding confidences.
+     * @param updated_scores a set of corresponding updated confidences of the kept boxes.
+     * @param score_threshold a threshold used to filter boxes by score.
+     * @param nms_threshold a threshold used by the linear decay.
+     * @param indices the kept indices of bboxes after Soft NMS.
+     * @param top_k if `>0`, keep at most @p top_k picked indices.
+     * @param sigma parameter of the gaussian decay.
+     * @param method score decay function, one of #SoftNMSMethod.
+     */
+    CV_EXPORTS_W void softNMSBoxes(const std::vector<Rect>& bboxes, const std::vector<float>& scores,
+                                   CV_OUT std::vector<float>& updated_scores,
+                                   const float score_threshold, const float nms_threshold,
+                                   CV_OUT std::vector<int>& indices,
+                                   size_t top_k = 0, const float sigma = 0.5f,
+                                   const int method = SOFTNMS_GAUSSIAN);
+
+    CV_EXPORTS_W void softNMSBoxes(const std::vector<Rect2d>& bboxes, const std::vector<float>& scores,
+                                   CV_OUT std::vector<float>& updated_scores,
+                                   const float score_threshold, const float nms_threshold,
+                                   CV_OUT std::vector<int>& indices,
+                                   size_t top_k = 0, const float sigma = 0.5f,
+                                   const int method = SOFTNMS_GAUSSIAN);
+
+    /** @brief Runs a detection network over overlapping tiles of a high resolution image.
+     *
+     * An image is split into tiles of the network input size which overlap by the specified
+     * number of pixels. Optionally the whole image downscaled to the tile size is added as one
+     * more tile to find objects larger than the overlap. All the tiles are processed by a single
+     * batched forward pass (see setMaxBatchSize()), detections are mapped back to the image
+     * coordinates and merged by class-aware non-maximum suppression. Detections which are cut
+     * by a border between tiles are dropped if they are found entirely by a neighbour tile.
+     * Parts of larger objects found by neighbour tiles are merged if they match in the area
+     * shared by the tiles. The tiles plan is computed once per image size.
+     *
+     * The network is expected to have one output either of DetectionOutput format
+     * (`[1 x 1 x N x 7]` rows of `[tile_id, class_id, confidence, left, top, right, bottom]`,
+     * see YoloDetectionOutputLayer and setNormalizedCoordinates()) or of YOLOv5 format
+     * (`[tiles x N x (5 + classes)]` rows of `[center_x, center_y, width, height, objectness,
+     * class scores]` in pixels of the tile).
+     */
+    class CV_EXPORTS_W_SIMPLE TiledDetector
+    {
+    public:
+        CV_WRAP TiledDetector();
+
+        /** @brief Creates a tiled detector.
+         *  @param net detection network.
+         *  @param tileSize spatial size of the network input.
+         *  @param overlap number of pixels shared by neighbour tiles.
+         */
+        CV_WRAP TiledDetector(const Net& net, Size tileSize = Size(640, 640), int overlap = 64);
+
+        /** @brief Sets preprocessing parameters, see blobFromImage(). */
+        CV_WRAP TiledDetector& setInputParams(double scale = 1.0, const Scalar& mean = Scalar(),
+                                              bool swapRB = false);
+
+        /** @brief Sets thresholds of detections confidence and non-maximum suppression. */
+        CV_WRAP TiledDetector& setThresholds(float confThreshold, float nmsThreshold);
+
+        /** @brief Sets whether the whole downscaled image is processed as an extra tile (true by default). */
+        CV_WRAP TiledDetector& setIncludeFullImage(bool include);
+
+        /** @brief Sets whether boxes of DetectionOutput format are normalized by the tile size
+         *  (true by default) or are in pixels of the tile. YOLOv5 rows are always in pixels.
+         */
+        CV_WRAP TiledDetector& setNormalizedCoordinates(bool normalized);
+
+        /** @brief Sets maximal number of tiles in a single forward pass.
+         *  @param maxBatchSize 0 (default) means all the tiles at once. Use 1 for networks which
+         *                      don't support batches.
+         */
+        CV_WRAP TiledDetector& setMaxBatchSize(int maxBatchSize);
+
+        /** @brief Returns tiles of an image of specified size.
+         *  The downscaled image tile, if enabled, is not included.
+         */
+        CV_WRAP std::vector<Rect> getTiles(Size imageSize) const;
+
+        /** @brief Detects objects on an image.
+         *  @param frame input image.
+         *  @param classIds class indices of detections.
+         *  @param confidences detections confidences.
+         *  @param boxes bounding boxes of detections in pixels of @p frame.
+         */
+        CV_WRAP void detect(InputArray frame, CV_OUT std::vector<int>& classIds,
+                            CV_OUT std::vector<float>& confidences, CV_OUT std::vector<Rect>& boxes);
+
+        /** @brief Returns the network. */
+        CV_WRAP Net getNetwork() const;
+
+    private:
+        struct Impl;
+        Ptr<Impl> impl;
+    };
+
 //! @}
 CV__DNN_EXPERIMENTAL_NS_END
 }
@@ -0,0 +1,199 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "perf_precomp.hpp"
+
+namespace opencv_test {
+
+// Feature pyramid upsampling of YOLOv5-like networks.
+typedef TestBaseWithParam<tuple<Vec4i, std::string> > Layer_Resize;
+PERF_TEST_P_(Layer_Resize, upsample_2x)
+{
+    const Vec4i inpShapeVec = get<0>(GetParam());
+    const std::string interpolation = get<1>(GetParam());
+
+    LayerParams lp;
+    lp.set("zoom_factor", 2);
+    lp.set("interpolation", interpolation);
+    lp.type = "Resize";
+    lp.name = "testLayer";
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+
+    const int inpShape[] = {inpShapeVec[0], inpShapeVec[1], inpShapeVec[2], inpShapeVec[3]};
+    Mat input(4, inpShape, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    net.setInput(input);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    // warmup
+    Mat output = net.forward();
+
+    TEST_CYCLE()
+    {
+        Mat res = net.forward();
+    }
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Resize, Combine(
+    Values(Vec4i(1, 256, 80, 80), Vec4i(1, 512, 40, 40)),
+    Values("nearest", "bilinear")
+));
+
+// Output of YOLOv2 (softmax) and YOLOv3 (logistic) detection heads.
+typedef TestBaseWithParam<tuple<Vec3i, bool> > Layer_Region;
+PERF_TEST_P_(Layer_Region, region)
+{
+    const Vec3i inpShapeVec = get<0>(GetParam());
+    const bool useSoftmax = get<1>(GetParam());
+    const int anchors = 3, classes = 80, cellSize = classes + 5;
+
+    LayerParams lp;
+    lp.set("classes", classes);
+    lp.set("anchors", anchors);
+    lp.set("softmax", useSoftmax);
+    lp.set("logistic", !useSoftmax);
+    lp.set("nms_threshold", 0.0f);
+    Mat biases(1, 2 * anchors, CV_32F);
+    randu(biases, 10.0f, 100.0f);
+    lp.blobs.push_back(biases);
+    lp.type = "Region";
+    lp.name = "testLayer";
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+
+    const int inpShape[] = {inpShapeVec[0], inpShapeVec[1], inpShapeVec[2], anchors * cellSize};
+    Mat input(4, inpShape, CV_32F);
+    randu(input, -5.0f, 5.0f);
+    net.setInput(input);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    // warmup
+    Mat output = net.forward();
+
+    TEST_CYCLE()
+    {
+        Mat res = net.forward();
+    }
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Region, Combine(
+    Values(Vec3i(1, 13, 13), Vec3i(1, 52, 52), Vec3i(4, 26, 26)),
+    testing::Bool()
+));
+
+// Per element throughput of activations on large tensors.
+typedef TestBaseWithParam<std::string> Layer_Activation;
+PERF_TEST_P_(Layer_Activation, activation)
+{
+    const std::string type = GetParam();
+    LayerParams lp;
+    lp.type = type;
+    lp.name = "testLayer";
+    if (type == "LogSoftMax")
+    {
+        lp.type = "Softmax";
+        lp.set("log_softmax", true);
+    }
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+
+    const int inpShape[] = {1, 64, 160, 160};
+    Mat input(4, inpShape, CV_32F);
+    randu(input, -10.0f, 10.0f);
+    net.setInput(input);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    // warmup
+    Mat output = net.forward();
+
+    TEST_CYCLE()
+    {
+        Mat res = net.forward();
+    }
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Activation, Values(
+    "TanH", "Sigmoid", "Swish", "ELU", "BNLL", "Softmax", "LogSoftMax"
+));
+
+// Max poolings of detection backbones: downsampling and SPP(F) blocks.
+// Parameters: input shape, kernel, stride.
+typedef TestBaseWithParam<tuple<Vec4i, int, int> > Layer_MaxPooling;
+PERF_TEST_P_(Layer_MaxPooling, max)
+{
+    const Vec4i inpShapeVec = get<0>(GetParam());
+    const int kernel = get<1>(GetParam()), stride = get<2>(GetParam());
+
+    LayerParams lp;
+    lp.set("pool", "max");
+    lp.set("kernel_size", kernel);
+    lp.set("stride", stride);
+    lp.set("pad", stride == 1 ? kernel / 2 : 0);
+    lp.type = "Pooling";
+    lp.name = "testLayer";
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+    // Max pooling computes indices if there are no consumers of the output.
+    LayerParams identityParams;
+    net.addLayerToPrev("identity", "Identity", identityParams);
+
+    const int inpShape[] = {inpShapeVec[0], inpShapeVec[1], inpShapeVec[2], inpShapeVec[3]};
+    Mat input(4, inpShape, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    net.setInput(input);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    // warmup
+    Mat output = net.forward();
+
+    TEST_CYCLE()
+    {
+        Mat res = net.forward();
+    }
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Layer_MaxPooling, Values(
+    make_tuple(Vec4i(1, 64, 160, 160), 2, 2),
+    make_tuple(Vec4i(1, 64, 160, 160), 3, 2),
+    make_tuple(Vec4i(1, 256, 20, 20), 5, 1),
+    make_tuple(Vec4i(1, 256, 40, 40), 5, 1)
+));
+
+typedef TestBaseWithParam<Vec4i> Layer_SPPF;
+PERF_TEST_P_(Layer_SPPF, sppf)
+{
+    const Vec4i inpShapeVec = GetParam();
+
+    LayerParams lp;
+    lp.set("kernel_size", 5);
+    lp.set("num_pools", 3);
+    lp.type = "SPPF";
+    lp.name = "testLayer";
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+
+    const int inpShape[] = {inpShapeVec[0], inpShapeVec[1], inpShapeVec[2], inpShapeVec[3]};
+    Mat input(4, inpShape, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    net.setInput(input);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    // warmup
+    Mat output = net.forward();
+
+    TEST_CYCLE()
+    {
+        Mat res = net.forward();
+    }
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Layer_SPPF, Values(Vec4i(1, 256, 20, 20), Vec4i(1, 512, 20, 20)));
+
+} // namespace
@@ -53,8 +53,8 @@ public:
         }
 
         MatShape netInputShape = shape(1, 3, input.rows, input.cols);
-        size_t weightsMemory = 0, blobsMemory = 0;
-        net.getMemoryConsumption(netInputShape, weightsMemory, blobsMemory);
+        size_t weightsMemory = 0, blobsMemory = 0, plannedMemory = 0;
+        net.getMemoryConsumption(std::vector<MatShape>(1, netInputShape), weightsMemory, blobsMemory, plannedMemory);
         int64 flops = net.getFLOPS(netInputShape);
         CV_Assert(flops > 0);
 
@@ -63,6 +63,7 @@ public:
         std::cout << "Memory consumption:" << std::endl;
         std::cout << "    Weights(parameters): " << divUp(weightsMemory, 1u<<20) << " Mb" << std::endl;
         std::cout << "    Blobs: " << divUp(blobsMemory, 1u<<20) << " Mb" << std::endl;
+        std::cout << "    Blobs (planned arena): " << divUp(plannedMemory, 1u<<20) << " Mb" << std::endl;
         std::cout << "Calculation complexity: " << flops * 1e-9 << " GFlops" << std::endl;
 
         PERF_SAMPLE_BEGIN()
@@ -213,6 +214,16 @@ PERF_TEST_P_(DNNTestNetwork, YOLOv3)
     processNet("dnn/yolov3.weights", "dnn/yolov3.cfg", "", inp / 255);
 }
 
+PERF_TEST_P_(DNNTestNetwork, TinyYOLOv2)
+{
+    if (backend == DNN_BACKEND_HALIDE)
+        throw SkipTestException("");
+    Mat sample = imread(findDataFile("dnn/dog416.png"));
+    Mat inp;
+    sample.convertTo(inp, CV_32FC3);
+    processNet("dnn/tiny-yolo-voc.weights", "dnn/tiny-yolo-voc.cfg", "", inp / 255);
+}
+
 PERF_TEST_P_(DNNTestNetwork, EAST_text_detection)
 {
     if (backend == DNN_BACKEND_HALIDE)
@@ -0,0 +1,75 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "perf_precomp.hpp"
+
+namespace opencv_test {
+
+// Candidates like the raw output of a detector: clusters of jittered boxes
+// around objects of different scales.
+static void generateDetections(int n, int numClasses, std::vector<Rect>& bboxes,
+                               std::vector<float>& scores, std::vector<int>& class_ids)
+{
+    RNG rng(0x12345);
+    const int boxesPerObject = 20;
+    bboxes.resize(n);
+    scores.resize(n);
+    class_ids.resize(n);
+    Rect object;
+    int objectClass = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        if (i % boxesPerObject == 0)
+        {
+            int size = rng.uniform(8, 200);
+            object = Rect(rng.uniform(0, 1920 - size), rng.uniform(0, 1080 - size), size, size);
+            objectClass = rng.uniform(0, numClasses);
+        }
+        int dx = rng.uniform(-object.width / 4, object.width / 4 + 1);
+        int dy = rng.uniform(-object.height / 4, object.height / 4 + 1);
+        bboxes[i] = Rect(object.x + dx, object.y + dy, object.width, object.height);
+        scores[i] = rng.uniform(0.f, 1.f);
+        class_ids[i] = objectClass;
+    }
+}
+
+typedef TestBaseWithParam<int> NMS;
+
+PERF_TEST_P(NMS, NMSBoxes, testing::Values(1000, 10000, 100000))
+{
+    std::vector<Rect> bboxes;
+    std::vector<float> scores;
+    std::vector<int> class_ids, indices;
+    generateDetections(GetParam(), 1, bboxes, scores, class_ids);
+
+    TEST_CYCLE() NMSBoxes(bboxes, scores, 0.25f, 0.45f, indices);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(NMS, NMSBoxesBatched, testing::Values(1000, 10000, 100000))
+{
+    std::vector<Rect> bboxes;
+    std::vector<float> scores;
+    std::vector<int> class_ids, indices;
+    generateDetections(GetParam(), 80, bboxes, scores, class_ids);
+
+    TEST_CYCLE() NMSBoxesBatched(bboxes, scores, class_ids, 0.25f, 0.45f, indices);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(NMS, softNMSBoxes, testing::Values(1000, 10000, 100000))
+{
+    std::vector<Rect> bboxes;
+    std::vector<float> scores, updated_scores;
+    std::vector<int> class_ids, indices;
+    generateDetections(GetParam(), 1, bboxes, scores, class_ids);
+
+    TEST_CYCLE() softNMSBoxes(bboxes, scores, updated_scores, 0.25f, 0.45f, indices, 300);
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
@@ -75,6 +75,14 @@ public:
         ReadNetParamsFromBinaryStreamOrDie(darknetModelStream, &net);
     }
 
+    DarknetImporter(std::istream &cfgStream, const Ptr<MappedFile>& darknetModel)
+    {
+        CV_TRACE_FUNCTION();
+
+        ReadNetParamsFromCfgStreamOrDie(cfgStream, &net);
+        ReadNetParamsFromMappedFileOrDie(darknetModel, &net);
+    }
+
     DarknetImporter(std::istream &cfgStream)
     {
         CV_TRACE_FUNCTION();
@@ -189,6 +197,14 @@ static Net readNetFromDarknet(std::istream &cfgFile, std::istream &darknetModel)
     return net;
 }
 
+static Net readNetFromDarknet(std::istream &cfgFile, const Ptr<MappedFile>& darknetModel)
+{
+    Net net;
+    DarknetImporter darknetImporter(cfgFile, darknetModel);
+    darknetImporter.populateNet(net);
+    return net;
+}
+
 static Net readNetFromDarknet(std::istream &cfgFile)
 {
     Net net;
@@ -208,12 +224,17 @@ Net readNetFromDarknet(const String &cfgFile, const String &darknetModel /*= Str
     }
     if (darknetModel != String())
     {
-        std::ifstream darknetModelStream(darknetModel.c_str(), std::ios::binary);
-        if (!darknetModelStream.is_open())
+        // Weights are used from the memory mapped file without copying.
+        Ptr<MappedFile> darknetModelFile;
+        try
+        {
+            darknetModelFile = makePtr<MappedFile>(darknetModel);
+        }
+        catch (const cv::Exception&)
         {
             CV_Error(cv::Error::StsParseError, "Failed to parse NetParameter file: " + std::string(darknetModel));
         }
-        return readNetFromDarknet(cfgStream, darknetModelStream);
+        return readNetFromDarknet(cfgStream, darknetModelFile);
     }
     else
         return readNetFromDarknet(cfgStream);
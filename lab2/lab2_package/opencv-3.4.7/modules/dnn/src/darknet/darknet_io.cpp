@@ -673,20 +673,77 @@ namespace cv {
                 return true;
             }
 
-            bool ReadDarknetFromWeightsStream(std::istream &ifile, NetParameter *net)
+            // Reads weights sequentially from a stream into new Mats.
+            class StreamWeightsReader
+            {
+            public:
+                StreamWeightsReader(std::istream &ifile) : ifile(ifile) {}
+
+                void read(void* dst, size_t size)
+                {
+                    ifile.read(reinterpret_cast<char *>(dst), size);
+                }
+
+                cv::Mat readBlob(int dims, const int* sizes)
+                {
+                    cv::Mat blob(dims, sizes, CV_32F);
+                    CV_Assert(blob.isContinuous());
+                    read(blob.ptr<float>(), blob.total() * sizeof(float));
+                    return blob;
+                }
+
+            private:
+                std::istream &ifile;
+            };
+
+            // Wraps weights of a memory mapped file by Mat headers without copying.
+            class MappedWeightsReader
+            {
+            public:
+                MappedWeightsReader(const Ptr<MappedFile>& file) : file(file), pos(0) {}
+
+                void read(void* dst, size_t size)
+                {
+                    if (size > file->size() - pos)
+                        CV_Error(cv::Error::StsParseError, "Unexpected end of darknet weights file");
+                    memcpy(dst, file->data() + pos, size);
+                    pos += size;
+                }
+
+                cv::Mat readBlob(int dims, const int* sizes)
+                {
+                    if (pos % sizeof(float) != 0)
+                    {
+                        // Unaligned data is copied.
+                        cv::Mat blob(dims, sizes, CV_32F);
+                        read(blob.ptr<float>(), blob.total() * sizeof(float));
+                        return blob;
+                    }
+                    cv::Mat blob = MappedFile::wrap(file, pos, dims, sizes, CV_32F);
+                    pos += blob.total() * sizeof(float);
+                    return blob;
+                }
+
+            private:
+                Ptr<MappedFile> file;
+                size_t pos;
+            };
+
+            template<typename Reader>
+            bool ReadDarknetWeights(Reader &ifile, NetParameter *net)
             {
                 int32_t major_ver, minor_ver, revision;
-                ifile.read(reinterpret_cast<char *>(&major_ver), sizeof(int32_t));
-                ifile.read(reinterpret_cast<char *>(&minor_ver), sizeof(int32_t));
-                ifile.read(reinterpret_cast<char *>(&revision), sizeof(int32_t));
+                ifile.read(&major_ver, sizeof(int32_t));
+                ifile.read(&minor_ver, sizeof(int32_t));
+                ifile.read(&revision, sizeof(int32_t));
 
                 uint64_t seen;
                 if ((major_ver * 10 + minor_ver) >= 2) {
-                    ifile.read(reinterpret_cast<char *>(&seen), sizeof(uint64_t));
+                    ifile.read(&seen, sizeof(uint64_t));
                 }
                 else {
                     int32_t iseen = 0;
-                    ifile.read(reinterpret_cast<char *>(&iseen), sizeof(int32_t));
+                    ifile.read(&iseen, sizeof(int32_t));
                     seen = iseen;
                 }
                 bool transpose = (major_ver > 1000) || (minor_ver > 1000);
@@ -716,24 +773,17 @@ namespace cv {
                         CV_Assert(kernel_size > 0 && filters > 0);
                         CV_Assert(current_channels > 0);
 
-                        size_t const weights_size = filters * current_channels * kernel_size * kernel_size;
                         int sizes_weights[] = { filters, current_channels, kernel_size, kernel_size };
-                        cv::Mat weightsBlob;
-                        weightsBlob.create(4, sizes_weights, CV_32F);
-                        CV_Assert(weightsBlob.isContinuous());
+                        int sizes_vec[] = { 1, filters };
 
-                        cv::Mat meanData_mat(1, filters, CV_32F);	// mean
-                        cv::Mat stdData_mat(1, filters, CV_32F);	// variance
-                        cv::Mat weightsData_mat(1, filters, CV_32F);// scale
-                        cv::Mat biasData_mat(1, filters, CV_32F);	// bias
-
-                        ifile.read(reinterpret_cast<char *>(biasData_mat.ptr<float>()), sizeof(float)*filters);
+                        cv::Mat biasData_mat = ifile.readBlob(2, sizes_vec);	// bias
+                        cv::Mat weightsData_mat, meanData_mat, stdData_mat;
                         if (use_batch_normalize) {
-                            ifile.read(reinterpret_cast<char *>(weightsData_mat.ptr<float>()), sizeof(float)*filters);
-                            ifile.read(reinterpret_cast<char *>(meanData_mat.ptr<float>()), sizeof(float)*filters);
-                            ifile.read(reinterpret_cast<char *>(stdData_mat.ptr<float>()), sizeof(float)*filters);
+                            weightsData_mat = ifile.readBlob(2, sizes_vec);	// scale
+                            meanData_mat = ifile.readBlob(2, sizes_vec);	// mean
+                            stdData_mat = ifile.readBlob(2, sizes_vec);	// variance
                         }
-                        ifile.read(reinterpret_cast<char *>(weightsBlob.ptr<float>()), sizeof(float)*weights_size);
+                        cv::Mat weightsBlob = ifile.readBlob(4, sizes_weights);
 
                         // set convolutional weights
                         std::vector<cv::Mat> conv_blobs;
@@ -779,9 +829,18 @@ namespace cv {
 
         void ReadNetParamsFromBinaryStreamOrDie(std::istream &ifile, darknet::NetParameter *net)
         {
-            if (!darknet::ReadDarknetFromWeightsStream(ifile, net)) {
+            darknet::StreamWeightsReader reader(ifile);
+            if (!darknet::ReadDarknetWeights(reader, net)) {
                 CV_Error(cv::Error::StsParseError, "Failed to parse NetParameter stream");
             }
         }
+
+        void ReadNetParamsFromMappedFileOrDie(const Ptr<MappedFile>& file, darknet::NetParameter *net)
+        {
+            darknet::MappedWeightsReader reader(file);
+            if (!darknet::ReadDarknetWeights(reader, net)) {
+                CV_Error(cv::Error::StsParseError, "Failed to parse NetParameter file");
+            }
+        }
     }
 }
@@ -70,6 +70,7 @@
 #define __OPENCV_DNN_DARKNET_IO_HPP__
 
 #include <opencv2/dnn/dnn.hpp>
+#include "../mapped_file.hpp"
 
 namespace cv {
     namespace dnn {
@@ -112,6 +113,8 @@ namespace cv {
         // Read parameters from a stream into a NetParameter message.
         void ReadNetParamsFromCfgStreamOrDie(std::istream &ifile, darknet::NetParameter *net);
         void ReadNetParamsFromBinaryStreamOrDie(std::istream &ifile, darknet::NetParameter *net);
+        // Weights of the net refer to the memory mapped file.
+        void ReadNetParamsFromMappedFileOrDie(const Ptr<MappedFile>& file, darknet::NetParameter *net);
     }
 }
 #endif
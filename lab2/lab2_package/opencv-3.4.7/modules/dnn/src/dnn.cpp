@@ -43,7 +43,9 @@
 #include "op_halide.hpp"
 #include "op_inf_engine.hpp"
 #include "halide_scheduler.hpp"
+#include "mapped_file.hpp"
 #include <set>
+#include <list>
 #include <algorithm>
 #include <iostream>
 #include <sstream>
@@ -748,6 +750,8 @@ struct DataLayer : public Layer
 struct BlobManager
 {
 public:
+    BlobManager() : allocatedBytes(0), planning(false), currentStep(-1), arenaSize(0) {}
+
     // Increase references counter to layer output.
     void addReference(const LayerPin& lp)
     {
@@ -809,6 +813,8 @@ public:
         CV_Assert(refIt != refCounter.end());
         CV_Assert(refIt->second > 0);
         refIt->second -= 1;
+        if (refIt->second == 0)
+            lifetimes[mapIt->second].end = currentStep;
     }
 
     void releaseReferences(const std::vector<LayerPin>& pins)
@@ -821,48 +827,65 @@ public:
 
     void reuseOrCreate(const MatShape& shape, const LayerPin& lp, Mat& dst, bool use_half)
     {
+        const int targetTotal = total(shape);
         if (!DNN_DISABLE_MEMORY_OPTIMIZATIONS)
         {
-            Mat bestBlob;
             LayerPin bestBlobPin;
 
-            std::map<LayerPin, Mat>::iterator hostIt;
+            std::map<LayerPin, int>::iterator hostIt;
             std::map<LayerPin, int>::iterator refIt;
 
-            const int targetTotal = total(shape);
             int bestBlobTotal = INT_MAX;
 
-            for (hostIt = memHosts.begin(); hostIt != memHosts.end(); ++hostIt)
+            for (hostIt = hostTotals.begin(); hostIt != hostTotals.end(); ++hostIt)
             {
                 refIt = refCounter.find(hostIt->first);
                 // Use only blobs that had references before because if not,
                 // it might be used as output.
                 if (refIt != refCounter.end() && refIt->second == 0)
                 {
-                    Mat& unusedBlob = hostIt->second;
-                    if (unusedBlob.total() >= targetTotal &&
-                        unusedBlob.total() < bestBlobTotal)
+                    if (hostIt->second >= targetTotal &&
+                        hostIt->second < bestBlobTotal)
                     {
                         bestBlobPin = hostIt->first;
-                        bestBlob = unusedBlob;
-                        bestBlobTotal = unusedBlob.total();
+                        bestBlobTotal = hostIt->second;
                     }
                 }
             }
-            if (!bestBlob.empty())
+            if (bestBlobPin.valid())
             {
                 reuse(bestBlobPin, lp);
-                dst = bestBlob.reshape(1, 1).colRange(0, targetTotal).reshape(1, shape);
+                lifetimes[bestBlobPin].end = INT_MAX;
+                if (!planning)
+                {
+                    Mat& bestBlob = memHosts[bestBlobPin];
+                    dst = bestBlob.reshape(1, 1).colRange(0, targetTotal).reshape(1, shape);
+                }
                 return;
             }
         }
 
+        if (!planning)
         {
-            // if dst already has been allocated with total(shape) elements,
-            // it won't be recreated and pointer of dst.data remains the same.
-            dst.create(shape, use_half ? CV_16S : CV_32F);
-            addHost(lp, dst);
+            std::map<LayerPin, ArenaHost>::const_iterator hostIt = arenaHosts.find(lp);
+            // Hosts which don't match the plan are created on heap so they
+            // never overlap with the planned ones. Planned hosts are ROIs of
+            // the arena so blobs returned to the user keep it alive.
+            if (!use_half && hostIt != arenaHosts.end() && hostIt->second.start == currentStep &&
+                hostIt->second.size >= targetTotal * sizeof(float))
+            {
+                int ofs = (int)(hostIt->second.offset / sizeof(float));
+                dst = arena.colRange(ofs, ofs + targetTotal).reshape(1, shape);
+            }
+            else
+            {
+                // if dst already has been allocated with total(shape) elements,
+                // it won't be recreated and pointer of dst.data remains the same.
+                dst.create(shape, use_half ? CV_16S : CV_32F);
+            }
+            allocatedBytes += dst.total() * dst.elemSize();
         }
+        addHost(lp, dst, targetTotal);
     }
 
     void allocateBlobsForLayer(LayerData &ld, const LayerShapes& layerShapes,
@@ -872,6 +895,7 @@ public:
         CV_TRACE_FUNCTION();
 
         pinsForInternalBlobs.clear();
+        currentStep++;
 
         std::vector<Mat>& outputBlobs = ld.outputBlobs,
                 &internalBlobs = ld.internals;
@@ -888,7 +912,7 @@ public:
         bool inPlace = false;
         if (layerShapes.supportInPlace)
         {
-            if (ld.inputBlobs.size() == 1)
+            if (ld.inputBlobsId.size() == 1)
             {
                 // Get number of references to the input memory.
                 int numRef = numReferences(ld.inputBlobsId[0]);
@@ -933,8 +957,11 @@ public:
                     LayerPin blobPin(ld.id, index);
                     if (index < outShapes.size() && inPlace)
                     {
-                        CV_Assert(ld.inputBlobs[0]->total() == total(shapes[index]));
-                        ld.outputBlobs[index] = ld.inputBlobs[0]->reshape(1, shapes[index]);
+                        if (!planning)
+                        {
+                            CV_Assert(ld.inputBlobs[0]->total() == total(shapes[index]));
+                            ld.outputBlobs[index] = ld.inputBlobs[0]->reshape(1, shapes[index]);
+                        }
                         reuse(ld.inputBlobsId[0], blobPin);
                     }
                     else
@@ -952,15 +979,129 @@ public:
         refCounter.clear();
         reuseMap.clear();
         memHosts.clear();
+        hostTotals.clear();
+        lifetimes.clear();
+        currentStep = -1;
+        allocatedBytes = 0;
+    }
+
+    // Total size of memory hosts created since the last reset().
+    size_t getAllocatedBytes() const
+    {
+        return allocatedBytes;
+    }
+
+    // In planning mode blobs are not allocated, only lifetimes of the future
+    // memory hosts are collected to be used by planArena().
+    void setPlanning(bool flag)
+    {
+        planning = flag;
+    }
+
+    // Assigns to every memory host, except network inputs, an offset inside
+    // a single arena so that hosts which are alive at the same time don't
+    // overlap. Hosts are placed from the largest one to the smallest into the
+    // best fitting gap between already placed hosts. Returns arena size in bytes.
+    size_t planArena(size_t elemSize)
+    {
+        CV_TRACE_FUNCTION();
+
+        const int alignment = 64;
+
+        std::vector<std::pair<size_t, LayerPin> > hosts;
+        for (std::map<LayerPin, int>::iterator it = hostTotals.begin(); it != hostTotals.end(); ++it)
+        {
+            if (it->first.lid != 0)
+                hosts.push_back(std::make_pair(alignSize(it->second * elemSize, alignment), it->first));
+        }
+        std::sort(hosts.begin(), hosts.end(), compareHostsBySize);
+
+        arenaHosts.clear();
+        arenaSize = 0;
+        std::vector<std::pair<size_t, size_t> > busy;  // [begin, end) offsets of alive hosts
+        for (size_t i = 0; i < hosts.size(); ++i)
+        {
+            const size_t size = hosts[i].first;
+            const Range& lifetime = lifetimes[hosts[i].second];
+
+            busy.clear();
+            for (size_t j = 0; j < i; ++j)
+            {
+                const Range& other = lifetimes[hosts[j].second];
+                if (lifetime.start <= other.end && other.start <= lifetime.end)
+                {
+                    size_t ofs = arenaHosts[hosts[j].second].offset;
+                    busy.push_back(std::make_pair(ofs, ofs + hosts[j].first));
+                }
+            }
+            std::sort(busy.begin(), busy.end());
+
+            size_t bestOffset = 0, bestGap = std::numeric_limits<size_t>::max(), prevEnd = 0;
+            bool found = false;
+            for (size_t j = 0; j < busy.size(); ++j)
+            {
+                if (busy[j].first > prevEnd)
+                {
+                    size_t gap = busy[j].first - prevEnd;
+                    if (gap >= size && gap < bestGap)
+                    {
+                        bestOffset = prevEnd;
+                        bestGap = gap;
+                        found = true;
+                    }
+                }
+                prevEnd = std::max(prevEnd, busy[j].second);
+            }
+            if (!found)
+                bestOffset = prevEnd;
+
+            ArenaHost& host = arenaHosts[hosts[i].second];
+            host.offset = bestOffset;
+            host.size = size;
+            host.start = lifetime.start;
+            arenaSize = std::max(arenaSize, bestOffset + size);
+        }
+        return arenaSize;
+    }
+
+    // Allocates memory for the planned arena of single precision blobs. Memory
+    // is kept between reallocations if the arena size is not changed.
+    void allocateArena()
+    {
+        CV_Assert(arenaSize / sizeof(float) <= (size_t)INT_MAX);
+        if (arenaSize)
+            arena.create(1, (int)(arenaSize / sizeof(float)), CV_32F);
+        else
+            arena.release();
+    }
+
+    void clearArena()
+    {
+        arenaHosts.clear();
+        arenaSize = 0;
+        arena.release();
+    }
+
+    const Mat& getArena() const
+    {
+        return arena;
     }
 
 private:
+    static bool compareHostsBySize(const std::pair<size_t, LayerPin>& a,
+                                   const std::pair<size_t, LayerPin>& b)
+    {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    }
+
     // Register allocated memory.
-    void addHost(const LayerPin& lp, const Mat& mat)
+    void addHost(const LayerPin& lp, const Mat& mat, int hostTotal)
     {
-        CV_Assert(memHosts.find(lp) == memHosts.end());
+        CV_Assert(hostTotals.find(lp) == hostTotals.end());
         reuseMap[lp] = lp;
         memHosts[lp] = mat;
+        hostTotals[lp] = hostTotal;
+        lifetimes[lp] = Range(currentStep, INT_MAX);
     }
 
     std::map<LayerPin, int> refCounter;
@@ -968,13 +1109,52 @@ private:
     // For origin blobs key == value.
     std::map<LayerPin, LayerPin> reuseMap;
     std::map<LayerPin, Mat> memHosts;
+    std::map<LayerPin, int> hostTotals;
+    // Range of allocation steps between allocation of memory host and
+    // the latest release of it. Unreleased hosts have INT_MAX as end.
+    std::map<LayerPin, Range> lifetimes;
+    size_t allocatedBytes;
+    bool planning;
+    // Index of the layer in the allocation order, layers ids may be unordered.
+    int currentStep;
+
+    struct ArenaHost
+    {
+        size_t offset, size;  // in bytes
+        int start;            // allocation step
+    };
+    std::map<LayerPin, ArenaHost> arenaHosts;
+    size_t arenaSize;
+    Mat arena;
+};
+
+struct ForwardKernelData
+{
+    ForwardKernelData() : kernel(NULL) {}
+    const char* kernel;
 };
 
+static TLSData<ForwardKernelData>& getForwardKernelTLS()
+{
+    static TLSData<ForwardKernelData> tls;
+    return tls;
+}
+
+void setForwardKernel(const char* kernel)
+{
+    getForwardKernelTLS().get()->kernel = kernel;
+}
+
+const char* getForwardKernel()
+{
+    return getForwardKernelTLS().get()->kernel;
+}
+
 static Ptr<BackendWrapper> wrapMat(int backendId, int targetId, cv::Mat& m)
 {
     if (backendId == DNN_BACKEND_OPENCV)
     {
-        if (targetId == DNN_TARGET_CPU)
+        if (IS_DNN_CPU_TARGET(targetId))
             return Ptr<BackendWrapper>();
         else if (IS_DNN_OPENCL_TARGET(targetId))
             return OpenCLBackendWrapper::create(m);
@@ -1020,11 +1200,38 @@ struct Net::Impl
         netWasAllocated = false;
         fusion = true;
         isAsync = false;
+        forwardStartTick = 0;
         preferableBackend = DNN_BACKEND_DEFAULT;
         preferableTarget = DNN_TARGET_CPU;
         skipInfEngineInit = false;
+        maxAllocationPlans = 0;
     }
 
+    // Blob allocated for the network. Blobs which share memory with the
+    // network inputs are kept as offsets because inputs are reallocated
+    // by setInput() every time their shapes are changed.
+    struct PlannedBlob
+    {
+        PlannedBlob() : input(-1), offset(0) {}
+
+        Mat blob;
+        int input;
+        int offset;
+        MatShape shape;
+    };
+
+    // Blobs of the network allocated for specific input shapes, before fusion.
+    struct AllocationPlan
+    {
+        ShapesVec inputShapes;
+        std::vector<LayerPin> blobsToKeep;
+        int backend, target;
+        bool fusion;
+        Mat arena;
+        std::map<int, std::vector<PlannedBlob> > outputBlobs, internals;
+        std::vector<size_t> layersAllocatedBytes;
+    };
+
     Ptr<DataLayer> netInputLayer;
     std::vector<LayerPin> blobsToKeep;
     MapIdToLayerData layers;
@@ -1043,11 +1250,19 @@ struct Net::Impl
     bool fusion;
     bool isAsync;
     std::vector<int64> layersTimings;
+    // Profiling data of the latest forward pass, see Net::getLayersProfile().
+    std::vector<int64> layersStartTicks;
+    std::vector<String> layersKernels;
+    std::vector<size_t> layersAllocatedBytes;
+    int64 forwardStartTick;
     Mat output_blob;
+    // The most recently used plan is the first one.
+    std::list<AllocationPlan> allocationPlans;
+    int maxAllocationPlans;
 
     Ptr<BackendWrapper> wrap(Mat& host)
     {
-        if (preferableBackend == DNN_BACKEND_OPENCV && preferableTarget == DNN_TARGET_CPU)
+        if (preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_CPU_TARGET(preferableTarget))
             return Ptr<BackendWrapper>();
 
         MatShape shape(host.dims);
@@ -1155,6 +1370,9 @@ struct Net::Impl
         }
 
         layersTimings.clear();
+        layersStartTicks.clear();
+        layersKernels.clear();
+        layersAllocatedBytes.clear();
     }
 
     void setUpNet(const std::vector<LayerPin>& blobsToKeep_ = std::vector<LayerPin>())
@@ -1164,8 +1382,14 @@ struct Net::Impl
         if (preferableBackend == DNN_BACKEND_DEFAULT)
             preferableBackend = (Backend)PARAM_DNN_BACKEND_DEFAULT;
 
+        if (preferableBackend != DNN_BACKEND_OPENCV && preferableTarget == DNN_TARGET_CPU_FP16)
+        {
+            CV_LOG_WARNING(NULL, "DNN: CPU target with fp16 weights is implemented by OpenCV backend only, switching to CPU.");
+            preferableTarget = DNN_TARGET_CPU;
+        }
+
         CV_Assert(preferableBackend != DNN_BACKEND_OPENCV ||
-                  preferableTarget == DNN_TARGET_CPU ||
+                  IS_DNN_CPU_TARGET(preferableTarget) ||
                   preferableTarget == DNN_TARGET_OPENCL ||
                   preferableTarget == DNN_TARGET_OPENCL_FP16);
         CV_Assert(preferableBackend != DNN_BACKEND_HALIDE ||
@@ -1341,6 +1565,7 @@ struct Net::Impl
     void connect(int outLayerId, int outNum, int inLayerId, int inNum)
     {
         CV_Assert(outLayerId < inLayerId);
+        allocationPlans.clear();
         LayerData &ldOut = getLayerData(outLayerId);
         LayerData &ldInp = getLayerData(inLayerId);
 
@@ -1353,7 +1578,7 @@ struct Net::Impl
     {
         CV_TRACE_FUNCTION();
         if (preferableBackend == DNN_BACKEND_OPENCV)
-            CV_Assert(preferableTarget == DNN_TARGET_CPU || IS_DNN_OPENCL_TARGET(preferableTarget));
+            CV_Assert(IS_DNN_CPU_TARGET(preferableTarget) || IS_DNN_OPENCL_TARGET(preferableTarget));
         else if (preferableBackend == DNN_BACKEND_HALIDE)
             initHalideBackend();
         else if (preferableBackend == DNN_BACKEND_INFERENCE_ENGINE)
@@ -1729,9 +1954,11 @@ struct Net::Impl
         CV_Assert(layerShapesIt != layersShapes.end());
 
         std::vector<LayerPin> pinsForInternalBlobs;
+        size_t allocatedBytes = blobManager.getAllocatedBytes();
         blobManager.allocateBlobsForLayer(ld, layerShapesIt->second, pinsForInternalBlobs,
                                           preferableBackend == DNN_BACKEND_OPENCV &&
                                           preferableTarget == DNN_TARGET_OPENCL_FP16);
+        layersAllocatedBytes[lid] = blobManager.getAllocatedBytes() - allocatedBytes;
         ld.outputBlobsWrappers.resize(ld.outputBlobs.size());
         for (int i = 0; i < ld.outputBlobs.size(); ++i)
         {
@@ -2103,6 +2330,87 @@ struct Net::Impl
         }
     }
 
+    void addBlobsReferences(BlobManager& manager, size_t numInputs,
+                            const std::vector<LayerPin>& blobsToKeep_)
+    {
+        // Fake references to input blobs.
+        for (int i = 0; i < numInputs; ++i)
+            manager.addReference(LayerPin(0, i));
+        for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+        {
+            const LayerData& ld = it->second;
+            manager.addReferences(ld.inputBlobsId);
+        }
+
+        for (int i = 0; i < blobsToKeep_.size(); i++)
+        {
+            manager.addReference(blobsToKeep_[i]);
+        }
+    }
+
+    // Layers are allocated after all their inputs, from the lowest id to
+    // the highest one, the same way as allocateLayer() does. Ids may be not
+    // topologically sorted so the order doesn't follow them in general.
+    void getAllocationOrder(int lid, std::vector<int>& order, std::set<int>& visited)
+    {
+        if (!visited.insert(lid).second)
+            return;
+        const std::vector<LayerPin>& inputs = layers[lid].inputBlobsId;
+        std::set<int> parents;
+        for (size_t i = 0; i < inputs.size(); ++i)
+            parents.insert(inputs[i].lid);
+        for (std::set<int>::iterator it = parents.begin(); it != parents.end(); ++it)
+            getAllocationOrder(*it, order, visited);
+        order.push_back(lid);
+    }
+
+    void getAllocationOrder(std::vector<int>& order)
+    {
+        order.clear();
+        std::set<int> visited;
+        for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+            getAllocationOrder(it->first, order, visited);
+    }
+
+    // Simulates allocation of all the blobs using only their shapes to find
+    // lifetimes of memory hosts and then packs them into an arena.
+    // Returns size of the arena in bytes. The same allocation order is
+    // used by allocateLayers() so the planned hosts match the allocated ones.
+    size_t planMemory(const LayersShapesMap& layersShapes, size_t numInputs,
+                      const std::vector<LayerPin>& blobsToKeep_,
+                      BlobManager& manager, size_t elemSize)
+    {
+        CV_TRACE_FUNCTION();
+
+        manager.reset();
+        manager.setPlanning(true);
+        addBlobsReferences(manager, numInputs, blobsToKeep_);
+
+        std::vector<int> order;
+        getAllocationOrder(order);
+        std::vector<LayerPin> pinsForInternalBlobs;
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            const LayerData& ld = layers[order[i]];
+            LayersShapesMap::const_iterator layerShapesIt = layersShapes.find(ld.id);
+            CV_Assert(layerShapesIt != layersShapes.end());
+
+            LayerData plan;
+            plan.id = ld.id;
+            plan.inputBlobsId = ld.inputBlobsId;
+            plan.requiredOutputs = ld.requiredOutputs;
+            manager.allocateBlobsForLayer(plan, layerShapesIt->second, pinsForInternalBlobs);
+
+            manager.releaseReferences(ld.inputBlobsId);
+            manager.releaseReferences(pinsForInternalBlobs);
+        }
+
+        size_t arenaSize = manager.planArena(elemSize);
+        manager.setPlanning(false);
+        manager.reset();
+        return arenaSize;
+    }
+
     void allocateLayers(const std::vector<LayerPin>& blobsToKeep_)
     {
         CV_TRACE_FUNCTION();
@@ -2124,33 +2432,179 @@ struct Net::Impl
             }
             inputShapes.push_back(shape(inp));
         }
+        if (restoreAllocationPlan(inputShapes, blobsToKeep_))
+            return;
+
         LayersShapesMap layersShapes;
         getLayersShapes(inputShapes, layersShapes);
 
+        // Intermediate blobs are placed into a single preplanned memory arena.
+        // Backends wrap blobs by their data pointers so it's used only for CPU.
+        if (!DNN_DISABLE_MEMORY_OPTIMIZATIONS &&
+            preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_CPU_TARGET(preferableTarget))
+        {
+            planMemory(layersShapes, inputShapes.size(), blobsToKeep_, blobManager, sizeof(float));
+            blobManager.allocateArena();
+        }
+        else
+            blobManager.clearArena();
+
         blobManager.reset();
         backendWrappers.clear();
-        // Fake references to input blobs.
-        for (int i = 0; i < layers[0].outputBlobs.size(); ++i)
-            blobManager.addReference(LayerPin(0, i));
-        for (it = layers.begin(); it != layers.end(); ++it)
+        addBlobsReferences(blobManager, layers[0].outputBlobs.size(), blobsToKeep_);
+
+        layersAllocatedBytes.assign(lastLayerId + 1, 0);
+        std::vector<int> order;
+        getAllocationOrder(order);
+        for (size_t i = 0; i < order.size(); ++i)
+            allocateLayer(order[i], layersShapes);
+        saveAllocationPlan(inputShapes, blobsToKeep_);
+
+        layersTimings.resize(lastLayerId + 1, 0);
+        layersStartTicks.resize(lastLayerId + 1, 0);
+        layersKernels.resize(lastLayerId + 1);
+        fuseLayers(blobsToKeep_);
+    }
+
+    // Allocation plans are used only if intermediate blobs are placed into
+    // the memory arena. Backends keep their own copies of the blobs.
+    bool useAllocationPlans() const
+    {
+        return maxAllocationPlans > 0 && !DNN_DISABLE_MEMORY_OPTIMIZATIONS &&
+               preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_CPU_TARGET(preferableTarget);
+    }
+
+    PlannedBlob toPlannedBlob(const Mat& m)
+    {
+        PlannedBlob res;
+        const std::vector<Mat>& inputs = layers[0].outputBlobs;
+        for (int i = 0; i < (int)inputs.size() && m.data; ++i)
+        {
+            if (inputs[i].datastart <= m.data && m.data < inputs[i].dataend)
+            {
+                res.input = i;
+                res.offset = (int)((m.data - inputs[i].data) / m.elemSize());
+                res.shape = shape(m);
+                return res;
+            }
+        }
+        res.blob = m;
+        return res;
+    }
+
+    Mat fromPlannedBlob(const PlannedBlob& b)
+    {
+        if (b.input < 0)
+            return b.blob;
+        Mat& inp = layers[0].outputBlobs[b.input];
+        return inp.reshape(1, 1).colRange(b.offset, b.offset + total(b.shape)).reshape(1, b.shape);
+    }
+
+    void saveAllocationPlan(const ShapesVec& inputShapes, const std::vector<LayerPin>& blobsToKeep_)
+    {
+        if (!useAllocationPlans())
+            return;
+        allocationPlans.push_front(AllocationPlan());
+        AllocationPlan& plan = allocationPlans.front();
+        plan.inputShapes = inputShapes;
+        plan.blobsToKeep = blobsToKeep_;
+        plan.backend = preferableBackend;
+        plan.target = preferableTarget;
+        plan.fusion = fusion;
+        plan.arena = blobManager.getArena();
+        plan.layersAllocatedBytes = layersAllocatedBytes;
+        for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
         {
             const LayerData& ld = it->second;
-            blobManager.addReferences(ld.inputBlobsId);
+            if (ld.id == 0)
+                continue;
+            std::vector<PlannedBlob>& outs = plan.outputBlobs[ld.id];
+            for (size_t i = 0; i < ld.outputBlobs.size(); ++i)
+                outs.push_back(toPlannedBlob(ld.outputBlobs[i]));
+            std::vector<PlannedBlob>& internals = plan.internals[ld.id];
+            for (size_t i = 0; i < ld.internals.size(); ++i)
+                internals.push_back(toPlannedBlob(ld.internals[i]));
         }
+        if ((int)allocationPlans.size() > maxAllocationPlans)
+            allocationPlans.resize(maxAllocationPlans);
+    }
 
-        for (int i = 0; i < blobsToKeep_.size(); i++)
+    // Binds blobs allocated earlier for the same input shapes. Shapes inference,
+    // memory planning and allocation are skipped, layers are finalized and fused
+    // as usual.
+    bool restoreAllocationPlan(const ShapesVec& inputShapes, const std::vector<LayerPin>& blobsToKeep_)
+    {
+        if (!useAllocationPlans())
+            return false;
+        std::list<AllocationPlan>::iterator planIt = allocationPlans.begin();
+        for (; planIt != allocationPlans.end(); ++planIt)
         {
-            blobManager.addReference(blobsToKeep_[i]);
+            if (planIt->inputShapes == inputShapes && planIt->blobsToKeep == blobsToKeep_ &&
+                planIt->backend == preferableBackend && planIt->target == preferableTarget &&
+                planIt->fusion == fusion)
+                break;
         }
+        if (planIt == allocationPlans.end())
+            return false;
+        allocationPlans.splice(allocationPlans.begin(), allocationPlans, planIt);
+        const AllocationPlan& plan = allocationPlans.front();
 
-        for (it = layers.begin(); it != layers.end(); it++)
+        backendWrappers.clear();
+        layersAllocatedBytes = plan.layersAllocatedBytes;
+
+        LayerData& inpLd = layers[0];
+        for (size_t i = 0; i < inpLd.outputBlobs.size(); ++i)
+            inpLd.outputBlobs[i].create(inputShapes[i], CV_32F);
+        inpLd.inputBlobsWrappers.resize(netInputLayer->inputsData.size());
+        inpLd.outputBlobsWrappers.resize(inpLd.outputBlobs.size());
+
+        MapIdToLayerData::iterator it;
+        for (it = layers.begin(); it != layers.end(); ++it)
         {
-            int lid = it->first;
-            allocateLayer(lid, layersShapes);
+            LayerData& ld = it->second;
+            if (ld.id == 0)
+                continue;
+            const std::vector<PlannedBlob>& outs = plan.outputBlobs.find(ld.id)->second;
+            ld.outputBlobs.resize(outs.size());
+            for (size_t i = 0; i < outs.size(); ++i)
+                ld.outputBlobs[i] = fromPlannedBlob(outs[i]);
+            const std::vector<PlannedBlob>& internals = plan.internals.find(ld.id)->second;
+            ld.internals.resize(internals.size());
+            for (size_t i = 0; i < internals.size(); ++i)
+                ld.internals[i] = fromPlannedBlob(internals[i]);
+            ld.outputBlobsWrappers.resize(ld.outputBlobs.size());
+            ld.internalBlobsWrappers.resize(ld.internals.size());
+        }
+
+        for (it = layers.begin(); it != layers.end(); ++it)
+        {
+            LayerData& ld = it->second;
+            if (ld.id != 0)
+            {
+                const size_t ninputs = ld.inputBlobsId.size();
+                ld.inputBlobs.resize(ninputs);
+                ld.inputBlobsWrappers.resize(ninputs);
+                for (size_t i = 0; i < ninputs; ++i)
+                {
+                    LayerPin from = ld.inputBlobsId[i];
+                    ld.inputLayersId.insert(from.lid);
+                    ld.inputBlobs[i] = &layers[from.lid].outputBlobs[from.oid];
+                }
+            }
+            std::vector<Mat> inps(ld.inputBlobs.size());
+            for (size_t i = 0; i < ld.inputBlobs.size(); ++i)
+                inps[i] = *ld.inputBlobs[i];
+            Ptr<Layer> layerPtr = ld.getLayerInstance();
+            layerPtr->finalize(inps, ld.outputBlobs);
+            layerPtr->preferableTarget = preferableTarget;
+            ld.flag = 1;
         }
 
         layersTimings.resize(lastLayerId + 1, 0);
+        layersStartTicks.resize(lastLayerId + 1, 0);
+        layersKernels.resize(lastLayerId + 1);
         fuseLayers(blobsToKeep_);
+        return true;
     }
 
     void forwardLayer(LayerData &ld)
@@ -2159,6 +2613,8 @@ struct Net::Impl
 
         Ptr<Layer> layer = ld.layerInstance;
 
+        layersStartTicks[ld.id] = getTickCount() - forwardStartTick;
+        const char* kernel = "fused";
         TickMeter tm;
         tm.start();
 
@@ -2179,9 +2635,13 @@ struct Net::Impl
                     std::vector<UMat> umat_inputBlobs = OpenCLBackendWrapper::getUMatVector(ld.inputBlobsWrappers);
                     std::vector<UMat> umat_outputBlobs = OpenCLBackendWrapper::getUMatVector(ld.outputBlobsWrappers);
                     std::vector<UMat> umat_internalBlobs = OpenCLBackendWrapper::getUMatVector(ld.internalBlobsWrappers);
+                    setForwardKernel(NULL);
                     layer->forward(umat_inputBlobs,
                                    umat_outputBlobs,
                                    umat_internalBlobs);
+                    kernel = getForwardKernel();
+                    if (!kernel)
+                        kernel = "OpenCL";
                     if (DNN_CHECK_NAN_INF)
                     {
                         bool fail = false;
@@ -2260,7 +2720,11 @@ struct Net::Impl
                     {
                         inps[i] = *ld.inputBlobs[i];
                     }
+                    setForwardKernel(NULL);
                     layer->forward(inps, ld.outputBlobs, ld.internals);
+                    kernel = getForwardKernel();
+                    if (!kernel)
+                        kernel = "CPU";
 
                     if (DNN_CHECK_NAN_INF)
                     {
@@ -2326,10 +2790,12 @@ struct Net::Impl
                 if (preferableBackend == DNN_BACKEND_HALIDE)
                 {
                     forwardHalide(ld.outputBlobsWrappers, node);
+                    kernel = "Halide";
                 }
                 else if (preferableBackend == DNN_BACKEND_INFERENCE_ENGINE)
                 {
                     forwardInfEngine(ld.outputBlobsWrappers, node, isAsync);
+                    kernel = "DLIE";
                 }
                 else
                 {
@@ -2342,6 +2808,7 @@ struct Net::Impl
 
         tm.stop();
         layersTimings[ld.id] = tm.getTimeTicks();
+        layersKernels[ld.id] = kernel;
 
         ld.flag = 1;
     }
@@ -2355,6 +2822,11 @@ struct Net::Impl
             MapIdToLayerData::iterator it;
             for (it = layers.begin(); it != layers.end(); it++)
                 it->second.flag = 0;
+            // Layers which won't be computed by this pass must not report stale timings.
+            std::fill(layersTimings.begin(), layersTimings.end(), 0);
+            std::fill(layersStartTicks.begin(), layersStartTicks.end(), 0);
+            std::fill(layersKernels.begin(), layersKernels.end(), String());
+            forwardStartTick = getTickCount();
         }
 
         //already was forwarded
@@ -2445,7 +2917,7 @@ struct Net::Impl
                                            "the #%d was requested", ld.name.c_str(),
                                            ld.outputBlobs.size(), pin.oid));
         }
-        if (preferableTarget != DNN_TARGET_CPU)
+        if (!IS_DNN_CPU_TARGET(preferableTarget))
         {
             CV_Assert(!ld.outputBlobsWrappers.empty() && !ld.outputBlobsWrappers[pin.oid].empty());
             // Transfer data to CPU if it's require.
@@ -2481,7 +2953,7 @@ struct Net::Impl
                                            "the #%d was requested", ld.name.c_str(),
                                            ld.outputBlobs.size(), pin.oid));
         }
-        if (preferableTarget != DNN_TARGET_CPU)
+        if (!IS_DNN_CPU_TARGET(preferableTarget))
         {
             CV_Assert(!ld.outputBlobsWrappers.empty() && !ld.outputBlobsWrappers[pin.oid].empty());
             // Transfer data to CPU if it's require.
@@ -2558,6 +3030,45 @@ Net::~Net()
 {
 }
 
+Net Net::clone() const
+{
+    CV_TRACE_FUNCTION();
+
+    if (impl->skipInfEngineInit)
+        CV_Error(Error::StsNotImplemented, "Networks imported from Model Optimizer can't be cloned");
+
+    Net net;
+    Impl& dst = *net.impl;
+    dst.netInputLayer->setNames(impl->netInputLayer->outNames);
+    dst.layerNameToId = impl->layerNameToId;
+    dst.lastLayerId = impl->lastLayerId;
+    dst.preferableBackend = impl->preferableBackend;
+    dst.preferableTarget = impl->preferableTarget;
+    dst.halideConfigFile = impl->halideConfigFile;
+    dst.fusion = impl->fusion;
+    dst.maxAllocationPlans = impl->maxAllocationPlans;
+
+    for (Impl::MapIdToLayerData::const_iterator it = impl->layers.begin();
+         it != impl->layers.end(); ++it)
+    {
+        const LayerData& src = it->second;
+        LayerData* ld;
+        if (src.id == 0)
+            ld = &dst.layers[0];
+        else
+        {
+            // LayerParams are copied shallowly so learned blobs are shared between
+            // the nets. Layers never modify them: fused weights are always cloned.
+            LayerParams params = src.params;
+            ld = &dst.layers.insert(std::make_pair(src.id, LayerData(src.id, src.name, src.type, params))).first->second;
+        }
+        ld->inputBlobsId = src.inputBlobsId;
+        ld->requiredOutputs = src.requiredOutputs;
+        ld->consumers = src.consumers;
+    }
+    return net;
+}
+
 int Net::addLayer(const String &name, const String &type, LayerParams &params)
 {
     CV_TRACE_FUNCTION();
@@ -2569,6 +3080,7 @@ int Net::addLayer(const String &name, const String &type, LayerParams &params)
     }
 
     int id = ++impl->lastLayerId;
+    impl->allocationPlans.clear();
     impl->layerNameToId.insert(std::make_pair(name, id));
     impl->layers.insert(std::make_pair(id, LayerData(id, name, type, params)));
 
@@ -2671,7 +3183,7 @@ void Net::forward(OutputArrayOfArrays outputBlobs, const String& outputName)
     }
     else if (outputBlobs.isMatVector())
     {
-        if (impl->preferableTarget != DNN_TARGET_CPU)
+        if (!IS_DNN_CPU_TARGET(impl->preferableTarget))
         {
             for (int i = 0; i < ld.outputBlobsWrappers.size(); ++i)
             {
@@ -3065,6 +3577,7 @@ String Net::dump()
              case DNN_TARGET_OPENCL_FP16: out << "OCL_FP16\\n"; colorId = 2; break;
              case DNN_TARGET_MYRIAD: out << "MYRIAD\\n"; colorId = 3; break;
              case DNN_TARGET_FPGA: out << "FPGA\\n"; colorId = 4; break;
+             case DNN_TARGET_CPU_FP16: out << "CPU_FP16\\n"; colorId = layerBackend.empty() ? 0 : 5; break;
          }
          out << ((skipId.size() == 1)? "\" " : " }\" ");
          out << "fillcolor=\"" << colors[colorId] << "\" ";
@@ -3117,6 +3630,183 @@ void Net::dumpToFile(const String& path) {
     file.close();
 }
 
+// Network cache is a binary file with the following layout (native byte order):
+//   header: magic, version, byte order mark, size of the graph section
+//   graph section: inputs names, backend, target, fusion flag and layers
+//                  (id, name, type, parameters, blobs descriptions and inputs)
+//   data section: blobs data, every blob is aligned to CACHE_ALIGNMENT bytes
+static const char CACHE_MAGIC[8] = {'C', 'V', 'D', 'N', 'N', 'C', 'C', 'H'};
+static const uint32_t CACHE_VERSION = 1;
+static const uint32_t CACHE_BYTE_ORDER = 0x01020304;
+static const size_t CACHE_ALIGNMENT = 64;
+static const size_t CACHE_HEADER_SIZE = sizeof(CACHE_MAGIC) + 2 * sizeof(uint32_t) + sizeof(uint64_t);
+
+class CacheWriter
+{
+public:
+    template<typename T> void put(T value)
+    {
+        const uchar* ptr = (const uchar*)&value;
+        buf.insert(buf.end(), ptr, ptr + sizeof(T));
+    }
+
+    void put(const String& str)
+    {
+        put<uint32_t>((uint32_t)str.size());
+        buf.insert(buf.end(), str.begin(), str.end());
+    }
+
+    std::vector<uchar> buf;
+};
+
+class CacheReader
+{
+public:
+    CacheReader(const uchar* begin, const uchar* end) : ptr(begin), end(end) {}
+
+    template<typename T> T get()
+    {
+        check(sizeof(T));
+        T value;
+        memcpy(&value, ptr, sizeof(T));
+        ptr += sizeof(T);
+        return value;
+    }
+
+    String getString()
+    {
+        uint32_t size = get<uint32_t>();
+        check(size);
+        String str((const char*)ptr, size);
+        ptr += size;
+        return str;
+    }
+
+    void check(size_t size) const
+    {
+        if ((size_t)(end - ptr) < size)
+            CV_Error(Error::StsParseError, "Network cache file is corrupted");
+    }
+
+    const uchar* ptr;
+    const uchar* end;
+};
+
+void Net::writeCache(const String& path) const
+{
+    CV_TRACE_FUNCTION();
+
+    if (impl->skipInfEngineInit)
+        CV_Error(Error::StsNotImplemented, "Networks imported from Model Optimizer can't be cached");
+
+    CacheWriter graph;
+    std::vector<Mat> blobs;
+    std::vector<uint64_t> offsets;
+    // Blobs shared between layers are stored once.
+    std::map<const uchar*, uint64_t> blobOffsets;
+    uint64_t dataSize = 0;
+
+    const std::vector<String>& inputs = impl->netInputLayer->outNames;
+    graph.put<uint32_t>((uint32_t)inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i)
+        graph.put(inputs[i]);
+    graph.put<int32_t>(impl->preferableBackend);
+    graph.put<int32_t>(impl->preferableTarget);
+    graph.put<uint8_t>(impl->fusion);
+
+    graph.put<uint32_t>((uint32_t)(impl->layers.size() - 1));
+    for (Impl::MapIdToLayerData::const_iterator it = impl->layers.begin();
+         it != impl->layers.end(); ++it)
+    {
+        const LayerData& ld = it->second;
+        if (ld.id == 0)
+            continue;
+        graph.put<int32_t>(ld.id);
+        graph.put(ld.name);
+        graph.put(ld.type);
+
+        graph.put<uint32_t>((uint32_t)std::distance(ld.params.begin(), ld.params.end()));
+        for (std::map<String, DictValue>::const_iterator p = ld.params.begin(); p != ld.params.end(); ++p)
+        {
+            const DictValue& value = p->second;
+            graph.put(p->first);
+            graph.put<int32_t>(value.isInt() ? Param::INT : value.isReal() ? Param::REAL : Param::STRING);
+            graph.put<uint32_t>(value.size());
+            for (int i = 0; i < value.size(); ++i)
+            {
+                if (value.isInt())
+                    graph.put<int64_t>(value.get<int64>(i));
+                else if (value.isReal())
+                    graph.put<double>(value.get<double>(i));
+                else
+                    graph.put(value.get<String>(i));
+            }
+        }
+
+        graph.put<uint32_t>((uint32_t)ld.params.blobs.size());
+        for (size_t i = 0; i < ld.params.blobs.size(); ++i)
+        {
+            Mat blob = ld.params.blobs[i];
+            if (!blob.isContinuous())
+                blob = blob.clone();
+            graph.put<int32_t>(blob.type());
+            graph.put<int32_t>(blob.dims);
+            for (int j = 0; j < blob.dims; ++j)
+                graph.put<int32_t>(blob.size[j]);
+
+            uint64_t offset;
+            std::map<const uchar*, uint64_t>::iterator shared = blobOffsets.find(blob.data);
+            if (blob.empty())
+                offset = 0;
+            else if (shared != blobOffsets.end())
+                offset = shared->second;
+            else
+            {
+                offset = dataSize;
+                blobOffsets[blob.data] = offset;
+                blobs.push_back(blob);
+                offsets.push_back(offset);
+                dataSize = alignSize(dataSize + blob.total() * blob.elemSize(), CACHE_ALIGNMENT);
+            }
+            graph.put<uint64_t>(offset);
+        }
+
+        graph.put<uint32_t>((uint32_t)ld.inputBlobsId.size());
+        for (size_t i = 0; i < ld.inputBlobsId.size(); ++i)
+        {
+            graph.put<int32_t>(ld.inputBlobsId[i].lid);
+            graph.put<int32_t>(ld.inputBlobsId[i].oid);
+        }
+    }
+
+    CacheWriter header;
+    for (int i = 0; i < 8; ++i)
+        header.put<char>(CACHE_MAGIC[i]);
+    header.put<uint32_t>(CACHE_VERSION);
+    header.put<uint32_t>(CACHE_BYTE_ORDER);
+    header.put<uint64_t>(graph.buf.size());
+    CV_Assert(header.buf.size() == CACHE_HEADER_SIZE);
+
+    std::ofstream ofs(path.c_str(), std::ios::out | std::ios::binary);
+    if (!ofs.is_open())
+        CV_Error(Error::StsError, "Failed to open file " + path);
+    ofs.write((const char*)&header.buf[0], header.buf.size());
+    ofs.write((const char*)&graph.buf[0], graph.buf.size());
+
+    const std::vector<char> padding(CACHE_ALIGNMENT, 0);
+    size_t pos = header.buf.size() + graph.buf.size();
+    ofs.write(&padding[0], alignSize(pos, CACHE_ALIGNMENT) - pos);
+    pos = 0;
+    for (size_t i = 0; i < blobs.size(); ++i)
+    {
+        ofs.write(&padding[0], offsets[i] - pos);
+        ofs.write((const char*)blobs[i].data, blobs[i].total() * blobs[i].elemSize());
+        pos = offsets[i] + blobs[i].total() * blobs[i].elemSize();
+    }
+    if (!ofs)
+        CV_Error(Error::StsError, "Failed to write file " + path);
+}
+
 Ptr<Layer> Net::getLayer(LayerId layerId)
 {
     LayerData &ld = impl->getLayerData(layerId);
@@ -3355,6 +4045,20 @@ void Net::getMemoryConsumption(const std::vector<MatShape>& netInputShapes,
     }
 }
 
+void Net::getMemoryConsumption(const std::vector<MatShape>& netInputShapes,
+                               size_t& weights, size_t& blobs, size_t& plannedBlobs) const
+{
+    CV_TRACE_FUNCTION();
+
+    getMemoryConsumption(netInputShapes, weights, blobs);
+
+    Impl::LayersShapesMap layersShapes;
+    impl->getLayersShapes(netInputShapes, layersShapes);
+    BlobManager manager;
+    plannedBlobs = impl->planMemory(layersShapes, netInputShapes.size(),
+                                    std::vector<LayerPin>(), manager, sizeof(float));
+}
+
 void Net::getMemoryConsumption(const int layerId,
                                const MatShape& netInputShape,
                                size_t& weights, size_t& blobs) const
@@ -3423,6 +4127,60 @@ void Net::enableFusion(bool fusion)
     }
 }
 
+void Net::setMaxAllocationPlans(int maxPlans)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(maxPlans >= 0);
+    impl->maxAllocationPlans = maxPlans;
+    if ((int)impl->allocationPlans.size() > maxPlans)
+        impl->allocationPlans.resize(maxPlans);
+}
+
+void Net::prepareAllocationPlan(const std::vector<MatShape>& netInputShapes,
+                                const std::vector<String>& outBlobNames)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl->maxAllocationPlans > 0);
+
+    std::vector<LayerPin> pins;
+    if (outBlobNames.empty())
+        pins.push_back(impl->getPinByAlias(getLayerNames().back()));
+    for (size_t i = 0; i < outBlobNames.size(); ++i)
+        pins.push_back(impl->getPinByAlias(outBlobNames[i]));
+
+    LayerData& ld = impl->layers[0];
+    const size_t numInputs = std::max(netInputShapes.size(), ld.requiredOutputs.size());
+    CV_Assert(netInputShapes.size() == numInputs);
+
+    // Network is allocated for placeholder inputs. Actual inputs are restored
+    // to be reallocated by the next forward pass.
+    std::vector<Mat> inputsData = impl->netInputLayer->inputsData;
+    std::vector<Mat> outputBlobs = ld.outputBlobs;
+    std::vector<Ptr<BackendWrapper> > outputBlobsWrappers = ld.outputBlobsWrappers;
+    std::vector<double> scaleFactors = impl->netInputLayer->scaleFactors;
+    std::vector<Scalar> means = impl->netInputLayer->means;
+
+    ld.outputBlobs.resize(numInputs);
+    ld.outputBlobsWrappers.resize(numInputs);
+    impl->netInputLayer->inputsData.resize(numInputs);
+    impl->netInputLayer->scaleFactors.assign(numInputs, 1.0);
+    impl->netInputLayer->means.assign(numInputs, Scalar());
+    for (size_t i = 0; i < numInputs; ++i)
+    {
+        ld.outputBlobs[i] = Mat(netInputShapes[i], CV_32F);
+        impl->netInputLayer->inputsData[i] = ld.outputBlobs[i];
+    }
+    impl->netWasAllocated = false;
+    impl->setUpNet(pins);
+
+    impl->netInputLayer->inputsData = inputsData;
+    ld.outputBlobs = outputBlobs;
+    ld.outputBlobsWrappers = outputBlobsWrappers;
+    impl->netInputLayer->scaleFactors = scaleFactors;
+    impl->netInputLayer->means = means;
+    impl->netWasAllocated = false;
+}
+
 void Net::setHalideScheduler(const String& scheduler)
 {
     CV_TRACE_FUNCTION();
@@ -3438,6 +4196,111 @@ int64 Net::getPerfProfile(std::vector<double>& timings)
     return total;
 }
 
+int64 Net::getLayersProfile(std::vector<LayerProfile>& profile)
+{
+    CV_TRACE_FUNCTION();
+
+    profile.clear();
+    if (!impl->netWasAllocated || impl->layersTimings.empty())
+        return 0;
+
+    int64 total = 0;
+    Impl::MapIdToLayerData::iterator it = impl->layers.begin();
+    for (++it; it != impl->layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        LayerProfile p;
+        p.id = ld.id;
+        p.name = ld.name;
+        p.type = ld.type;
+        p.kernel = impl->layersKernels[ld.id];
+        p.startTicks = impl->layersStartTicks[ld.id];
+        p.ticks = impl->layersTimings[ld.id];
+        p.allocatedBytes = impl->layersAllocatedBytes[ld.id];
+
+        std::vector<MatShape> inpShapes(ld.inputBlobs.size()), outShapes(ld.outputBlobs.size());
+        for (size_t i = 0; i < ld.inputBlobs.size(); ++i)
+        {
+            const Mat& m = *ld.inputBlobs[i];
+            inpShapes[i] = shape(m);
+            p.bytesRead += m.total() * m.elemSize();
+        }
+        for (size_t i = 0; i < ld.outputBlobs.size(); ++i)
+        {
+            const Mat& m = ld.outputBlobs[i];
+            outShapes[i] = shape(m);
+            p.bytesWritten += m.total() * m.elemSize();
+        }
+        Ptr<Layer> layer = ld.getLayerInstance();
+        for (size_t i = 0; i < layer->blobs.size(); ++i)
+            p.bytesRead += layer->blobs[i].total() * layer->blobs[i].elemSize();
+        p.flops = layer->getFLOPS(inpShapes, outShapes);
+
+        total += p.ticks;
+        profile.push_back(p);
+    }
+    return total;
+}
+
+String Net::dumpProfile(bool chromeTrace)
+{
+    CV_TRACE_FUNCTION();
+
+    std::vector<LayerProfile> profile;
+    getLayersProfile(profile);
+
+    const double usPerTick = 1e6 / getTickFrequency();
+    FileStorage fs(".json", FileStorage::WRITE | FileStorage::MEMORY);
+    if (chromeTrace)
+    {
+        // Complete events ("ph": "X") with timestamps and durations in microseconds.
+        fs << "traceEvents" << "[";
+        for (size_t i = 0; i < profile.size(); ++i)
+        {
+            const LayerProfile& p = profile[i];
+            fs << "{";
+            fs << "name" << p.name << "cat" << p.type << "ph" << "X";
+            fs << "ts" << p.startTicks * usPerTick << "dur" << p.ticks * usPerTick;
+            fs << "pid" << 0 << "tid" << 0;
+            fs << "args" << "{";
+            fs << "id" << p.id << "kernel" << p.kernel << "flops" << (double)p.flops;
+            fs << "bytes_read" << (double)p.bytesRead << "bytes_written" << (double)p.bytesWritten;
+            fs << "allocated_bytes" << (double)p.allocatedBytes;
+            fs << "}";
+            fs << "}";
+        }
+        fs << "]";
+        fs << "displayTimeUnit" << "ms";
+    }
+    else
+    {
+        fs << "layers" << "[";
+        for (size_t i = 0; i < profile.size(); ++i)
+        {
+            const LayerProfile& p = profile[i];
+            fs << "{";
+            fs << "id" << p.id << "name" << p.name << "type" << p.type << "kernel" << p.kernel;
+            fs << "start_ms" << p.startTicks * usPerTick * 1e-3 << "time_ms" << p.ticks * usPerTick * 1e-3;
+            fs << "flops" << (double)p.flops;
+            fs << "bytes_read" << (double)p.bytesRead << "bytes_written" << (double)p.bytesWritten;
+            fs << "allocated_bytes" << (double)p.allocatedBytes;
+            fs << "}";
+        }
+        fs << "]";
+    }
+    return fs.releaseAndGetString();
+}
+
+void Net::dumpProfileToFile(const String& path, bool chromeTrace)
+{
+    String profile = dumpProfile(chromeTrace);
+    std::ofstream file(path.c_str());
+    file << profile;
+    file.close();
+    if (file.fail())
+        CV_Error(Error::StsError, "Failed to write profile to " + path);
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 Layer::Layer() { preferableTarget = DNN_TARGET_CPU; }
@@ -3864,6 +4727,10 @@ Net readNet(const String& _model, const String& _config, const String& _framewor
     {
         return readNetFromONNX(model);
     }
+    if (framework == "cache" || modelExt == "dnncache")
+    {
+        return readNetFromCache(model);
+    }
     CV_Error(Error::StsError, "Cannot determine an origin framework of files: " +
                                       model + (config.empty() ? "" : ", " + config));
 }
@@ -3885,6 +4752,122 @@ Net readNet(const String& _framework, const std::vector<uchar>& bufferModel,
     CV_Error(Error::StsError, "Cannot determine an origin framework with a name " + framework);
 }
 
+Net Net::readFromCache(const String& path)
+{
+    CV_TRACE_FUNCTION();
+
+    Ptr<MappedFile> file(new MappedFile(path));
+    CacheReader header(file->data(), file->data() + file->size());
+    header.check(CACHE_HEADER_SIZE);
+    if (memcmp(header.ptr, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0)
+        CV_Error(Error::StsParseError, "File " + path + " is not a network cache");
+    header.ptr += sizeof(CACHE_MAGIC);
+    uint32_t version = header.get<uint32_t>();
+    if (version != CACHE_VERSION)
+        CV_Error(Error::StsNotImplemented, format("Unsupported version of network cache: %u (expected %u)",
+                                                  version, CACHE_VERSION));
+    if (header.get<uint32_t>() != CACHE_BYTE_ORDER)
+        CV_Error(Error::StsNotImplemented, "Network cache was written with different byte order");
+    uint64_t graphSize = header.get<uint64_t>();
+    header.check(graphSize);
+
+    const size_t dataOffset = alignSize(CACHE_HEADER_SIZE + (size_t)graphSize, CACHE_ALIGNMENT);
+    const size_t dataSize = file->size() - std::min(file->size(), dataOffset);
+    CacheReader graph(header.ptr, header.ptr + graphSize);
+
+    Net net;
+    std::vector<String> inputs(graph.get<uint32_t>());
+    for (size_t i = 0; i < inputs.size(); ++i)
+        inputs[i] = graph.getString();
+    net.setInputsNames(inputs);
+    int backend = graph.get<int32_t>();
+    int target = graph.get<int32_t>();
+    bool fusion = graph.get<uint8_t>() != 0;
+
+    uint32_t numLayers = graph.get<uint32_t>();
+    for (uint32_t l = 0; l < numLayers; ++l)
+    {
+        int id = graph.get<int32_t>();
+        String name = graph.getString();
+        String type = graph.getString();
+        LayerParams params;
+
+        uint32_t numParams = graph.get<uint32_t>();
+        for (uint32_t p = 0; p < numParams; ++p)
+        {
+            String key = graph.getString();
+            int valueType = graph.get<int32_t>();
+            int size = (int)graph.get<uint32_t>();
+            if (valueType == Param::INT)
+            {
+                std::vector<int64> values(size);
+                for (int i = 0; i < size; ++i)
+                    values[i] = graph.get<int64_t>();
+                params.set(key, DictValue::arrayInt(values.begin(), size));
+            }
+            else if (valueType == Param::REAL)
+            {
+                std::vector<double> values(size);
+                for (int i = 0; i < size; ++i)
+                    values[i] = graph.get<double>();
+                params.set(key, DictValue::arrayReal(values.begin(), size));
+            }
+            else if (valueType == Param::STRING)
+            {
+                std::vector<String> values(size);
+                for (int i = 0; i < size; ++i)
+                    values[i] = graph.getString();
+                params.set(key, DictValue::arrayString(values.begin(), size));
+            }
+            else
+                CV_Error(Error::StsParseError, "Network cache file is corrupted");
+        }
+
+        params.blobs.resize(graph.get<uint32_t>());
+        for (size_t i = 0; i < params.blobs.size(); ++i)
+        {
+            int blobType = graph.get<int32_t>();
+            int dims = graph.get<int32_t>();
+            if (dims < 0 || dims > CV_MAX_DIM)
+                CV_Error(Error::StsParseError, "Network cache file is corrupted");
+            std::vector<int> sizes(std::max(dims, 1));
+            for (int j = 0; j < dims; ++j)
+                sizes[j] = graph.get<int32_t>();
+            uint64_t offset = graph.get<uint64_t>();
+            if (dims == 0)
+                continue;
+            size_t blobSize = CV_ELEM_SIZE(blobType);
+            for (int j = 0; j < dims; ++j)
+                blobSize *= sizes[j];
+            if (offset > dataSize || blobSize > dataSize - offset)
+                CV_Error(Error::StsParseError, "Network cache file is corrupted");
+            // Blobs refer to the mapped file.
+            params.blobs[i] = MappedFile::wrap(file, dataOffset + (size_t)offset, dims, &sizes[0], blobType);
+        }
+
+        if (net.addLayer(name, type, params) != id)
+            CV_Error(Error::StsParseError, "Network cache file is corrupted");
+
+        uint32_t numInputs = graph.get<uint32_t>();
+        for (uint32_t i = 0; i < numInputs; ++i)
+        {
+            int lid = graph.get<int32_t>();
+            int oid = graph.get<int32_t>();
+            net.connect(lid, oid, id, (int)i);
+        }
+    }
+
+    net.setPreferableBackend(backend);
+    net.setPreferableTarget(target);
+    net.enableFusion(fusion);
+    return net;
+}
+
+Net readNetFromCache(const String& path)
+{
+    return Net::readFromCache(path);
+}
+
 Net readNetFromModelOptimizer(const String &xml, const String &bin)
 {
     return Net::readFromModelOptimizer(xml, bin);
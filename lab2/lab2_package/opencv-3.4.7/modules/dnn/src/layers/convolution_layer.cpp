@@ -257,7 +257,7 @@ public:
         }
         else
 #endif
-            return (kernel_size.size() == 3 && preferableTarget == DNN_TARGET_CPU && backendId == DNN_BACKEND_OPENCV) ||
+            return (kernel_size.size() == 3 && IS_DNN_CPU_TARGET(preferableTarget) && backendId == DNN_BACKEND_OPENCV) ||
                    (kernel_size.size() == 2 && (backendId == DNN_BACKEND_OPENCV || backendId == DNN_BACKEND_HALIDE));
     }
 
@@ -527,7 +527,7 @@ public:
     class ParallelConv : public cv::ParallelLoopBody
     {
     public:
-        enum { BLK_SIZE = 32, BLK_SIZE_CN = 64 };
+        enum { BLK_SIZE = 32, BLK_SIZE_CN = 64, FP16_TILE_SIZE = 4096 };
 
         const Mat* input_;
         const Mat* weights_;
@@ -565,7 +565,7 @@ public:
                        weights.rows == output.size[1],
                        weights.cols == (input.size[1]/ngroups)*karea,
                        input.type() == output.type(),
-                       input.type() == weights.type(),
+                       weights.type() == CV_32FC1 || weights.type() == CV_16SC1,
                        input.type() == CV_32FC1,
                        input.isContinuous(),
                        output.isContinuous(),
@@ -598,6 +598,8 @@ public:
             p.useAVX    = checkHardwareSupport(CPU_AVX)  && isConv2D;
             p.useAVX2   = checkHardwareSupport(CPU_AVX2) && isConv2D;
             p.useAVX512 = CV_CPU_HAS_SUPPORT_AVX512_SKX  && isConv2D;
+            setForwardKernel(p.useAVX512 ? "AVX512" : p.useAVX2 ? "AVX2" : p.useAVX ? "AVX" :
+                             CV_SIMD128 ? "SIMD128" : "generic");
 
             int ncn = std::min(inpCn, (int)BLK_SIZE_CN);
 
@@ -697,8 +699,16 @@ public:
 
             const float* data_inp0_ = input_->ptr<float>();
             const int* ofstab = &ofstab_[0];
-            const float* wptr_orig_ = weights_->ptr<float>();
-            size_t wstep = weights_->step1();
+            // half precision weights are expanded by tiles of output channels into wbuf
+            bool fp16 = weights_->depth() == CV_16S;
+            const float* wptr_orig_ = fp16 ? 0 : weights_->ptr<float>();
+            const short* wptr16_orig_ = fp16 ? weights_->ptr<short>() : 0;
+            size_t wstep0 = weights_->step1();
+            size_t wbufstep = alignSize(karea*std::min(inpCn, (int)BLK_SIZE_CN), valign);
+            // the kernels process 2 or 3 output channels at once
+            int wtileCn = fp16 ? std::min(std::max((int)(FP16_TILE_SIZE/wbufstep)/6*6, 6), outCn) : outCn;
+            AutoBuffer<float> wbuf_(fp16 ? wtileCn*wbufstep + valign*2 : 1);
+            float* wbuf = alignPtr(wbuf_.data(), (int)(valign*sizeof(float)*2));
             const float* biasptr_ = &biasvec_->at(0);
             const float* reluptr_ = reluslope_->empty() ? 0 : &reluslope_->at(0);
             float* data_out0_ = output_->ptr<float>();
@@ -727,7 +737,6 @@ public:
                 const float* data_inp0 = data_inp0_ + subsampleIdx*inpPlaneSize*inpCn;
                 float* data_out0 = data_out0_ + subsampleIdx*outPlaneSize*outCn;
                 int startOutCn = (subsampleIdx % ngroups)*outCn;
-                const float* wptr_orig = wptr_orig_ + wstep*startOutCn;
                 const float* biasptr = biasptr_ + startOutCn;
 
                 for( int cn0 = 0; cn0 < inpCn; cn0 += BLK_SIZE_CN )
@@ -735,7 +744,7 @@ public:
                     int cn1 = std::min(cn0 + BLK_SIZE_CN, inpCn);
                     int ncn = cn1 - cn0, vsz = karea*ncn;
                     int vsz_a = (int)alignSize(vsz, valign);
-                    const float* wptr = wptr_orig + cn0*karea;
+                    const float* wptr = fp16 ? 0 : wptr_orig_ + wstep0*startOutCn + cn0*karea;
                     // we apply [Channels][P]ReLU (if any) during the final pass only.
                     const float* relu = cn1 == inpCn && reluptr_ ? reluptr_ + startOutCn : 0;
 
@@ -872,130 +881,165 @@ public:
                         // now compute dot product of the weights
                         // and im2row-transformed part of the tensor
                         int bsz = ofs1 - ofs0;
-                    #if CV_TRY_AVX512_SKX
-                        /* AVX512 convolution requires an alignment of 16, and ROI is only there for larger vector sizes */
-                        if(useAVX512)
-                            opt_AVX512_SKX::fastConv(wptr, wstep, biasptr, rowbuf0, data_out0 + ofs0,
-                                          outShape, bsz, vsz, vsz_a, relu, cn0 == 0);
-                        else
-                    #endif
-                    #if CV_TRY_AVX2
-                        if(useAVX2)
-                            opt_AVX2::fastConv(wptr, wstep, biasptr, rowbuf0, data_out0 + ofs0,
-                                          outShape, bsz, vsz, vsz_a, relu, cn0 == 0);
-                        else
-                    #endif
-                    #if CV_TRY_AVX
-                        if(useAVX)
-                            opt_AVX::fastConv(wptr, wstep, biasptr, rowbuf0, data_out0 + ofs0,
-                                         outShape, bsz, vsz, vsz_a, relu, cn0 == 0);
-                        else
-                    #endif
-                        for( int i = 0; i < outCn; i += 2 )
+                        for( int oc0 = 0; oc0 < outCn; oc0 += wtileCn )
                         {
-                            const float* wptr0 = wptr + i*wstep;
-                            const float* wptr1 = wptr0 + wstep;
-                            float* outptr0 = data_out0 + ofs0 + i*outPlaneSize;
-                            float* outptr1 = outptr0 + outPlaneSize;
-                            float bias0 = biasptr[i], bias1 = biasptr[i+1];
-                            float r0 = 1.f, r1 = 1.f;
-
-                            if( i+1 >= outCn )
+                            int outCnT = std::min(outCn - oc0, wtileCn);
+                            int outShapeT[] = { outShape[0], outCnT, outShape[2], outShape[3] };
+                            const float* wptrT;
+                            size_t wstepT;
+                            if( fp16 )
                             {
-                                wptr1 = wptr0;
-                                outptr1 = outptr0;
-                                bias1 = bias0;
+                                // the tile stays in cache while it's used by the kernel below, so
+                                // only half precision weights are read from memory. The zero
+                                // padding of the rows is restored since the last block of
+                                // channels is shorter than the others. A single tile is
+                                // converted once per block of channels.
+                                if( wtileCn < outCn || ofs0 == stripeStart )
+                                {
+                                    Mat wsrc(outCnT, vsz, CV_16S, (void*)(wptr16_orig_ + wstep0*(startOutCn + oc0) + cn0*karea),
+                                             wstep0*sizeof(short));
+                                    Mat wdst(outCnT, vsz, CV_32F, wbuf, wbufstep*sizeof(float));
+                                    convertFp16(wsrc, wdst);
+                                    if( vsz < vsz_a )
+                                        for( i = 0; i < outCnT; i++ )
+                                            memset(wbuf + i*wbufstep + vsz, 0, (vsz_a - vsz)*sizeof(wbuf[0]));
+                                }
+                                wptrT = wbuf;
+                                wstepT = wbufstep;
                             }
-
-                            if( relu )
+                            else
                             {
-                                r0 = relu[i]; r1 = relu[i+1];
-                                if( i+1 >= outCn )
-                                    r1 = r0;
+                                wptrT = wptr + oc0*wstep0;
+                                wstepT = wstep0;
                             }
-
-                            int j = 0;
-                        #if CV_SIMD128
-                            v_float32x4 vr0 = v_setall_f32(r0), vr1 = v_setall_f32(r1), z = v_setzero_f32();
-
-                            for( ; j <= bsz - 4; j += 4 )
+                            const float* biasptrT = biasptr + oc0;
+                            const float* reluT = relu ? relu + oc0 : 0;
+                            float* data_outT = data_out0 + oc0*outPlaneSize;
+                        #if CV_TRY_AVX512_SKX
+                            /* AVX512 convolution requires an alignment of 16, and ROI is only there for larger vector sizes */
+                            if(useAVX512)
+                                opt_AVX512_SKX::fastConv(wptrT, wstepT, biasptrT, rowbuf0, data_outT + ofs0,
+                                              outShapeT, bsz, vsz, vsz_a, reluT, cn0 == 0);
+                            else
+                        #endif
+                        #if CV_TRY_AVX2
+                            if(useAVX2)
+                                opt_AVX2::fastConv(wptrT, wstepT, biasptrT, rowbuf0, data_outT + ofs0,
+                                              outShapeT, bsz, vsz, vsz_a, reluT, cn0 == 0);
+                            else
+                        #endif
+                        #if CV_TRY_AVX
+                            if(useAVX)
+                                opt_AVX::fastConv(wptrT, wstepT, biasptrT, rowbuf0, data_outT + ofs0,
+                                             outShapeT, bsz, vsz, vsz_a, reluT, cn0 == 0);
+                            else
+                        #endif
+                            for( int i = 0; i < outCnT; i += 2 )
                             {
-                                const float* rptr = rowbuf0 + j*vsz_a;
-                                v_float32x4 s0, s1;
-
-                                if( cn0 == 0 )
+                                const float* wptr0 = wptrT + i*wstepT;
+                                const float* wptr1 = wptr0 + wstepT;
+                                float* outptr0 = data_outT + ofs0 + i*outPlaneSize;
+                                float* outptr1 = outptr0 + outPlaneSize;
+                                float bias0 = biasptrT[i], bias1 = biasptrT[i+1];
+                                float r0 = 1.f, r1 = 1.f;
+
+                                if( i+1 >= outCnT )
                                 {
-                                    s0 = v_setall_f32(bias0);
-                                    s1 = v_setall_f32(bias1);
-                                }
-                                else
-                                {
-                                    s0 = v_load(outptr0 + j);
-                                    s1 = v_load(outptr1 + j);
+                                    wptr1 = wptr0;
+                                    outptr1 = outptr0;
+                                    bias1 = bias0;
                                 }
 
-                                v_float32x4 vs00 = v_setzero_f32(), vs01 = v_setzero_f32(),
-                                            vs02 = v_setzero_f32(), vs03 = v_setzero_f32(),
-                                            vs10 = v_setzero_f32(), vs11 = v_setzero_f32(),
-                                            vs12 = v_setzero_f32(), vs13 = v_setzero_f32();
-                                for( k = 0; k < vsz; k += 4, rptr += 4 )
-                                {
-                                    v_float32x4 w0 = v_load_aligned(wptr0 + k), w1 = v_load_aligned(wptr1 + k);
-                                    v_float32x4 r0 = v_load_aligned(rptr), r1 = v_load_aligned(rptr + vsz_a),
-                                                r2 = v_load_aligned(rptr + vsz_a*2), r3 = v_load_aligned(rptr + vsz_a*3);
-
-                                    vs00 += w0*r0;
-                                    vs01 += w0*r1;
-                                    vs02 += w0*r2;
-                                    vs03 += w0*r3;
-
-                                    vs10 += w1*r0;
-                                    vs11 += w1*r1;
-                                    vs12 += w1*r2;
-                                    vs13 += w1*r3;
-                                }
-                                s0 += v_reduce_sum4(vs00, vs01, vs02, vs03);
-                                s1 += v_reduce_sum4(vs10, vs11, vs12, vs13);
-                                if( relu )
+                                if( reluT )
                                 {
-                                    s0 = v_select(s0 > z, s0, s0*vr0);
-                                    s1 = v_select(s1 > z, s1, s1*vr1);
+                                    r0 = reluT[i]; r1 = reluT[i+1];
+                                    if( i+1 >= outCnT )
+                                        r1 = r0;
                                 }
 
-                                v_store(outptr0 + j, s0);
-                                v_store(outptr1 + j, s1);
-                            }
-                        #endif
-                            for( ; j < bsz; j++ )
-                            {
-                                const float* rptr = rowbuf0 + j*vsz_a;
-                                float s00, s10;
+                                int j = 0;
+                            #if CV_SIMD128
+                                v_float32x4 vr0 = v_setall_f32(r0), vr1 = v_setall_f32(r1), z = v_setzero_f32();
 
-                                if( cn0 == 0 )
-                                {
-                                    s00 = bias0;
-                                    s10 = bias1;
-                                }
-                                else
+                                for( ; j <= bsz - 4; j += 4 )
                                 {
-                                    s00 = outptr0[j];
-                                    s10 = outptr1[j];
-                                }
+                                    const float* rptr = rowbuf0 + j*vsz_a;
+                                    v_float32x4 s0, s1;
 
-                                for( k = 0; k < vsz; k++ )
-                                {
-                                    float r0 = rptr[k];
-                                    s00 += wptr0[k]*r0;
-                                    s10 += wptr1[k]*r0;
+                                    if( cn0 == 0 )
+                                    {
+                                        s0 = v_setall_f32(bias0);
+                                        s1 = v_setall_f32(bias1);
+                                    }
+                                    else
+                                    {
+                                        s0 = v_load(outptr0 + j);
+                                        s1 = v_load(outptr1 + j);
+                                    }
+
+                                    v_float32x4 vs00 = v_setzero_f32(), vs01 = v_setzero_f32(),
+                                                vs02 = v_setzero_f32(), vs03 = v_setzero_f32(),
+                                                vs10 = v_setzero_f32(), vs11 = v_setzero_f32(),
+                                                vs12 = v_setzero_f32(), vs13 = v_setzero_f32();
+                                    for( k = 0; k < vsz; k += 4, rptr += 4 )
+                                    {
+                                        v_float32x4 w0 = v_load_aligned(wptr0 + k), w1 = v_load_aligned(wptr1 + k);
+                                        v_float32x4 r0 = v_load_aligned(rptr), r1 = v_load_aligned(rptr + vsz_a),
+                                                    r2 = v_load_aligned(rptr + vsz_a*2), r3 = v_load_aligned(rptr + vsz_a*3);
+
+                                        vs00 += w0*r0;
+                                        vs01 += w0*r1;
+                                        vs02 += w0*r2;
+                                        vs03 += w0*r3;
+
+                                        vs10 += w1*r0;
+                                        vs11 += w1*r1;
+                                        vs12 += w1*r2;
+                                        vs13 += w1*r3;
+                                    }
+                                    s0 += v_reduce_sum4(vs00, vs01, vs02, vs03);
+                                    s1 += v_reduce_sum4(vs10, vs11, vs12, vs13);
+                                    if( reluT )
+                                    {
+                                        s0 = v_select(s0 > z, s0, s0*vr0);
+                                        s1 = v_select(s1 > z, s1, s1*vr1);
+                                    }
+
+                                    v_store(outptr0 + j, s0);
+                                    v_store(outptr1 + j, s1);
                                 }
-                                if( relu )
+                            #endif
+                                for( ; j < bsz; j++ )
                                 {
-                                    s00 = s00 > 0.f ? s00 : s00*r0;
-                                    s10 = s10 > 0.f ? s10 : s10*r1;
-                                }
+                                    const float* rptr = rowbuf0 + j*vsz_a;
+                                    float s00, s10;
 
-                                outptr0[j] = s00;
-                                outptr1[j] = s10;
+                                    if( cn0 == 0 )
+                                    {
+                                        s00 = bias0;
+                                        s10 = bias1;
+                                    }
+                                    else
+                                    {
+                                        s00 = outptr0[j];
+                                        s10 = outptr1[j];
+                                    }
+
+                                    for( k = 0; k < vsz; k++ )
+                                    {
+                                        float r0 = rptr[k];
+                                        s00 += wptr0[k]*r0;
+                                        s10 += wptr1[k]*r0;
+                                    }
+                                    if( reluT )
+                                    {
+                                        s00 = s00 > 0.f ? s00 : s00*r0;
+                                        s10 = s10 > 0.f ? s10 : s10*r1;
+                                    }
+
+                                    outptr0[j] = s00;
+                                    outptr1[j] = s10;
+                                }
                             }
                         }
                     }
@@ -1195,6 +1239,18 @@ public:
             }
         }
 
+        if (preferableTarget == DNN_TARGET_CPU_FP16 && weightsMat.depth() == CV_32F)
+        {
+            // All the weights fusions are done at this point. Convert the rows
+            // together with their alignment padding to keep the same layout.
+            // The single precision working copy is released, blobs[0] keeps
+            // the learned weights.
+            Mat wm(weightsMat.rows, (int)weightsMat.step1(), CV_32F, weightsMat.data, weightsMat.step);
+            Mat wm16;
+            convertFp16(wm, wm16);
+            weightsMat = wm16.colRange(0, weightsMat.cols);
+        }
+
         int nstripes = std::max(getNumThreads(), 1);
 
         ParallelConv::run(inputs[0], outputs[0], weightsMat, biasvec, reluslope,
@@ -44,6 +44,7 @@
 #include "layers_common.hpp"
 #include "../op_halide.hpp"
 #include "../op_inf_engine.hpp"
+#include "vec_math.hpp"
 #include <opencv2/dnn/shape_utils.hpp>
 #include <iostream>
 
@@ -476,7 +477,12 @@ struct TanHFunctor
     {
         for( int cn = cn0; cn < cn1; cn++, srcptr += planeSize, dstptr += planeSize )
         {
-            for( int i = 0; i < len; i++ )
+            int i = 0;
+#if CV_SIMD128
+            for( ; i <= len - 4; i += 4 )
+                v_store(dstptr + i, v_tanh_approx(v_load(srcptr + i)));
+#endif
+            for( ; i < len; i++ )
             {
                 float x = srcptr[i];
                 dstptr[i] = tanh(x);
@@ -548,7 +554,12 @@ struct SigmoidFunctor
     {
         for( int cn = cn0; cn < cn1; cn++, srcptr += planeSize, dstptr += planeSize )
         {
-            for( int i = 0; i < len; i++ )
+            int i = 0;
+#if CV_SIMD128
+            for( ; i <= len - 4; i += 4 )
+                v_store(dstptr + i, v_sigmoid_approx(v_load(srcptr + i)));
+#endif
+            for( ; i < len; i++ )
             {
                 float x = srcptr[i];
                 dstptr[i] = 1.f/(1.f + exp(-x));
@@ -606,6 +617,85 @@ struct SigmoidFunctor
     int64 getFLOPSPerElement() const { return 3; }
 };
 
+struct SwishFunctor
+{
+    typedef SwishLayer Layer;
+
+    bool supportBackend(int backendId, int)
+    {
+        return backendId == DNN_BACKEND_OPENCV || backendId == DNN_BACKEND_HALIDE;
+    }
+
+    void apply(const float* srcptr, float* dstptr, int len, size_t planeSize, int cn0, int cn1) const
+    {
+        for( int cn = cn0; cn < cn1; cn++, srcptr += planeSize, dstptr += planeSize )
+        {
+            int i = 0;
+#if CV_SIMD128
+            for( ; i <= len - 4; i += 4 )
+            {
+                v_float32x4 x = v_load(srcptr + i);
+                v_store(dstptr + i, x * v_sigmoid_approx(x));
+            }
+#endif
+            for( ; i < len; i++ )
+            {
+                float x = srcptr[i];
+                dstptr[i] = x/(1.f + exp(-x));
+            }
+        }
+    }
+
+#ifdef HAVE_OPENCL
+    bool applyOCL(InputArrayOfArrays inps, OutputArrayOfArrays outs, OutputArrayOfArrays internals)
+    {
+        std::vector<UMat> inputs;
+        std::vector<UMat> outputs;
+
+        inps.getUMatVector(inputs);
+        outs.getUMatVector(outputs);
+        String buildopt = oclGetTMacro(inputs[0]);
+
+        for (size_t i = 0; i < inputs.size(); i++)
+        {
+            UMat& src = inputs[i];
+            UMat& dst = outputs[i];
+
+            ocl::Kernel kernel("SwishForward", ocl::dnn::activations_oclsrc, buildopt);
+            kernel.set(0, (int)src.total());
+            kernel.set(1, ocl::KernelArg::PtrReadOnly(src));
+            kernel.set(2, ocl::KernelArg::PtrWriteOnly(dst));
+
+            size_t gSize = src.total();
+            CV_Assert(kernel.run(1, &gSize, NULL, false));
+        }
+
+        return true;
+    }
+#endif
+
+#ifdef HAVE_HALIDE
+    void attachHalide(const Halide::Expr& input, Halide::Func& top)
+    {
+        Halide::Var x("x"), y("y"), c("c"), n("n");
+        top(x, y, c, n) = input / (1.0f + exp(-input));
+    }
+#endif  // HAVE_HALIDE
+
+#ifdef HAVE_INF_ENGINE
+    InferenceEngine::Builder::Layer initInfEngineBuilderAPI()
+    {
+        CV_Error(Error::StsNotImplemented, "");
+    }
+#endif  // HAVE_INF_ENGINE
+
+    bool tryFuse(Ptr<dnn::Layer>&) { return false; }
+
+    void getScaleShift(Mat&, Mat&) const {}
+
+    int64 getFLOPSPerElement() const { return 4; }
+};
+
 struct ELUFunctor
 {
     typedef ELULayer Layer;
@@ -622,7 +712,15 @@ struct ELUFunctor
     {
         for( int cn = cn0; cn < cn1; cn++, srcptr += planeSize, dstptr += planeSize )
         {
-            for(int i = 0; i < len; i++ )
+            int i = 0;
+#if CV_SIMD128
+            for( ; i <= len - 4; i += 4 )
+            {
+                v_float32x4 x = v_load(srcptr + i);
+                v_store(dstptr + i, v_select(x >= v_setzero_f32(), x, v_exp_approx(x) - v_setall_f32(1.f)));
+            }
+#endif
+            for( ; i < len; i++ )
             {
                 float x = srcptr[i];
                 dstptr[i] = x >= 0.f ? x : exp(x) - 1;
@@ -768,7 +866,17 @@ struct BNLLFunctor
     {
         for( int cn = cn0; cn < cn1; cn++, srcptr += planeSize, dstptr += planeSize )
         {
-            for( int i = 0; i < len; i++ )
+            int i = 0;
+#if CV_SIMD128
+            for( ; i <= len - 4; i += 4 )
+            {
+                // max(x, 0) + log(1 + exp(-|x|))
+                v_float32x4 x = v_load(srcptr + i);
+                v_float32x4 y = v_log_approx(v_setall_f32(1.f) + v_exp_approx(v_setzero_f32() - v_abs(x)));
+                v_store(dstptr + i, v_max(x, v_setzero_f32()) + y);
+            }
+#endif
+            for( ; i < len; i++ )
             {
                 float x = srcptr[i];
                 // https://github.com/BVLC/caffe/blame/1.0/src/caffe/layers/bnll_layer.cpp#L17
@@ -1119,6 +1227,14 @@ Ptr<SigmoidLayer> SigmoidLayer::create(const LayerParams& params)
     return l;
 }
 
+Ptr<SwishLayer> SwishLayer::create(const LayerParams& params)
+{
+    Ptr<SwishLayer> l(new ElementWiseLayer<SwishFunctor>());
+    l->setParamsFrom(params);
+
+    return l;
+}
+
 Ptr<ELULayer> ELULayer::create(const LayerParams& params)
 {
     Ptr<ELULayer> l(new ElementWiseLayer<ELUFunctor>(ELUFunctor()));
@@ -59,7 +59,7 @@ namespace dnn
 class FullyConnectedLayerImpl CV_FINAL : public InnerProductLayer
 {
 public:
-    enum { VEC_ALIGN = 8 };
+    enum { VEC_ALIGN = 8, FP16_BUF_SIZE = 8192 };
 
 #ifdef HAVE_OPENCL
     Ptr<OCL4DNNInnerProduct<float> > innerProductOp;
@@ -80,7 +80,21 @@ public:
         CV_Assert(blobs[0].dims >= 2 && (size_t)(innerSize * numOutput) == blobs[0].total());
         CV_Assert(!bias || (blobs.size() == 2 && (size_t)numOutput == blobs[1].total()));
 
-        weightsMat = blobs[0] = blobs[0].reshape(1, numOutput);
+        blobs[0] = blobs[0].reshape(1, numOutput);
+        initWeights();
+
+        if (bias)
+            biasMat = blobs[1] = blobs[1].reshape(1, 1);
+        else
+            biasMat = Mat::zeros(1, numOutput, weightsMat.type());
+    }
+
+    // Sets up the single precision weights with rows padded to VEC_ALIGN.
+    // DNN_TARGET_CPU_FP16 releases them, so they are set up again for other targets.
+    void initWeights()
+    {
+        weightsMat16.release();
+        weightsMat = blobs[0];
         int vecsize = weightsMat.cols;
         if( vecsize % VEC_ALIGN != 0 )
         {
@@ -91,11 +105,6 @@ public:
             weightsMat = weightsBuf.colRange(0, vecsize);
             blobs[0].copyTo(weightsMat);
         }
-
-        if (bias)
-            biasMat = blobs[1] = blobs[1].reshape(1, 1);
-        else
-            biasMat = Mat::zeros(1, numOutput, weightsMat.type());
     }
 
     bool getMemoryShapes(const std::vector<MatShape> &inputs,
@@ -148,8 +157,9 @@ public:
         {
             CV_Assert( srcMat.dims == 2 && srcMat.cols == weights.cols &&
                        dstMat.rows == srcMat.rows && dstMat.cols == weights.rows &&
-                       srcMat.type() == weights.type() && weights.type() == dstMat.type() &&
-                       srcMat.type() == CV_32F &&
+                       srcMat.type() == dstMat.type() && srcMat.type() == CV_32F &&
+                       (weights.type() == CV_32F || (weights.type() == CV_16S &&
+                        weights.step1() >= (size_t)alignSize(weights.cols, FullyConnectedLayerImpl::VEC_ALIGN))) &&
                        (biasMat.empty() || (biasMat.type() == srcMat.type() &&
                                            biasMat.isContinuous() && (int)biasMat.total() == dstMat.cols)) );
 
@@ -164,6 +174,8 @@ public:
             p.useAVX = checkHardwareSupport(CPU_AVX);
             p.useAVX2 = checkHardwareSupport(CPU_AVX2);
             p.useAVX512 = CV_CPU_HAS_SUPPORT_AVX512_SKX;
+            setForwardKernel(p.useAVX512 ? "AVX512" : p.useAVX2 ? "AVX2" : p.useAVX ? "AVX" :
+                             CV_SIMD128 ? "SIMD128" : "generic");
 
             parallel_for_(Range(0, nstripes), p, nstripes);
         }
@@ -179,81 +191,108 @@ public:
             size_t stripeSize = (total + nstripes - 1)/nstripes;
             size_t stripeStart = r.start*stripeSize;
             size_t stripeEnd = r.end == nstripes ? total : std::min(r.end*stripeSize, total);
-            size_t wstep = weights->step1();
             AutoBuffer<float> srcbuf(vecsize_aligned + valign);
             float* sptr = alignPtr(srcbuf.data(), (int)(valign*sizeof(float)));
 
             for( k = vecsize; k < vecsize_aligned; k++ )
                 sptr[k] = 0.f;
 
+            // half precision weights are expanded into a small cache-resident
+            // buffer by groups of rows (including their zero padding)
+            bool fp16 = weights->depth() == CV_16S;
+            int nwblk = fp16 ? std::max(FullyConnectedLayerImpl::FP16_BUF_SIZE / vecsize_aligned, 1) : nw0;
+            AutoBuffer<float> wbuf_(fp16 ? (size_t)nwblk*vecsize_aligned + valign : 1);
+            float* wbuf = alignPtr(wbuf_.data(), (int)(valign*sizeof(float)));
+
             for( size_t ofs = stripeStart; ofs < stripeEnd; )
             {
                 int sampleIdx = (int)(ofs / nw0);
                 int delta = (int)(ofs - (size_t)sampleIdx*nw0);
                 const float* sptr_ = srcMat->ptr<float>(sampleIdx);
-                const float* wptr = weights->ptr<float>(delta);
-                float* dptr = dstMat->ptr<float>(sampleIdx) + delta;
-                const float* biasptr = biasMat->ptr<float>() + delta;
-                int nw = std::min(nw0 - delta, (int)(stripeEnd - ofs));
+                float* dptr0 = dstMat->ptr<float>(sampleIdx) + delta;
+                const float* biasptr0 = biasMat->ptr<float>() + delta;
+                int nw1 = std::min(nw0 - delta, (int)(stripeEnd - ofs));
 
                 memcpy(sptr, sptr_, vecsize*sizeof(sptr[0]));
 
-            #if CV_TRY_AVX512_SKX
-                if( useAVX512 )
-                    opt_AVX512_SKX::fastGEMM1T( sptr, wptr, wstep, biasptr, dptr, nw, vecsize);
-                else
-            #endif
-            #if CV_TRY_AVX2
-                if( useAVX2 )
-                    opt_AVX2::fastGEMM1T( sptr, wptr, wstep, biasptr, dptr, nw, vecsize);
-                else
-            #endif
-            #if CV_TRY_AVX
-                if( useAVX )
-                    opt_AVX::fastGEMM1T( sptr, wptr, wstep, biasptr, dptr, nw, vecsize);
-                else
-            #endif
+                for( int i0 = 0; i0 < nw1; i0 += nwblk )
                 {
-                    int i = 0;
+                    int nw = std::min(nw1 - i0, nwblk);
+                    float* dptr = dptr0 + i0;
+                    const float* biasptr = biasptr0 + i0;
+                    const float* wptr;
+                    size_t wstep;
+                    if( fp16 )
+                    {
+                        Mat wsrc(nw, vecsize_aligned, CV_16S, (void*)weights->ptr<short>(delta + i0), weights->step);
+                        Mat wdst(nw, vecsize_aligned, CV_32F, wbuf);
+                        convertFp16(wsrc, wdst);
+                        wptr = wbuf;
+                        wstep = vecsize_aligned;
+                    }
+                    else
+                    {
+                        wptr = weights->ptr<float>(delta + i0);
+                        wstep = weights->step1();
+                    }
 
-            #if CV_SIMD128
-                    for( ; i <= nw - 4; i += 4, wptr += 4*wstep )
+                #if CV_TRY_AVX512_SKX
+                    if( useAVX512 )
+                        opt_AVX512_SKX::fastGEMM1T( sptr, wptr, wstep, biasptr, dptr, nw, vecsize);
+                    else
+                #endif
+                #if CV_TRY_AVX2
+                    if( useAVX2 )
+                        opt_AVX2::fastGEMM1T( sptr, wptr, wstep, biasptr, dptr, nw, vecsize);
+                    else
+                #endif
+                #if CV_TRY_AVX
+                    if( useAVX )
+                        opt_AVX::fastGEMM1T( sptr, wptr, wstep, biasptr, dptr, nw, vecsize);
+                    else
+                #endif
                     {
-                        v_float32x4 vs0 = v_setall_f32(0.f), vs1 = v_setall_f32(0.f);
-                        v_float32x4 vs2 = v_setall_f32(0.f), vs3 = v_setall_f32(0.f);
+                        int i = 0;
 
-                        for( k = 0; k < vecsize; k += 4 )
+                #if CV_SIMD128
+                        for( ; i <= nw - 4; i += 4, wptr += 4*wstep )
                         {
-                            v_float32x4 v = v_load_aligned(sptr + k);
-                            vs0 += v*v_load_aligned(wptr + k);
-                            vs1 += v*v_load_aligned(wptr + wstep + k);
-                            vs2 += v*v_load_aligned(wptr + wstep*2 + k);
-                            vs3 += v*v_load_aligned(wptr + wstep*3 + k);
+                            v_float32x4 vs0 = v_setall_f32(0.f), vs1 = v_setall_f32(0.f);
+                            v_float32x4 vs2 = v_setall_f32(0.f), vs3 = v_setall_f32(0.f);
+
+                            for( k = 0; k < vecsize; k += 4 )
+                            {
+                                v_float32x4 v = v_load_aligned(sptr + k);
+                                vs0 += v*v_load_aligned(wptr + k);
+                                vs1 += v*v_load_aligned(wptr + wstep + k);
+                                vs2 += v*v_load_aligned(wptr + wstep*2 + k);
+                                vs3 += v*v_load_aligned(wptr + wstep*3 + k);
+                            }
+
+                            v_float32x4 s = v_reduce_sum4(vs0, vs1, vs2, vs3);
+                            s += v_load(biasptr + i);
+                            v_store(dptr + i, s);
                         }
+                #endif
 
-                        v_float32x4 s = v_reduce_sum4(vs0, vs1, vs2, vs3);
-                        s += v_load(biasptr + i);
-                        v_store(dptr + i, s);
-                    }
-            #endif
-
-                    for( ; i < nw; i++, wptr += wstep )
-                    {
-                        float s0=biasptr[i];
-
-                        for( k = 0; k < vecsize; k++ )
+                        for( ; i < nw; i++, wptr += wstep )
                         {
-                            float v = sptr[k];
-                            s0 += v*wptr[k];
+                            float s0=biasptr[i];
+
+                            for( k = 0; k < vecsize; k++ )
+                            {
+                                float v = sptr[k];
+                                s0 += v*wptr[k];
+                            }
+                            dptr[i] = s0;
                         }
-                        dptr[i] = s0;
                     }
                 }
 
                 if(activ)
-                    activ->forwardSlice(dptr, dptr, 1, 1, delta, delta + nw);
+                    activ->forwardSlice(dptr0, dptr0, 1, 1, delta, delta + nw1);
 
-                ofs += nw;
+                ofs += nw1;
             }
         }
 
@@ -405,13 +444,30 @@ public:
         int axisCan = clamp(axis, input[0].dims);
         int outerSize = input[0].total(0, axisCan);
 
+        if (preferableTarget == DNN_TARGET_CPU_FP16)
+        {
+            if (weightsMat16.empty())
+            {
+                Mat wm(weightsMat.rows, (int)alignSize(weightsMat.cols, VEC_ALIGN), CV_32F,
+                       weightsMat.data, weightsMat.step);
+                convertFp16(wm, weightsMat16);
+                // the single precision working copy is released, blobs[0]
+                // keeps the learned weights
+                weightsMat16 = weightsMat16.colRange(0, weightsMat.cols);
+                weightsMat.release();
+            }
+        }
+        else if (weightsMat.empty())
+            initWeights();
+
         for (size_t i = 0; i < input.size(); i++)
         {
             Mat srcMat = input[i].reshape(1, outerSize);
             Mat dstMat = output[i].reshape(1, outerSize);
 
             const int nstripes = getNumThreads();
-            FullyConnected::run(srcMat, weightsMat, biasMat, dstMat, activ.get(), nstripes);
+            FullyConnected::run(srcMat, weightsMat.empty() ? weightsMat16 : weightsMat,
+                                biasMat, dstMat, activ.get(), nstripes);
         }
     }
 
@@ -474,6 +530,7 @@ public:
 
     bool bias;
     Mat weightsMat, biasMat;
+    Mat weightsMat16;  // half precision copy of weightsMat for DNN_TARGET_CPU_FP16
     Ptr<ActivationLayer> activ;
 };
 
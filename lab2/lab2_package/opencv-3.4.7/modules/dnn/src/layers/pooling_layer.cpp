@@ -65,6 +65,98 @@ static inline int roundRoiSize(float v)
     return (int)(v + (v >= 0.f ? 0.5f : -0.5f));
 }
 
+// Maximum over the clipped window [x0, x0 + kernel) of a row. Empty windows
+// result in zero, as in the generic implementation.
+static inline float maxPoolRow(const float* row, int width, int x0, int kernel)
+{
+    int x1 = std::min(x0 + kernel, width);
+    x0 = std::max(x0, 0);
+    if (x0 >= x1)
+        return 0.f;
+    float v = row[x0];
+    for (int x = x0 + 1; x < x1; ++x)
+        v = std::max(v, row[x]);
+    return v;
+}
+
+// Max pooling of a single plane by separable passes: maximum along rows into
+// [buf] (inpHeight x outWidth) and then along columns. Complexity is
+// O(kernel_h + kernel_w) per output instead of O(kernel_h * kernel_w).
+static void maxPoolPlane(const float* src, int inpHeight, int inpWidth,
+                         float* dst, int outHeight, int outWidth,
+                         int kernel_h, int kernel_w, int stride_h, int stride_w,
+                         int pad_t, int pad_l, float* buf)
+{
+    // Outputs in [xstart, xend) have windows inside of the row.
+    const int xstart = std::min(outWidth, (pad_l + stride_w - 1) / stride_w);
+    const int xend = inpWidth + pad_l < kernel_w ? xstart :
+                     std::max(xstart, std::min(outWidth, (inpWidth + pad_l - kernel_w) / stride_w + 1));
+    for (int y = 0; y < inpHeight; ++y)
+    {
+        const float* srcRow = src + (size_t)y * inpWidth;
+        float* bufRow = buf + (size_t)y * outWidth;
+        int x = 0;
+        for (; x < xstart; ++x)
+            bufRow[x] = maxPoolRow(srcRow, inpWidth, x * stride_w - pad_l, kernel_w);
+#if CV_SIMD128
+        if (stride_w == 1)
+        {
+            for (; x <= xend - 4; x += 4)
+            {
+                const float* p = srcRow + x - pad_l;
+                v_float32x4 v = v_load(p);
+                for (int k = 1; k < kernel_w; ++k)
+                    v = v_max(v, v_load(p + k));
+                v_store(bufRow + x, v);
+            }
+        }
+        else if (stride_w == 2)
+        {
+            // Deinterleaving loads read one element after the window.
+            for (; x <= xend - 4 && 2 * x - pad_l + kernel_w + 6 < inpWidth; x += 4)
+            {
+                const float* p = srcRow + 2 * x - pad_l;
+                v_float32x4 v, even, odd;
+                v_load_deinterleave(p, v, odd);
+                for (int k = 1; k < kernel_w; ++k)
+                {
+                    v_load_deinterleave(p + k, even, odd);
+                    v = v_max(v, even);
+                }
+                v_store(bufRow + x, v);
+            }
+        }
+#endif
+        for (; x < outWidth; ++x)
+            bufRow[x] = maxPoolRow(srcRow, inpWidth, x * stride_w - pad_l, kernel_w);
+    }
+
+    for (int y = 0; y < outHeight; ++y)
+    {
+        int y0 = y * stride_h - pad_t;
+        int y1 = std::min(y0 + kernel_h, inpHeight);
+        y0 = std::max(y0, 0);
+        float* dstRow = dst + (size_t)y * outWidth;
+        if (y0 >= y1)
+        {
+            memset(dstRow, 0, outWidth * sizeof(float));
+            continue;
+        }
+        memcpy(dstRow, buf + (size_t)y0 * outWidth, outWidth * sizeof(float));
+        for (int j = y0 + 1; j < y1; ++j)
+        {
+            const float* bufRow = buf + (size_t)j * outWidth;
+            int x = 0;
+#if CV_SIMD128
+            for (; x <= outWidth - 4; x += 4)
+                v_store(dstRow + x, v_max(v_load(dstRow + x), v_load(bufRow + x)));
+#endif
+            for (; x < outWidth; ++x)
+                dstRow[x] = std::max(dstRow[x], bufRow[x]);
+        }
+    }
+}
+
 class PoolingLayerImpl CV_FINAL : public PoolingLayer
 {
 public:
@@ -178,7 +270,7 @@ public:
 #endif
         }
         else
-            return (kernel_size.size() == 3 && backendId == DNN_BACKEND_OPENCV && preferableTarget == DNN_TARGET_CPU) ||
+            return (kernel_size.size() == 3 && backendId == DNN_BACKEND_OPENCV && IS_DNN_CPU_TARGET(preferableTarget)) ||
                    ((kernel_size.empty() || kernel_size.size() == 2) && (backendId == DNN_BACKEND_OPENCV ||
                    (backendId == DNN_BACKEND_HALIDE && haveHalide() &&
                    (type == MAX || (type == AVE && !pad_t && !pad_l && !pad_b && !pad_r)))));
@@ -782,9 +874,45 @@ public:
         }
     };
 
+    // Separable max pooling of 2D planes without indices.
+    class MaxPoolingInvoker : public ParallelLoopBody
+    {
+    public:
+        MaxPoolingInvoker(const Mat& src_, Mat& dst_, const std::vector<size_t>& kernel_,
+                          const std::vector<size_t>& strides_, const std::vector<size_t>& pads_)
+            : src(src_), dst(dst_), kernel(kernel_), strides(strides_), pads(pads_) {}
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            const int inpHeight = src.size[2], inpWidth = src.size[3];
+            const int outHeight = dst.size[2], outWidth = dst.size[3];
+            AutoBuffer<float> buf((size_t)inpHeight * outWidth);
+            for (int i = r.start; i < r.end; ++i)
+            {
+                maxPoolPlane(src.ptr<float>() + (size_t)i * inpHeight * inpWidth, inpHeight, inpWidth,
+                             dst.ptr<float>() + (size_t)i * outHeight * outWidth, outHeight, outWidth,
+                             (int)kernel[0], (int)kernel[1], (int)strides[0], (int)strides[1],
+                             (int)pads[0], (int)pads[1], buf.data());
+            }
+        }
+
+    private:
+        const Mat& src;
+        Mat& dst;
+        const std::vector<size_t>& kernel, &strides, &pads;
+    };
+
     void maxPooling(Mat &src, Mat &dst, Mat &mask)
     {
         const int nstripes = getNumThreads();
+        if (!computeMaxIdx && kernel_size.size() == 2 && src.dims == 4 &&
+            src.isContinuous() && dst.isContinuous())
+        {
+            const int planes = src.size[0] * src.size[1];
+            parallel_for_(Range(0, planes), MaxPoolingInvoker(src, dst, kernel_size, strides, pads_begin),
+                          std::min(planes, nstripes));
+            return;
+        }
         Mat rois;
         PoolingInvoker::run(src, rois, dst, mask, kernel_size, strides, pads_begin, pads_end, avePoolPaddedArea, type, spatialScale, computeMaxIdx, nstripes);
     }
@@ -1024,5 +1152,102 @@ Ptr<PoolingLayer> PoolingLayer::create(const LayerParams& params)
     return Ptr<PoolingLayer>(new PoolingLayerImpl(params));
 }
 
+class SPPFLayerImpl CV_FINAL : public SPPFLayer
+{
+public:
+    SPPFLayerImpl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+        kernelSize = params.get<int>("kernel_size", 5);
+        numPools = params.get<int>("num_pools", 3);
+        CV_Assert_N(kernelSize > 0 && kernelSize % 2 == 1, numPools > 0);
+    }
+
+    virtual bool supportBackend(int backendId) CV_OVERRIDE
+    {
+        return backendId == DNN_BACKEND_OPENCV;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        CV_Assert_N(inputs.size() == 1, inputs[0].size() == 4);
+        MatShape outShape = inputs[0];
+        outShape[1] *= numPools + 1;
+        outputs.assign(1, outShape);
+        return false;
+    }
+
+    class SPPFInvoker : public ParallelLoopBody
+    {
+    public:
+        SPPFInvoker(const Mat& src_, Mat& dst_, int kernelSize_, int numPools_)
+            : src(src_), dst(dst_), kernelSize(kernelSize_), numPools(numPools_) {}
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            const int channels = src.size[1], height = src.size[2], width = src.size[3];
+            const size_t planeSize = (size_t)height * width;
+            const int pad = kernelSize / 2;
+            AutoBuffer<float> buf(planeSize);
+            for (int i = r.start; i < r.end; ++i)
+            {
+                const int n = i / channels, c = i % channels;
+                const float* srcData = src.ptr<float>(n, c);
+                float* dstData = dst.ptr<float>(n, c);
+                if (srcData != dstData)
+                    memcpy(dstData, srcData, planeSize * sizeof(float));
+                // Every pooling consumes output of the previous one.
+                for (int k = 0; k < numPools; ++k, dstData += channels * planeSize)
+                {
+                    maxPoolPlane(dstData, height, width, dstData + channels * planeSize, height, width,
+                                 kernelSize, kernelSize, 1, 1, pad, pad, buf.data());
+                }
+            }
+        }
+
+    private:
+        const Mat& src;
+        Mat& dst;
+        int kernelSize, numPools;
+    };
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        if (inputs_arr.depth() == CV_16S)
+        {
+            forward_fallback(inputs_arr, outputs_arr, internals_arr);
+            return;
+        }
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+        CV_Assert_N(inputs.size() == 1, outputs.size() == 1);
+        CV_Assert_N(inputs[0].isContinuous(), outputs[0].isContinuous());
+
+        const int planes = inputs[0].size[0] * inputs[0].size[1];
+        parallel_for_(Range(0, planes), SPPFInvoker(inputs[0], outputs[0], kernelSize, numPools),
+                      std::min(planes, getNumThreads()));
+    }
+
+    virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
+                           const std::vector<MatShape> &outputs) const CV_OVERRIDE
+    {
+        CV_UNUSED(outputs); // suppress unused variable warning
+        return total(inputs[0]) * numPools * 2 * kernelSize;
+    }
+};
+
+Ptr<SPPFLayer> SPPFLayer::create(const LayerParams& params)
+{
+    return Ptr<SPPFLayer>(new SPPFLayerImpl(params));
+}
+
 }
 }
@@ -44,6 +44,7 @@
 #include <opencv2/dnn/shape_utils.hpp>
 #include <opencv2/dnn/all_layers.hpp>
 #include "../nms.inl.hpp"
+#include "vec_math.hpp"
 
 #ifdef HAVE_OPENCL
 #include "opencl_kernels_dnn.hpp"
@@ -103,25 +104,117 @@ public:
         return false;
     }
 
-    float logistic_activate(float x) { return 1.F / (1.F + exp(-x)); }
+    static float logistic_activate(float x) { return 1.F / (1.F + exp(-x)); }
 
-    void softmax_activate(const float* input, const int n, const float temp, float* output)
+    // Processes grid cells (X x Y x Anchor-index) of all the images in a batch.
+    class RegionInvoker : public ParallelLoopBody
     {
-        int i;
-        float sum = 0;
-        float largest = -FLT_MAX;
-        for (i = 0; i < n; ++i) {
-            if (input[i] > largest) largest = input[i];
+    public:
+        RegionInvoker(const RegionLayerImpl& layer, const float* srcData, float* dstData,
+                      const float* biasData, int rows, int cols, int hNorm, int wNorm)
+            : layer(layer), srcData(srcData), dstData(dstData), biasData(biasData),
+              rows(rows), cols(cols), hNorm(hNorm), wNorm(wNorm) {}
+
+        void operator()(const Range& r) const CV_OVERRIDE
+        {
+            const int anchors = layer.anchors, classes = layer.classes;
+            const int cell_size = classes + layer.coords + 1;
+            const float thresh = layer.thresh;
+            for (int i = r.start; i < r.end; ++i)
+            {
+                const int a = i % anchors;
+                const int x = (i / anchors) % cols;
+                const int y = (i / anchors / cols) % rows;
+                const float* src = srcData + (size_t)i * cell_size;
+                float* dst = dstData + (size_t)i * cell_size;
+
+                dst[0] = (x + logistic_activate(src[0])) / cols;
+                dst[1] = (y + logistic_activate(src[1])) / rows;
+                dst[2] = exp(src[2]) * biasData[2 * a] / wNorm;
+                dst[3] = exp(src[3]) * biasData[2 * a + 1] / hNorm;
+
+                // logistic activation for t0
+                float scale = dst[4] = logistic_activate(src[4]);
+                if (layer.classfix == -1 && scale < .5) scale = 0;  // if(t0 < 0.5) t0 = 0;
+
+                // prob = IoU(box, object) = t0 * class-probability never exceeds
+                // the threshold if t0 doesn't.
+                if (scale <= thresh)
+                {
+                    memset(dst + 5, 0, classes * sizeof(float));
+                    continue;
+                }
+                if (layer.useSoftmax)  // Yolo v2
+                    softmax(src + 5, classes, scale, thresh, dst + 5);
+                else  // Yolo v3
+                    logistic(src + 5, classes, scale, thresh, dst + 5);
+            }
         }
-        for (i = 0; i < n; ++i) {
-            float e = exp((input[i] - largest) / temp);
-            sum += e;
-            output[i] = e;
+
+    private:
+        // Writes scale * softmax(input), values below the threshold are set to zero.
+        static void softmax(const float* input, int n, float scale, float thresh, float* output)
+        {
+            float largest = -FLT_MAX;
+            for (int i = 0; i < n; ++i)
+                largest = std::max(largest, input[i]);
+
+            float sum = 0;
+            int i = 0;
+#if CV_SIMD128
+            v_float32x4 v_largest = v_setall_f32(largest), v_sum = v_setzero_f32();
+            for (; i <= n - 4; i += 4)
+            {
+                v_float32x4 e = v_exp_approx(v_load(input + i) - v_largest);
+                v_sum += e;
+                v_store(output + i, e);
+            }
+            sum = v_reduce_sum(v_sum);
+#endif
+            for (; i < n; ++i)
+            {
+                output[i] = exp(input[i] - largest);
+                sum += output[i];
+            }
+            threshold(output, n, scale / sum, thresh);
+        }
+
+        static void logistic(const float* input, int n, float scale, float thresh, float* output)
+        {
+            int i = 0;
+#if CV_SIMD128
+            for (; i <= n - 4; i += 4)
+                v_store(output + i, v_sigmoid_approx(v_load(input + i)));
+#endif
+            for (; i < n; ++i)
+                output[i] = logistic_activate(input[i]);
+            threshold(output, n, scale, thresh);
         }
-        for (i = 0; i < n; ++i) {
-            output[i] /= sum;
+
+        static void threshold(float* data, int n, float scale, float thresh)
+        {
+            int i = 0;
+#if CV_SIMD128
+            v_float32x4 v_scale = v_setall_f32(scale), v_thresh = v_setall_f32(thresh);
+            for (; i <= n - 4; i += 4)
+            {
+                v_float32x4 prob = v_load(data + i) * v_scale;
+                v_store(data + i, v_select(prob > v_thresh, prob, v_setzero_f32()));
+            }
+#endif
+            for (; i < n; ++i)
+            {
+                float prob = data[i] * scale;
+                data[i] = (prob > thresh) ? prob : 0;
+            }
         }
-    }
+
+        const RegionLayerImpl& layer;
+        const float* srcData;
+        float* dstData;
+        const float* biasData;
+        int rows, cols, hNorm, wNorm;
+    };
 
 #ifdef HAVE_OPENCL
     bool forward_ocl(InputArrayOfArrays inps, OutputArrayOfArrays outs, OutputArrayOfArrays internals)
@@ -244,51 +337,9 @@ public:
             const float *srcData = inpBlob.ptr<float>();
             float *dstData = outBlob.ptr<float>();
 
-            // logistic activation for t0, for each grid cell (X x Y x Anchor-index)
-            for (int i = 0; i < batch_size*rows*cols*anchors; ++i) {
-                int index = cell_size*i;
-                float x = srcData[index + 4];
-                dstData[index + 4] = logistic_activate(x);	// logistic activation
-            }
+            RegionInvoker p(*this, srcData, dstData, biasData, rows, cols, hNorm, wNorm);
+            parallel_for_(Range(0, batch_size*rows*cols*anchors), p, getNumThreads());
 
-            if (useSoftmax) {  // Yolo v2
-                for (int i = 0; i < batch_size*rows*cols*anchors; ++i) {
-                    int index = cell_size*i;
-                    softmax_activate(srcData + index + 5, classes, 1, dstData + index + 5);
-                }
-            }
-            else if (useLogistic) {  // Yolo v3
-                for (int i = 0; i < batch_size*rows*cols*anchors; ++i){
-                    int index = cell_size*i;
-                    const float* input = srcData + index + 5;
-                    float* output = dstData + index + 5;
-                    for (int c = 0; c < classes; ++c)
-                        output[c] = logistic_activate(input[c]);
-                }
-            }
-            for (int b = 0; b < batch_size; ++b)
-                for (int x = 0; x < cols; ++x)
-                    for(int y = 0; y < rows; ++y)
-                        for (int a = 0; a < anchors; ++a) {
-                            // relative start address for image b within the batch data
-                            int index_sample_offset = sample_size*b;
-                            int index = (y*cols + x)*anchors + a;  // index for each grid-cell & anchor
-                            int p_index = index_sample_offset + index * cell_size + 4;
-                            float scale = dstData[p_index];
-                            if (classfix == -1 && scale < .5) scale = 0;  // if(t0 < 0.5) t0 = 0;
-                            int box_index = index_sample_offset + index * cell_size;
-
-                            dstData[box_index + 0] = (x + logistic_activate(srcData[box_index + 0])) / cols;
-                            dstData[box_index + 1] = (y + logistic_activate(srcData[box_index + 1])) / rows;
-                            dstData[box_index + 2] = exp(srcData[box_index + 2]) * biasData[2 * a] / wNorm;
-                            dstData[box_index + 3] = exp(srcData[box_index + 3]) * biasData[2 * a + 1] / hNorm;
-
-                            int class_index = index_sample_offset + index * cell_size + 5;
-                            for (int j = 0; j < classes; ++j) {
-                                float prob = scale*dstData[class_index + j];  // prob = IoU(box, object) = t0 * class-probability
-                                dstData[class_index + j] = (prob > thresh) ? prob : 0;  // if (IoU < threshold) IoU = 0;
-                            }
-                        }
             if (nmsThreshold > 0) {
                 for (int b = 0; b < batch_size; ++b){
                     do_nms_sort(dstData+b*sample_size, rows*cols*anchors, thresh, nmsThreshold);
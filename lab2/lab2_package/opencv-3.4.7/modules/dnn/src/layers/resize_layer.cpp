@@ -11,6 +11,168 @@
 
 namespace cv { namespace dnn {
 
+// Rows of all the output planes are split between threads.
+class ResizeInvoker : public ParallelLoopBody
+{
+public:
+    static void run(const Mat& inp, Mat& out, bool nearest, float scaleHeight, float scaleWidth)
+    {
+        CV_Assert_N(inp.isContinuous(), out.isContinuous(), inp.type() == CV_32F);
+        ResizeInvoker p;
+        p.inp = &inp;
+        p.out = &out;
+        p.nearest = nearest;
+        p.inpHeight = inp.size[2];
+        p.inpWidth = inp.size[3];
+        p.outHeight = out.size[2];
+        p.outWidth = out.size[3];
+        // Integer upsampling factor. Nearest neighbor resize duplicates pixels.
+        p.kx = p.outWidth % p.inpWidth == 0 ? p.outWidth / p.inpWidth : 0;
+
+        p.yofs.resize(p.outHeight);
+        p.yalpha.resize(p.outHeight);
+        for (int y = 0; y < p.outHeight; ++y)
+        {
+            if (nearest)
+            {
+                // The same as cv::resize with INTER_NEAREST.
+                p.yofs[y] = std::min(cvFloor(y * ((double)p.inpHeight / p.outHeight)), p.inpHeight - 1);
+                continue;
+            }
+            float fy = y * scaleHeight;
+            p.yofs[y] = std::min(static_cast<int>(fy), p.inpHeight - 1);
+            p.yalpha[y] = fy - p.yofs[y];
+        }
+        p.xofs0.resize(p.outWidth);
+        p.xofs1.resize(p.outWidth);
+        p.xalpha.resize(p.outWidth);
+        for (int x = 0; x < p.outWidth; ++x)
+        {
+            if (nearest)
+            {
+                p.xofs0[x] = std::min(cvFloor(x * ((double)p.inpWidth / p.outWidth)), p.inpWidth - 1);
+                continue;
+            }
+            float fx = x * scaleWidth;
+            p.xofs0[x] = std::min(static_cast<int>(fx), p.inpWidth - 1);
+            p.xofs1[x] = std::min(p.xofs0[x] + 1, p.inpWidth - 1);
+            p.xalpha[x] = fx - p.xofs0[x];
+        }
+
+        const int numRows = inp.size[0] * inp.size[1] * p.outHeight;
+        parallel_for_(Range(0, numRows), p, getNumThreads());
+    }
+
+    void operator()(const Range& r) const CV_OVERRIDE
+    {
+        const float* inpData = inp->ptr<float>();
+        float* outData = out->ptr<float>();
+        const size_t inpPlaneSize = (size_t)inpHeight * inpWidth;
+        const size_t outPlaneSize = (size_t)outHeight * outWidth;
+        AutoBuffer<float> rowBuf(inpWidth);
+        float* row = rowBuf.data();
+
+        for (int i = r.start; i < r.end; ++i)
+        {
+            const int plane = i / outHeight, y = i % outHeight;
+            const float* inpPlane = inpData + plane * inpPlaneSize;
+            float* dst = outData + plane * outPlaneSize + (size_t)y * outWidth;
+            const float* src = inpPlane + (size_t)yofs[y] * inpWidth;
+
+            if (nearest)
+            {
+                // Rows which are the same as the previous one are copied.
+                if (i > r.start && y > 0 && yofs[y] == yofs[y - 1])
+                    memcpy(dst, dst - outWidth, outWidth * sizeof(float));
+                else
+                    nearestRow(src, dst);
+                continue;
+            }
+
+            // Interpolation between two input rows and then along the row.
+            const float* src1 = inpPlane + (size_t)std::min(yofs[y] + 1, inpHeight - 1) * inpWidth;
+            const float dy = yalpha[y];
+            int x = 0;
+#if CV_SIMD128
+            v_float32x4 v_dy = v_setall_f32(dy);
+            for (; x <= inpWidth - 4; x += 4)
+            {
+                v_float32x4 v0 = v_load(src + x);
+                v_store(row + x, v_muladd(v_load(src1 + x) - v0, v_dy, v0));
+            }
+#endif
+            for (; x < inpWidth; ++x)
+                row[x] = src[x] + dy * (src1[x] - src[x]);
+
+            const int* x0 = &xofs0[0];
+            const int* x1 = &xofs1[0];
+            const float* dx = &xalpha[0];
+            x = 0;
+#if CV_SIMD128
+            for (; x <= outWidth - 4; x += 4)
+            {
+                v_float32x4 v0 = v_lut(row, x0 + x);
+                v_float32x4 v1 = v_lut(row, x1 + x);
+                v_store(dst + x, v_muladd(v1 - v0, v_load(dx + x), v0));
+            }
+#endif
+            for (; x < outWidth; ++x)
+                dst[x] = row[x0[x]] + dx[x] * (row[x1[x]] - row[x0[x]]);
+        }
+    }
+
+private:
+    void nearestRow(const float* src, float* dst) const
+    {
+        int x = 0;
+        if (kx == 1)
+        {
+            memcpy(dst, src, outWidth * sizeof(float));
+            return;
+        }
+        if (kx == 2)
+        {
+#if CV_SIMD128
+            for (; x <= inpWidth - 4; x += 4)
+            {
+                v_float32x4 v = v_load(src + x), a, b;
+                v_zip(v, v, a, b);
+                v_store(dst + 2 * x, a);
+                v_store(dst + 2 * x + 4, b);
+            }
+#endif
+            for (; x < inpWidth; ++x)
+                dst[2 * x] = dst[2 * x + 1] = src[x];
+            return;
+        }
+        if (kx > 2)
+        {
+            for (; x < inpWidth; ++x)
+            {
+                const float v = src[x];
+                for (int j = 0; j < kx; ++j)
+                    dst[x * kx + j] = v;
+            }
+            return;
+        }
+        const int* ofs = &xofs0[0];
+#if CV_SIMD128
+        for (; x <= outWidth - 4; x += 4)
+            v_store(dst + x, v_lut(src, ofs + x));
+#endif
+        for (; x < outWidth; ++x)
+            dst[x] = src[ofs[x]];
+    }
+
+    const Mat* inp;
+    Mat* out;
+    bool nearest;
+    int inpHeight, inpWidth, outHeight, outWidth;
+    int kx;
+    std::vector<int> yofs, xofs0, xofs1;
+    std::vector<float> yalpha, xalpha;
+};
+
 class ResizeLayerImpl : public ResizeLayer
 {
 public:
@@ -105,56 +267,9 @@ public:
         Mat& inp = inputs[0];
         Mat& out = outputs[0];
         if (interpolation == "nearest")
-        {
-            for (size_t n = 0; n < inputs[0].size[0]; ++n)
-            {
-                for (size_t ch = 0; ch < inputs[0].size[1]; ++ch)
-                {
-                    resize(getPlane(inp, n, ch), getPlane(out, n, ch),
-                           Size(outWidth, outHeight), 0, 0, INTER_NEAREST);
-                }
-            }
-        }
+            ResizeInvoker::run(inp, out, true, scaleHeight, scaleWidth);
         else if (interpolation == "bilinear")
-        {
-            const int inpHeight = inp.size[2];
-            const int inpWidth = inp.size[3];
-            const int inpSpatialSize = inpHeight * inpWidth;
-            const int outSpatialSize = outHeight * outWidth;
-            const int numPlanes = inp.size[0] * inp.size[1];
-            CV_Assert_N(inp.isContinuous(), out.isContinuous());
-
-            Mat inpPlanes = inp.reshape(1, numPlanes * inpHeight);
-            Mat outPlanes = out.reshape(1, numPlanes * outHeight);
-            for (int y = 0; y < outHeight; ++y)
-            {
-                float input_y = y * scaleHeight;
-                int y0 = static_cast<int>(input_y);
-                const float* inpData_row0 = inpPlanes.ptr<float>(y0);
-                const float* inpData_row1 = inpPlanes.ptr<float>(std::min(y0 + 1, inpHeight - 1));
-                for (int x = 0; x < outWidth; ++x)
-                {
-                    float input_x = x * scaleWidth;
-                    int x0 = static_cast<int>(input_x);
-                    int x1 = std::min(x0 + 1, inpWidth - 1);
-
-                    float* outData = outPlanes.ptr<float>(y, x);
-                    const float* inpData_row0_c = inpData_row0;
-                    const float* inpData_row1_c = inpData_row1;
-                    for (int c = 0; c < numPlanes; ++c)
-                    {
-                        *outData = inpData_row0_c[x0] +
-                            (input_y - y0) * (inpData_row1_c[x0] - inpData_row0_c[x0]) +
-                            (input_x - x0) * (inpData_row0_c[x1] - inpData_row0_c[x0] +
-                            (input_y - y0) * (inpData_row1_c[x1] - inpData_row0_c[x1] - inpData_row1_c[x0] + inpData_row0_c[x0]));
-
-                        inpData_row0_c += inpSpatialSize;
-                        inpData_row1_c += inpSpatialSize;
-                        outData += outSpatialSize;
-                    }
-                }
-            }
-        }
+            ResizeInvoker::run(inp, out, false, scaleHeight, scaleWidth);
         else
             CV_Error(Error::StsNotImplemented, "Unknown interpolation: " + interpolation);
     }
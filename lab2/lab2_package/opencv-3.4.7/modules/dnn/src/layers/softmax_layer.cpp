@@ -44,6 +44,7 @@
 #include "layers_common.hpp"
 #include "../op_halide.hpp"
 #include "../op_inf_engine.hpp"
+#include "vec_math.hpp"
 #include <algorithm>
 #include <stdlib.h>
 using std::max;
@@ -218,70 +219,136 @@ public:
         size_t outerStep = src.total(axis);
         size_t cnStep = src.total(axis + 1);
 
-        //compute max along axis
-        for (size_t outerDim = 0; outerDim < outerSize; outerDim++)
+        if (innerSize == 1)
         {
-            size_t srcOffset = outerDim * outerStep;
-            size_t bufOffset = outerDim * cnStep;
-
-            memcpy(bufPtr + bufOffset, srcPtr + srcOffset, innerSize * sizeof(float));
-
-            for (size_t cnDim = 1; cnDim < channels; cnDim++)
+            // Softmax along contiguous rows, i.e. for the last axis.
+            for (size_t outerDim = 0; outerDim < outerSize; outerDim++)
             {
-                for (size_t i = 0; i < innerSize; i++)
-                    bufPtr[bufOffset + i] = std::max(bufPtr[bufOffset + i], srcPtr[srcOffset + cnDim * cnStep + i]);
+                const float* srcRow = srcPtr + outerDim * channels;
+                float* dstRow = dstPtr + outerDim * channels;
+                float maxVal = srcRow[0];
+                for (size_t cnDim = 1; cnDim < channels; cnDim++)
+                    maxVal = std::max(maxVal, srcRow[cnDim]);
+                float sum = expSubtract(srcRow, maxVal, dstRow, (int)channels);
+                scale(dstRow, 1.f / sum, (int)channels, logSoftMax);
             }
+            return;
         }
 
-        //subtract max
         for (size_t outerDim = 0; outerDim < outerSize; outerDim++)
         {
             size_t srcOffset = outerDim * outerStep;
-            size_t bufOffset = outerDim * cnStep;
+            float* buf = bufPtr + outerDim * cnStep;
+
+            //compute max along axis
+            memcpy(buf, srcPtr + srcOffset, innerSize * sizeof(float));
+            for (size_t cnDim = 1; cnDim < channels; cnDim++)
+                maxAccumulate(buf, srcPtr + srcOffset + cnDim * cnStep, (int)innerSize);
 
+            //subtract max and compute exponent
             for (size_t cnDim = 0; cnDim < channels; cnDim++)
             {
-                const int offset = srcOffset + cnDim * cnStep;
-                for (size_t i = 0; i < innerSize; i++)
-                    dstPtr[offset + i] = srcPtr[offset + i] - bufPtr[bufOffset + i];
+                const size_t offset = srcOffset + cnDim * cnStep;
+                expSubtract(srcPtr + offset, buf, dstPtr + offset, (int)innerSize);
             }
+
+            //sum exp along axis
+            memcpy(buf, dstPtr + srcOffset, innerSize * sizeof(float));
+            for (size_t cnDim = 1; cnDim < channels; cnDim++)
+                sumAccumulate(buf, dstPtr + srcOffset + cnDim * cnStep, (int)innerSize);
+
+            //divide by computed sum
+            for (size_t i = 0; i < innerSize; i++)
+                buf[i] = 1.f / buf[i];
+            for (size_t cnDim = 0; cnDim < channels; cnDim++)
+                scale(dstPtr + srcOffset + cnDim * cnStep, buf, (int)innerSize, logSoftMax);
         }
+    }
 
-        cv::exp(dst, dst);
+    static void maxAccumulate(float* dst, const float* src, int len)
+    {
+        int i = 0;
+#if CV_SIMD128
+        for (; i <= len - 4; i += 4)
+            v_store(dst + i, v_max(v_load(dst + i), v_load(src + i)));
+#endif
+        for (; i < len; i++)
+            dst[i] = std::max(dst[i], src[i]);
+    }
 
-        for (size_t outerDim = 0; outerDim < outerSize; outerDim++)
+    static void sumAccumulate(float* dst, const float* src, int len)
+    {
+        int i = 0;
+#if CV_SIMD128
+        for (; i <= len - 4; i += 4)
+            v_store(dst + i, v_load(dst + i) + v_load(src + i));
+#endif
+        for (; i < len; i++)
+            dst[i] += src[i];
+    }
+
+    // dst = exp(src - maxVal), returns sum of dst.
+    static float expSubtract(const float* src, float maxVal, float* dst, int len)
+    {
+        float sum = 0.f;
+        int i = 0;
+#if CV_SIMD128
+        v_float32x4 v_maxVal = v_setall_f32(maxVal), v_sum = v_setzero_f32();
+        for (; i <= len - 4; i += 4)
         {
-            size_t srcOffset = outerDim * outerStep;
-            size_t bufOffset = outerDim * cnStep;
+            v_float32x4 e = v_exp_approx(v_load(src + i) - v_maxVal);
+            v_sum += e;
+            v_store(dst + i, e);
+        }
+        sum = v_reduce_sum(v_sum);
+#endif
+        for (; i < len; i++)
+        {
+            dst[i] = exp(src[i] - maxVal);
+            sum += dst[i];
+        }
+        return sum;
+    }
 
-            //sum exp along axis
-            for (size_t i = 0; i < innerSize; i++)
-                bufPtr[bufOffset + i] = 0.f;
+    // dst = exp(src - maxVals)
+    static void expSubtract(const float* src, const float* maxVals, float* dst, int len)
+    {
+        int i = 0;
+#if CV_SIMD128
+        for (; i <= len - 4; i += 4)
+            v_store(dst + i, v_exp_approx(v_load(src + i) - v_load(maxVals + i)));
+#endif
+        for (; i < len; i++)
+            dst[i] = exp(src[i] - maxVals[i]);
+    }
 
-            for (size_t cnDim = 0; cnDim < channels; cnDim++)
-            {
-                const int offset = srcOffset + cnDim * cnStep;
-                for (size_t i = 0; i < innerSize; i++)
-                    bufPtr[bufOffset + i] += dstPtr[offset + i];
-            }
+    static void scale(float* data, float factor, int len, bool logarithm)
+    {
+        int i = 0;
+#if CV_SIMD128
+        v_float32x4 v_factor = v_setall_f32(factor);
+        for (; i <= len - 4; i += 4)
+        {
+            v_float32x4 v = v_load(data + i) * v_factor;
+            v_store(data + i, logarithm ? v_log_approx(v) : v);
+        }
+#endif
+        for (; i < len; i++)
+            data[i] = logarithm ? log(data[i] * factor) : data[i] * factor;
+    }
 
-            //divide by computed sum
-            for (size_t cnDim = 0; cnDim < channels; cnDim++)
-            {
-                const int offset = srcOffset + cnDim * cnStep;
-                for (size_t i = 0; i < innerSize; i++)
-                    dstPtr[offset + i] /= bufPtr[bufOffset + i];
-            }
-            if (logSoftMax)
-            {
-                for (size_t cnDim = 0; cnDim < channels; cnDim++)
-                {
-                    const int offset = srcOffset + cnDim * cnStep;
-                    for (size_t i = 0; i < innerSize; i++)
-                        dstPtr[offset + i] = log(dstPtr[offset + i]);
-                }
-            }
+    static void scale(float* data, const float* factors, int len, bool logarithm)
+    {
+        int i = 0;
+#if CV_SIMD128
+        for (; i <= len - 4; i += 4)
+        {
+            v_float32x4 v = v_load(data + i) * v_load(factors + i);
+            v_store(data + i, logarithm ? v_log_approx(v) : v);
         }
+#endif
+        for (; i < len; i++)
+            data[i] = logarithm ? log(data[i] * factors[i]) : data[i] * factors[i];
     }
 
     virtual Ptr<BackendNode> initHalide(const std::vector<Ptr<BackendWrapper> > &inputs) CV_OVERRIDE
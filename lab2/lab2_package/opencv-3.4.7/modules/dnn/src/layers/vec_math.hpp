@@ -0,0 +1,143 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef __OPENCV_DNN_LAYERS_VEC_MATH_HPP__
+#define __OPENCV_DNN_LAYERS_VEC_MATH_HPP__
+
+#include <opencv2/core/hal/intrin.hpp>
+#include <limits>
+
+namespace cv { namespace dnn {
+
+#if CV_SIMD128
+
+// Exponent of float32 values by polynomial approximation (Cephes expf).
+// Inputs are clamped to [-87, 88] so the result is always finite.
+static inline v_float32x4 v_exp_approx(const v_float32x4& v)
+{
+    const v_float32x4 log2e = v_setall_f32(1.44269504088896341f);
+    const v_float32x4 c1 = v_setall_f32(0.693359375f);
+    const v_float32x4 c2 = v_setall_f32(-2.12194440e-4f);
+    const v_float32x4 one = v_setall_f32(1.f);
+
+    v_float32x4 x = v_min(v_max(v, v_setall_f32(-87.f)), v_setall_f32(88.f));
+    // exp(x) = 2^n * exp(r), r = x - n * ln(2)
+    v_int32x4 n = v_floor(v_muladd(x, log2e, v_setall_f32(0.5f)));
+    v_float32x4 fn = v_cvt_f32(n);
+    x = x - fn * c1;
+    x = x - fn * c2;
+
+    v_float32x4 y = v_setall_f32(1.9875691500e-4f);
+    y = v_muladd(y, x, v_setall_f32(1.3981999507e-3f));
+    y = v_muladd(y, x, v_setall_f32(8.3334519073e-3f));
+    y = v_muladd(y, x, v_setall_f32(4.1665795894e-2f));
+    y = v_muladd(y, x, v_setall_f32(1.6666665459e-1f));
+    y = v_muladd(y, x, v_setall_f32(5.0000001201e-1f));
+    y = v_muladd(y, x * x, x + one);
+
+    v_float32x4 pow2n = v_reinterpret_as_f32(v_shl<23>(n + v_setall_s32(127)));
+    return y * pow2n;
+}
+
+// Natural logarithm by polynomial approximation (Cephes logf).
+// Returns -inf for zeros and NaN for negative values. Denormals are flushed
+// to the least normal value.
+static inline v_float32x4 v_log_approx(const v_float32x4& v)
+{
+    const v_float32x4 one = v_setall_f32(1.f);
+    v_float32x4 x = v_max(v, v_setall_f32(FLT_MIN));
+
+    // x = m * 2^e, m in [0.5, 1)
+    v_int32x4 bits = v_reinterpret_as_s32(x);
+    v_float32x4 e = v_cvt_f32((v_shr<23>(bits) & v_setall_s32(0xff)) - v_setall_s32(126));
+    v_float32x4 m = v_reinterpret_as_f32((bits & v_setall_s32(0x807fffff)) | v_setall_s32(0x3f000000));
+    // m in [sqrt(0.5), sqrt(2))
+    v_float32x4 small = m < v_setall_f32(0.707106781186547524f);
+    e = e - (one & small);
+    x = v_select(small, m + m, m) - one;
+
+    v_float32x4 z = x * x;
+    v_float32x4 y = v_setall_f32(7.0376836292e-2f);
+    y = v_muladd(y, x, v_setall_f32(-1.1514610310e-1f));
+    y = v_muladd(y, x, v_setall_f32(1.1676998740e-1f));
+    y = v_muladd(y, x, v_setall_f32(-1.2420140846e-1f));
+    y = v_muladd(y, x, v_setall_f32(1.4249322787e-1f));
+    y = v_muladd(y, x, v_setall_f32(-1.6668057665e-1f));
+    y = v_muladd(y, x, v_setall_f32(2.0000714765e-1f));
+    y = v_muladd(y, x, v_setall_f32(-2.4999993993e-1f));
+    y = v_muladd(y, x, v_setall_f32(3.3333331174e-1f));
+    y = y * x * z;
+    y = v_muladd(e, v_setall_f32(-2.12194440e-4f), y);
+    y = v_muladd(z, v_setall_f32(-0.5f), y);
+    y = v_muladd(e, v_setall_f32(0.693359375f), x + y);
+
+    const v_float32x4 zero = v_setzero_f32();
+    y = v_select(v == v_setall_f32(std::numeric_limits<float>::infinity()), v, y);
+    y = v_select(v == zero, v_setall_f32(-std::numeric_limits<float>::infinity()), y);
+    return v_select(v < zero, v_setall_f32(std::numeric_limits<float>::quiet_NaN()), y);
+}
+
+static inline v_float32x4 v_sigmoid_approx(const v_float32x4& v)
+{
+    const v_float32x4 one = v_setall_f32(1.f);
+    return one / (one + v_exp_approx(v_setzero_f32() - v));
+}
+
+// Hyperbolic tangent. Polynomial approximation of Cephes tanhf is used for
+// small inputs, 1 - 2 / (exp(2x) + 1) for the rest.
+static inline v_float32x4 v_tanh_approx(const v_float32x4& v)
+{
+    const v_float32x4 one = v_setall_f32(1.f);
+    const v_float32x4 signMask = v_setall_f32(-0.f);
+    v_float32x4 ax = v_abs(v);
+
+    v_float32x4 z = v * v;
+    v_float32x4 p = v_setall_f32(-5.70498872745e-3f);
+    p = v_muladd(p, z, v_setall_f32(2.06390887954e-2f));
+    p = v_muladd(p, z, v_setall_f32(-5.37397155531e-2f));
+    p = v_muladd(p, z, v_setall_f32(1.33314422036e-1f));
+    p = v_muladd(p, z, v_setall_f32(-3.33332819422e-1f));
+    v_float32x4 small = v_muladd(p * z, v, v);
+
+    v_float32x4 large = one - v_setall_f32(2.f) / (v_exp_approx(ax + ax) + one);
+    large = large | (v & signMask);
+    return v_select(ax < v_setall_f32(0.625f), small, large);
+}
+
+// Error function. Taylor series is used for |x| < 0.5, approximation 7.1.26
+// of Abramowitz and Stegun (absolute error is less than 1.5e-7) for the rest.
+// The error in float is within 4 ULP for |x| < 0.5 and within 8 ULP (absolute
+// error below 4e-7) for the rest, mostly from rounding of the polynomials.
+static inline v_float32x4 v_erf_approx(const v_float32x4& v)
+{
+    const v_float32x4 one = v_setall_f32(1.f);
+    const v_float32x4 signMask = v_setall_f32(-0.f);
+    v_float32x4 ax = v_abs(v);
+
+    v_float32x4 z = v * v;
+    v_float32x4 s = v_setall_f32(1.f / 9360);
+    s = v_muladd(s, z, v_setall_f32(-1.f / 1320));
+    s = v_muladd(s, z, v_setall_f32(1.f / 216));
+    s = v_muladd(s, z, v_setall_f32(-1.f / 42));
+    s = v_muladd(s, z, v_setall_f32(1.f / 10));
+    s = v_muladd(s, z, v_setall_f32(-1.f / 3));
+    s = v_muladd(s, z, one);
+    v_float32x4 small = s * v * v_setall_f32(1.12837916709551257f);  // 2 / sqrt(pi)
+
+    v_float32x4 t = one / v_muladd(ax, v_setall_f32(0.3275911f), one);
+    v_float32x4 p = v_setall_f32(1.061405429f);
+    p = v_muladd(p, t, v_setall_f32(-1.453152027f));
+    p = v_muladd(p, t, v_setall_f32(1.421413741f));
+    p = v_muladd(p, t, v_setall_f32(-0.284496736f));
+    p = v_muladd(p, t, v_setall_f32(0.254829592f));
+    v_float32x4 large = one - p * t * v_exp_approx(v_setzero_f32() - z);
+    large = large | (v & signMask);
+    return v_select(ax < v_setall_f32(0.5f), small, large);
+}
+
+#endif  // CV_SIMD128
+
+}}  // namespace cv::dnn
+
+#endif  // __OPENCV_DNN_LAYERS_VEC_MATH_HPP__
@@ -0,0 +1,338 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "../precomp.hpp"
+#include <opencv2/dnn/shape_utils.hpp>
+#include <opencv2/dnn/all_layers.hpp>
+
+namespace cv
+{
+namespace dnn
+{
+
+class YoloDetectionOutputLayerImpl CV_FINAL : public YoloDetectionOutputLayer
+{
+public:
+    enum DecodeType
+    {
+        DECODE_DARKNET,
+        DECODE_YOLOV5,
+        DECODE_NONE
+    };
+
+    YoloDetectionOutputLayerImpl(const LayerParams& params)
+    {
+        setParamsFrom(params);
+
+        String decodeName = params.get<String>("decode", "darknet").toLowerCase();
+        if (decodeName == "darknet")
+            decode = DECODE_DARKNET;
+        else if (decodeName == "yolov5")
+            decode = DECODE_YOLOV5;
+        else if (decodeName == "none")
+            decode = DECODE_NONE;
+        else
+            CV_Error(Error::StsBadArg, "Unknown YOLO boxes decoding type \"" + decodeName + "\"");
+
+        useSigmoid = params.get<bool>("sigmoid", decode != DECODE_NONE);
+        numClasses = params.get<int>("classes", 0);
+        confThreshold = params.get<float>("confidence_threshold", 0.25f);
+        nmsThreshold = params.get<float>("nms_threshold", 0.45f);
+        keepTopK = params.get<int>("keep_top_k", 300);
+        topK = params.get<int>("top_k", 0);
+        classAgnostic = params.get<bool>("class_agnostic", false);
+
+        if (params.has("anchors"))
+        {
+            const DictValue& values = params.get("anchors");
+            for (int i = 0; i < values.size(); ++i)
+                anchors.push_back(values.get<float>(i));
+        }
+        if (params.has("strides"))
+        {
+            const DictValue& values = params.get("strides");
+            for (int i = 0; i < values.size(); ++i)
+                strides.push_back(values.get<float>(i));
+        }
+
+        CV_Assert(confThreshold >= 0.f && confThreshold < 1.f);
+        CV_Assert(nmsThreshold >= 0.f);
+        CV_Assert(keepTopK > 0);
+        CV_Assert(topK >= 0);
+        CV_Assert(numClasses >= 0);
+        if (decode != DECODE_NONE)
+        {
+            CV_Assert(!strides.empty());
+            CV_Assert(!anchors.empty() && anchors.size() % (2 * strides.size()) == 0);
+            numAnchors = (int)(anchors.size() / (2 * strides.size()));
+        }
+        else
+            numAnchors = 1;
+
+        // Objectness is an upper bound of the confidence so anchors are
+        // rejected by the raw value without computing an activation.
+        if (!useSigmoid)
+            objThreshold = confThreshold;
+        else if (confThreshold > 0.f)
+            objThreshold = std::log(confThreshold / (1.f - confThreshold));
+        else
+            objThreshold = -FLT_MAX;
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs,
+                         const int requiredOutputs,
+                         std::vector<MatShape> &outputs,
+                         std::vector<MatShape> &internals) const CV_OVERRIDE
+    {
+        CV_Assert(!inputs.empty());
+        const int num = inputs[0][0];
+        if (decode == DECODE_NONE)
+        {
+            // [N x numBoxes x (5 + classes)]
+            CV_Assert(inputs.size() == 1);
+            CV_Assert(inputs[0].size() == 3);
+            CV_Assert(numClasses == 0 || inputs[0][2] == 5 + numClasses);
+            CV_Assert(inputs[0][2] > 5);
+        }
+        else
+        {
+            // Either [N x anchors*(5 + classes) x H x W] or [N x anchors x H x W x (5 + classes)]
+            CV_Assert(inputs.size() == strides.size());
+            int cellSize = 0;
+            for (size_t i = 0; i < inputs.size(); ++i)
+            {
+                const MatShape& inpShape = inputs[i];
+                CV_Assert(inpShape[0] == num);
+                int size;
+                if (inpShape.size() == 4)
+                {
+                    CV_Assert(inpShape[1] % numAnchors == 0);
+                    size = inpShape[1] / numAnchors;
+                }
+                else
+                {
+                    CV_Assert(inpShape.size() == 5);
+                    CV_Assert(inpShape[1] == numAnchors);
+                    size = inpShape[4];
+                }
+                CV_Assert(size > 5);
+                CV_Assert(cellSize == 0 || cellSize == size);
+                cellSize = size;
+            }
+            CV_Assert(numClasses == 0 || cellSize == 5 + numClasses);
+        }
+
+        // The number of detections is unknown before NMS so output is allocated
+        // for [keep_top_k] detections per image. Each row is
+        // [image_id, label, confidence, xmin, ymin, xmax, ymax].
+        outputs.resize(1, shape(1, 1, keepTopK * num, 7));
+        return false;
+    }
+
+    static inline float sigmoid(float x) { return 1.f / (1.f + std::exp(-x)); }
+
+    // Decodes a single anchor. Attributes of the anchor are placed with a step
+    // [step] starting from [p]: tx, ty, tw, th, objectness, class scores.
+    void decodeAnchor(const float* p, size_t step, int classes,
+                      float x, float y, float stride, float anchorW, float anchorH,
+                      float normW, float normH,
+                      std::vector<Rect2d>& boxes, std::vector<float>& scores,
+                      std::vector<int>& classIds) const
+    {
+        float obj = p[4 * step];
+        if (obj < objThreshold)
+            return;
+
+        const float* cls = p + 5 * step;
+        int classId = 0;
+        float classScore = cls[0];
+        for (int c = 1; c < classes; ++c)
+        {
+            float score = cls[c * step];
+            if (score > classScore)
+            {
+                classScore = score;
+                classId = c;
+            }
+        }
+        float conf = useSigmoid ? sigmoid(obj) * sigmoid(classScore) : obj * classScore;
+        if (conf <= confThreshold)
+            return;
+
+        float cx, cy, w, h;
+        if (decode == DECODE_DARKNET)
+        {
+            float tx = useSigmoid ? sigmoid(p[0]) : p[0];
+            float ty = useSigmoid ? sigmoid(p[step]) : p[step];
+            cx = (x + tx) * stride;
+            cy = (y + ty) * stride;
+            w = std::exp(p[2 * step]) * anchorW;
+            h = std::exp(p[3 * step]) * anchorH;
+        }
+        else if (decode == DECODE_YOLOV5)
+        {
+            float tx = useSigmoid ? sigmoid(p[0]) : p[0];
+            float ty = useSigmoid ? sigmoid(p[step]) : p[step];
+            float tw = 2.f * (useSigmoid ? sigmoid(p[2 * step]) : p[2 * step]);
+            float th = 2.f * (useSigmoid ? sigmoid(p[3 * step]) : p[3 * step]);
+            cx = (x + 2.f * tx - 0.5f) * stride;
+            cy = (y + 2.f * ty - 0.5f) * stride;
+            w = tw * tw * anchorW;
+            h = th * th * anchorH;
+        }
+        else
+        {
+            cx = p[0];
+            cy = p[step];
+            w = p[2 * step];
+            h = p[3 * step];
+        }
+        boxes.push_back(Rect2d((cx - 0.5f * w) / normW, (cy - 0.5f * h) / normH, w / normW, h / normH));
+        scores.push_back(conf);
+        classIds.push_back(classId);
+    }
+
+    void decodeHead(const Mat& inp, int b, int headId, std::vector<Rect2d>& boxes,
+                    std::vector<float>& scores, std::vector<int>& classIds) const
+    {
+        if (decode == DECODE_NONE)
+        {
+            const int numBoxes = inp.size[1], cellSize = inp.size[2];
+            const float* data = inp.ptr<float>(b);
+            for (int i = 0; i < numBoxes; ++i)
+                decodeAnchor(data + i * cellSize, 1, cellSize - 5, 0, 0, 1, 0, 0, 1, 1,
+                             boxes, scores, classIds);
+            return;
+        }
+
+        const bool planar = inp.dims == 4;
+        const int rows = inp.size[2], cols = inp.size[3];
+        const int cellSize = planar ? inp.size[1] / numAnchors : inp.size[4];
+        const float stride = strides[headId];
+        // Boxes are normalized by the network input size.
+        const float normW = cols * stride, normH = rows * stride;
+        for (int a = 0; a < numAnchors; ++a)
+        {
+            const float anchorW = anchors[2 * (headId * numAnchors + a)];
+            const float anchorH = anchors[2 * (headId * numAnchors + a) + 1];
+            const float* data = planar ? inp.ptr<float>(b, a * cellSize) : inp.ptr<float>(b, a);
+            for (int y = 0; y < rows; ++y)
+            {
+                for (int x = 0; x < cols; ++x)
+                {
+                    const int idx = y * cols + x;
+                    if (planar)
+                        decodeAnchor(data + idx, rows * cols, cellSize - 5, x, y, stride,
+                                     anchorW, anchorH, normW, normH, boxes, scores, classIds);
+                    else
+                        decodeAnchor(data + idx * cellSize, 1, cellSize - 5, x, y, stride,
+                                     anchorW, anchorH, normW, normH, boxes, scores, classIds);
+                }
+            }
+        }
+    }
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        CV_TRACE_ARG_VALUE(name, "name", name.c_str());
+
+        if (inputs_arr.depth() == CV_16S)
+        {
+            forward_fallback(inputs_arr, outputs_arr, internals_arr);
+            return;
+        }
+
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+
+        const int num = inputs[0].size[0];
+        outputs[0].setTo(0);
+        float* dstData = outputs[0].ptr<float>();
+
+        std::vector<Rect2d> boxes;
+        std::vector<float> scores;
+        std::vector<int> classIds, indices;
+        size_t count = 0;
+        for (int b = 0; b < num; ++b)
+        {
+            boxes.clear();
+            scores.clear();
+            classIds.clear();
+            for (size_t i = 0; i < inputs.size(); ++i)
+            {
+                CV_Assert(inputs[i].isContinuous());
+                decodeHead(inputs[i], b, (int)i, boxes, scores, classIds);
+            }
+
+            if (nmsThreshold > 0)
+            {
+                // Picked indices are sorted by scores so the best keep_top_k of them are kept.
+                if (classAgnostic)
+                    NMSBoxes(boxes, scores, confThreshold, nmsThreshold, indices, 1.f, topK);
+                else
+                    NMSBoxesBatched(boxes, scores, classIds, confThreshold, nmsThreshold, indices, 1.f, topK);
+                if (indices.size() > (size_t)keepTopK)
+                    indices.resize(keepTopK);
+            }
+            else
+            {
+                std::vector<std::pair<float, int> > order(scores.size());
+                for (size_t i = 0; i < scores.size(); ++i)
+                    order[i] = std::make_pair(-scores[i], (int)i);
+                std::stable_sort(order.begin(), order.end());
+                indices.resize(std::min(order.size(), (size_t)keepTopK));
+                for (size_t i = 0; i < indices.size(); ++i)
+                    indices[i] = order[i].second;
+            }
+
+            for (size_t i = 0; i < indices.size(); ++i, ++count)
+            {
+                const int idx = indices[i];
+                const Rect2d& box = boxes[idx];
+                float* row = dstData + count * 7;
+                row[0] = b;
+                row[1] = classIds[idx];
+                row[2] = scores[idx];
+                row[3] = box.x;
+                row[4] = box.y;
+                row[5] = box.x + box.width;
+                row[6] = box.y + box.height;
+            }
+        }
+    }
+
+    virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
+                           const std::vector<MatShape> &outputs) const CV_OVERRIDE
+    {
+        CV_UNUSED(outputs); // suppress unused variable warning
+
+        // Most of anchors are rejected by objectness so count only a few
+        // operations per anchor.
+        int64 flops = 0;
+        for (size_t i = 0; i < inputs.size(); ++i)
+        {
+            const MatShape& inpShape = inputs[i];
+            int cellSize = inpShape.size() == 4 ? inpShape[1] / numAnchors : inpShape.back();
+            flops += 10 * total(inpShape) / cellSize;
+        }
+        return flops;
+    }
+
+private:
+    int decode;
+    bool useSigmoid, classAgnostic;
+    int numClasses, numAnchors, keepTopK, topK;
+    float confThreshold, nmsThreshold, objThreshold;
+    std::vector<float> anchors, strides;
+};
+
+Ptr<YoloDetectionOutputLayer> YoloDetectionOutputLayer::create(const LayerParams& params)
+{
+    return Ptr<YoloDetectionOutputLayer>(new YoloDetectionOutputLayerImpl(params));
+}
+
+}  // namespace dnn
+}  // namespace cv
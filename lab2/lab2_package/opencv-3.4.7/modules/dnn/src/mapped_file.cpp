@@ -0,0 +1,134 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "mapped_file.hpp"
+
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define HAVE_DNN_MMAP 1
+#endif
+
+namespace cv { namespace dnn {
+CV__DNN_EXPERIMENTAL_NS_BEGIN
+
+MappedFile::MappedFile(const String& path) : data_(0), size_(0), mapped_(false)
+{
+#ifdef HAVE_DNN_MMAP
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        CV_Error(Error::StsError, "Failed to open file " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        CV_Error(Error::StsError, "Failed to get size of file " + path);
+    }
+    size_ = (size_t)st.st_size;
+    if (size_ > 0)
+    {
+        void* ptr = mmap(NULL, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (ptr != MAP_FAILED)
+        {
+            data_ = (uchar*)ptr;
+            mapped_ = true;
+        }
+    }
+    close(fd);
+    if (mapped_ || size_ == 0)
+        return;
+#endif
+    std::ifstream ifs(path.c_str(), std::ios::in | std::ios::binary);
+    if (!ifs.is_open())
+        CV_Error(Error::StsError, "Failed to open file " + path);
+    ifs.seekg(0, std::ios::end);
+    size_ = (size_t)ifs.tellg();
+    ifs.seekg(0, std::ios::beg);
+    data_ = (uchar*)fastMalloc(std::max(size_, (size_t)1));
+    ifs.read((char*)data_, size_);
+    if (!ifs)
+    {
+        fastFree(data_);
+        CV_Error(Error::StsError, "Failed to read file " + path);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef HAVE_DNN_MMAP
+    if (mapped_)
+    {
+        munmap(data_, size_);
+        return;
+    }
+#endif
+    fastFree(data_);
+}
+
+// Reference counted Mat data which holds a reference to the mapped file.
+class MappedFileAllocator : public MatAllocator
+{
+public:
+    UMatData* allocate(const Ptr<MappedFile>& file, uchar* data, size_t size) const
+    {
+        UMatData* u = new UMatData(this);
+        u->data = u->origdata = data;
+        u->size = size;
+        u->userdata = new Ptr<MappedFile>(file);
+        return u;
+    }
+
+    UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                       int flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+
+    bool allocate(UMatData* u, int accessFlags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(u, accessFlags, usageFlags);
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+        CV_Assert(u->urefcount >= 0);
+        CV_Assert(u->refcount >= 0);
+        if (u->refcount == 0)
+        {
+            delete (Ptr<MappedFile>*)u->userdata;
+            delete u;
+        }
+    }
+};
+
+static MappedFileAllocator& getMappedFileAllocator()
+{
+    // Not destroyed at exit because of Mats which could be released after it.
+    static MappedFileAllocator* allocator = new MappedFileAllocator();
+    return *allocator;
+}
+
+Mat MappedFile::wrap(const Ptr<MappedFile>& file, size_t offset, int dims, const int* sizes, int type)
+{
+    CV_Assert(file);
+    Mat m(dims, sizes, type, file->data() + offset);
+    const size_t size = m.total() * m.elemSize();
+    CV_Assert(offset <= file->size() && size <= file->size() - offset);
+
+    MappedFileAllocator& allocator = getMappedFileAllocator();
+    m.u = allocator.allocate(file, m.data, size);
+    m.addref();
+    m.allocator = &allocator;
+    return m;
+}
+
+CV__DNN_EXPERIMENTAL_NS_END
+}}  // namespace cv::dnn
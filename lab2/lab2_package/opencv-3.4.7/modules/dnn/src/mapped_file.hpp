@@ -0,0 +1,44 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef __OPENCV_DNN_MAPPED_FILE_HPP__
+#define __OPENCV_DNN_MAPPED_FILE_HPP__
+
+#include "opencv2/core.hpp"
+
+namespace cv { namespace dnn {
+CV__DNN_EXPERIMENTAL_NS_BEGIN
+
+// Read-only content of a file mapped into memory. Pages are mapped privately
+// (copy-on-write) so the data can be wrapped by Mat headers without copying and
+// are shared between processes which map the same file. If memory mapping is
+// not available the file is read into an aligned buffer.
+class MappedFile
+{
+public:
+    explicit MappedFile(const String& path);
+    ~MappedFile();
+
+    uchar* data() const { return data_; }
+    size_t size() const { return size_; }
+    // Returns false if the content was read into a buffer.
+    bool isMapped() const { return mapped_; }
+
+    // Creates a continuous Mat over the file content starting from [offset].
+    // The Mat (and every its copy) keeps the file mapped.
+    static Mat wrap(const Ptr<MappedFile>& file, size_t offset, int dims, const int* sizes, int type);
+
+private:
+    uchar* data_;
+    size_t size_;
+    bool mapped_;
+
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+};
+
+CV__DNN_EXPERIMENTAL_NS_END
+}}  // namespace cv::dnn
+
+#endif  // __OPENCV_DNN_MAPPED_FILE_HPP__
@@ -9,6 +9,9 @@
 #include "nms.inl.hpp"
 
 #include <opencv2/imgproc.hpp>
+#include <opencv2/core/hal/intrin.hpp>
+
+#include <queue>
 
 namespace cv
 {
@@ -16,28 +19,444 @@ namespace dnn
 {
 CV__DNN_EXPERIMENTAL_NS_BEGIN
 
+namespace
+{
+
+// Axis-aligned boxes as separate arrays of corners and areas.
+struct BoxesSoA
+{
+    std::vector<float> x1, y1, x2, y2, area;
+
+    size_t size() const { return x1.size(); }
+
+    template <typename T>
+    void push_back(const Rect_<T>& r)
+    {
+        x1.push_back((float)r.x);
+        y1.push_back((float)r.y);
+        x2.push_back((float)(r.x + r.width));
+        y2.push_back((float)(r.y + r.height));
+        area.push_back((float)r.area());
+    }
+};
+
+// Uniform grid over the area of a set of boxes. The cell size follows the median
+// box size so a typical box touches just a few cells. Boxes which cover too many
+// cells are reported as large ones and should be handled separately.
+class BoxesGrid
+{
+public:
+    enum { MAX_CELLS_PER_BOX = 16, MIN_BOXES = 64, MAX_CELLS = 1 << 16 };
+
+    BoxesGrid(const BoxesSoA& boxes)
+        : cols(1), rows(1), ox(0.f), oy(0.f), invCellW(0.f), invCellH(0.f)
+    {
+        const size_t n = boxes.size();
+        if (n < MIN_BOXES)
+            return;  // A single cell is enough.
+
+        float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+        std::vector<float> widths(n), heights(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            minX = std::min(minX, boxes.x1[i]);
+            minY = std::min(minY, boxes.y1[i]);
+            maxX = std::max(maxX, boxes.x2[i]);
+            maxY = std::max(maxY, boxes.y2[i]);
+            widths[i] = boxes.x2[i] - boxes.x1[i];
+            heights[i] = boxes.y2[i] - boxes.y1[i];
+        }
+        if (!(minX < maxX && minY < maxY))
+            return;
+
+        // A few huge boxes don't inflate the cells as they would with the mean size.
+        std::nth_element(widths.begin(), widths.begin() + n / 2, widths.end());
+        std::nth_element(heights.begin(), heights.begin() + n / 2, heights.end());
+        double cellW = std::max((double)widths[n / 2], 1e-3 * (maxX - minX));
+        double cellH = std::max((double)heights[n / 2], 1e-3 * (maxY - minY));
+        const double maxCells = (double)std::min(n / 2, (size_t)MAX_CELLS);
+        double ncells = std::ceil((maxX - minX) / cellW) * std::ceil((maxY - minY) / cellH);
+        if (ncells > maxCells)
+        {
+            double scale = std::sqrt(ncells / maxCells);
+            cellW *= scale;
+            cellH *= scale;
+        }
+        cols = std::max((int)std::ceil((maxX - minX) / cellW), 1);
+        rows = std::max((int)std::ceil((maxY - minY) / cellH), 1);
+        ox = minX;
+        oy = minY;
+        invCellW = (float)(1.0 / cellW);
+        invCellH = (float)(1.0 / cellH);
+    }
+
+    int total() const { return cols * rows; }
+
+    // Computes a range of cells touched by the box. Returns false for large boxes.
+    bool getRange(float x1, float y1, float x2, float y2, Rect& r) const
+    {
+        int c0 = cvFloor((x1 - ox) * invCellW), c1 = cvFloor((x2 - ox) * invCellW);
+        int r0 = cvFloor((y1 - oy) * invCellH), r1 = cvFloor((y2 - oy) * invCellH);
+        c0 = std::min(std::max(c0, 0), cols - 1);
+        c1 = std::min(std::max(c1, 0), cols - 1);
+        r0 = std::min(std::max(r0, 0), rows - 1);
+        r1 = std::min(std::max(r1, 0), rows - 1);
+        r = Rect(c0, r0, c1 - c0 + 1, r1 - r0 + 1);
+        return r.area() <= MAX_CELLS_PER_BOX;
+    }
+
+    int cols, rows;
+
+private:
+    float ox, oy, invCellW, invCellH;
+};
+
+// Kept boxes are stored by blocks of BLOCK boxes: BLOCK values of x1, then y1, x2, y2
+// and area. So overlaps with the whole block are computed by a few vector loads.
+class KeptBoxes
+{
+public:
+    enum { BLOCK = 4, BLOCK_SIZE = BLOCK * 5 };
+
+    KeptBoxes() : count(0) {}
+
+    void add(float x1, float y1, float x2, float y2, float area)
+    {
+        if (count % BLOCK == 0)
+        {
+            // Padding boxes have no intersection with anything.
+            data.resize(data.size() + BLOCK_SIZE);
+            float* b = &data[data.size() - BLOCK_SIZE];
+            for (int i = 0; i < BLOCK; ++i)
+            {
+                b[i] = b[BLOCK + i] = FLT_MAX;
+                b[BLOCK * 2 + i] = b[BLOCK * 3 + i] = -FLT_MAX;
+                b[BLOCK * 4 + i] = 0.f;
+            }
+        }
+        float* b = &data[(count / BLOCK) * BLOCK_SIZE];
+        int i = count % BLOCK;
+        b[i] = x1;
+        b[BLOCK + i] = y1;
+        b[BLOCK * 2 + i] = x2;
+        b[BLOCK * 3 + i] = y2;
+        b[BLOCK * 4 + i] = area;
+        count++;
+    }
+
+    int blocks() const { return (count + BLOCK - 1) / BLOCK; }
+
+    // Checks if any of boxes overlaps with the given one more than threshold.
+    bool suppresses(float x1, float y1, float x2, float y2, float area,
+                    float threshold, bool diou) const
+    {
+        const int nblocks = blocks();
+        const float* b = data.empty() ? 0 : &data[0];
+#if CV_SIMD128
+        v_float32x4 vx1 = v_setall_f32(x1), vy1 = v_setall_f32(y1);
+        v_float32x4 vx2 = v_setall_f32(x2), vy2 = v_setall_f32(y2);
+        v_float32x4 varea = v_setall_f32(area), vthr = v_setall_f32(threshold);
+        v_float32x4 z = v_setzero_f32(), eps = v_setall_f32(FLT_EPSILON);
+        for (int k = 0; k < nblocks; ++k, b += BLOCK_SIZE)
+        {
+            v_float32x4 bx1 = v_load(b), by1 = v_load(b + BLOCK);
+            v_float32x4 bx2 = v_load(b + BLOCK * 2), by2 = v_load(b + BLOCK * 3);
+            v_float32x4 w = v_max(v_min(vx2, bx2) - v_max(vx1, bx1), z);
+            v_float32x4 h = v_max(v_min(vy2, by2) - v_max(vy1, by1), z);
+            v_float32x4 inter = w * h;
+            v_float32x4 uni = varea + v_load(b + BLOCK * 4) - inter;
+            v_float32x4 mask;
+            if (!diou)
+                mask = inter > vthr * uni;
+            else
+            {
+                v_float32x4 iou = inter / v_max(uni, eps);
+                v_float32x4 cw = v_max(vx2, bx2) - v_min(vx1, bx1);
+                v_float32x4 ch = v_max(vy2, by2) - v_min(vy1, by1);
+                v_float32x4 dx = (bx1 + bx2) - (vx1 + vx2);
+                v_float32x4 dy = (by1 + by2) - (vy1 + vy2);
+                v_float32x4 d2 = (dx * dx + dy * dy) * v_setall_f32(0.25f);
+                mask = iou - d2 / v_max(cw * cw + ch * ch, eps) > vthr;
+            }
+            if (v_check_any(mask))
+                return true;
+        }
+        return false;
+#else
+        for (int k = 0; k < nblocks; ++k, b += BLOCK_SIZE)
+        {
+            for (int i = 0; i < BLOCK; ++i)
+            {
+                float bx1 = b[i], by1 = b[BLOCK + i], bx2 = b[BLOCK * 2 + i], by2 = b[BLOCK * 3 + i];
+                float w = std::max(std::min(x2, bx2) - std::max(x1, bx1), 0.f);
+                float h = std::max(std::min(y2, by2) - std::max(y1, by1), 0.f);
+                float inter = w * h, uni = area + b[BLOCK * 4 + i] - inter;
+                if (!diou)
+                {
+                    if (inter > threshold * uni)
+                        return true;
+                }
+                else
+                {
+                    float iou = inter / std::max(uni, FLT_EPSILON);
+                    float cw = std::max(x2, bx2) - std::min(x1, bx1);
+                    float ch = std::max(y2, by2) - std::min(y1, by1);
+                    float dx = (bx1 + bx2) - (x1 + x2), dy = (by1 + by2) - (y1 + y2);
+                    float d2 = (dx * dx + dy * dy) * 0.25f;
+                    if (iou - d2 / std::max(cw * cw + ch * ch, FLT_EPSILON) > threshold)
+                        return true;
+                }
+            }
+        }
+        return false;
+#endif
+    }
+
+private:
+    std::vector<float> data;
+    int count;
+};
+
+// Greedy suppression of boxes sorted by descending scores.
+// Kept boxes are registered in grid cells so every candidate is compared only
+// with kept boxes from its neighborhood.
+//    boxes: candidates sorted by scores.
+//    keep: positions of the kept boxes (in ascending order).
+static void greedyNMS(const BoxesSoA& boxes, const float nms_threshold, const float eta,
+                      const bool diou, std::vector<int>& keep)
+{
+    keep.clear();
+    const int n = (int)boxes.size();
+    if (n == 0)
+        return;
+
+    BoxesGrid grid(boxes);
+    std::vector<KeptBoxes> cells(grid.total());
+    KeptBoxes large, all;
+    bool hasEmpty = false;
+
+    float adaptive_threshold = nms_threshold;
+    for (int i = 0; i < n; ++i)
+    {
+        const float x1 = boxes.x1[i], y1 = boxes.y1[i], x2 = boxes.x2[i], y2 = boxes.y2[i];
+        const float area = boxes.area[i];
+
+        // Jaccard index of a pair of empty boxes is 1 (see cv::jaccardDistance).
+        bool suppressed = area <= 0 && hasEmpty && adaptive_threshold < 1.f;
+        Rect range;
+        bool isLarge = !grid.getRange(x1, y1, x2, y2, range);
+        if (!suppressed)
+        {
+            if (isLarge || range.area() >= all.blocks())
+                suppressed = all.suppresses(x1, y1, x2, y2, area, adaptive_threshold, diou);
+            else
+            {
+                suppressed = large.suppresses(x1, y1, x2, y2, area, adaptive_threshold, diou);
+                for (int r = range.y; r < range.y + range.height && !suppressed; ++r)
+                    for (int c = range.x; c < range.x + range.width && !suppressed; ++c)
+                        suppressed = cells[r * grid.cols + c].suppresses(x1, y1, x2, y2, area,
+                                                                         adaptive_threshold, diou);
+            }
+        }
+        if (suppressed)
+            continue;
+
+        keep.push_back(i);
+        hasEmpty |= area <= 0;
+        all.add(x1, y1, x2, y2, area);
+        if (isLarge)
+            large.add(x1, y1, x2, y2, area);
+        else
+        {
+            for (int r = range.y; r < range.y + range.height; ++r)
+                for (int c = range.x; c < range.x + range.width; ++c)
+                    cells[r * grid.cols + c].add(x1, y1, x2, y2, area);
+        }
+        if (eta < 1 && adaptive_threshold > 0.5)
+            adaptive_threshold *= eta;
+    }
+}
+
+template <typename T>
+static void NMSBoxesImpl(const std::vector<Rect_<T> >& bboxes, const std::vector<float>& scores,
+                         const std::vector<int>* class_ids,
+                         const float score_threshold, const float nms_threshold,
+                         std::vector<int>& indices, const float eta, const int top_k,
+                         const int method)
+{
+    CV_Assert_N(bboxes.size() == scores.size(), score_threshold >= 0,
+                nms_threshold >= 0, eta > 0);
+    CV_Assert(!class_ids || class_ids->size() == bboxes.size());
+    CV_Assert(method == NMS_IOU || method == NMS_DIOU);
+
+    std::vector<std::pair<float, int> > score_index_vec;
+    GetMaxScoreIndex(scores, score_threshold, top_k, score_index_vec);
+
+    // Candidates are split by classes preserving the order of scores.
+    std::map<int, std::vector<int> > classes;
+    for (int i = 0; i < (int)score_index_vec.size(); ++i)
+        classes[class_ids ? (*class_ids)[score_index_vec[i].second] : 0].push_back(i);
+
+    std::vector<uchar> kept(score_index_vec.size(), 0);
+    BoxesSoA boxes;
+    std::vector<int> keep;
+    for (std::map<int, std::vector<int> >::const_iterator it = classes.begin(); it != classes.end(); ++it)
+    {
+        const std::vector<int>& positions = it->second;
+        boxes = BoxesSoA();
+        for (size_t i = 0; i < positions.size(); ++i)
+            boxes.push_back(bboxes[score_index_vec[positions[i]].second]);
+        greedyNMS(boxes, nms_threshold, eta, method == NMS_DIOU, keep);
+        for (size_t i = 0; i < keep.size(); ++i)
+            kept[positions[keep[i]]] = 1;
+    }
+
+    indices.clear();
+    for (size_t i = 0; i < score_index_vec.size(); ++i)
+    {
+        if (kept[i])
+            indices.push_back(score_index_vec[i].second);
+    }
+}
+
 template <typename T>
-static inline float rectOverlap(const T& a, const T& b)
+static void softNMSBoxesImpl(const std::vector<Rect_<T> >& bboxes, const std::vector<float>& scores,
+                             std::vector<float>& updated_scores,
+                             const float score_threshold, const float nms_threshold,
+                             std::vector<int>& indices, size_t top_k,
+                             const float sigma, const int method)
 {
-    return 1.f - static_cast<float>(jaccardDistance(a, b));
+    CV_Assert_N(bboxes.size() == scores.size(), score_threshold >= 0,
+                nms_threshold >= 0, sigma > 0);
+    CV_Assert(method == SOFTNMS_LINEAR || method == SOFTNMS_GAUSSIAN);
+
+    indices.clear();
+    updated_scores.clear();
+
+    std::vector<int> ids;
+    BoxesSoA boxes;
+    for (size_t i = 0; i < scores.size(); ++i)
+    {
+        if (scores[i] >= score_threshold)
+        {
+            ids.push_back((int)i);
+            boxes.push_back(bboxes[i]);
+        }
+    }
+    const int n = (int)ids.size();
+    top_k = top_k == 0 ? (size_t)n : std::min(top_k, (size_t)n);
+
+    // Boxes which don't overlap the picked one keep their scores (both for
+    // linear and gaussian decays) so only boxes from the nearby cells are updated.
+    BoxesGrid grid(boxes);
+    std::vector<std::vector<int> > cells(grid.total());
+    std::vector<int> large;
+    for (int i = 0; i < n; ++i)
+    {
+        Rect range;
+        if (!grid.getRange(boxes.x1[i], boxes.y1[i], boxes.x2[i], boxes.y2[i], range))
+            large.push_back(i);
+        else
+        {
+            for (int r = range.y; r < range.y + range.height; ++r)
+                for (int c = range.x; c < range.x + range.width; ++c)
+                    cells[r * grid.cols + c].push_back(i);
+        }
+    }
+
+    // Max-heap with lazy removal of outdated scores. Ties are resolved by
+    // the lowest index.
+    std::vector<float> current(n);
+    std::vector<uchar> done(n, 0);
+    std::vector<int> visited(n, -1);
+    std::priority_queue<std::pair<float, int> > heap;
+    for (int i = 0; i < n; ++i)
+    {
+        current[i] = scores[ids[i]];
+        heap.push(std::make_pair(current[i], -i));
+    }
+
+    std::vector<int> neighbors;
+    while (indices.size() < top_k && !heap.empty())
+    {
+        std::pair<float, int> top = heap.top();
+        heap.pop();
+        const int b = -top.second;
+        if (done[b] || top.first != current[b])
+            continue;
+        if (top.first < score_threshold)
+            break;
+        done[b] = 1;
+        indices.push_back(ids[b]);
+        updated_scores.push_back(top.first);
+
+        const float x1 = boxes.x1[b], y1 = boxes.y1[b], x2 = boxes.x2[b], y2 = boxes.y2[b];
+        const float area = boxes.area[b];
+        const int stamp = (int)indices.size();
+        neighbors.clear();
+        Rect range;
+        if (!grid.getRange(x1, y1, x2, y2, range))
+        {
+            for (int i = 0; i < n; ++i)
+                neighbors.push_back(i);
+        }
+        else
+        {
+            neighbors = large;
+            for (int r = range.y; r < range.y + range.height; ++r)
+                for (int c = range.x; c < range.x + range.width; ++c)
+                {
+                    const std::vector<int>& cell = cells[r * grid.cols + c];
+                    for (size_t k = 0; k < cell.size(); ++k)
+                    {
+                        if (visited[cell[k]] != stamp)
+                        {
+                            visited[cell[k]] = stamp;
+                            neighbors.push_back(cell[k]);
+                        }
+                    }
+                }
+        }
+
+        for (size_t k = 0; k < neighbors.size(); ++k)
+        {
+            const int j = neighbors[k];
+            if (done[j] || current[j] < score_threshold)
+                continue;
+            float w = std::min(x2, boxes.x2[j]) - std::max(x1, boxes.x1[j]);
+            float h = std::min(y2, boxes.y2[j]) - std::max(y1, boxes.y1[j]);
+            if (w <= 0 || h <= 0)
+                continue;
+            float inter = w * h;
+            float overlap = inter / (area + boxes.area[j] - inter);
+            float decay = 1.f;
+            if (method == SOFTNMS_LINEAR)
+                decay = overlap > nms_threshold ? 1.f - overlap : 1.f;
+            else
+                decay = std::exp(-(overlap * overlap) / sigma);
+            if (decay == 1.f)
+                continue;
+            current[j] *= decay;
+            if (current[j] >= score_threshold)
+                heap.push(std::make_pair(current[j], -j));
+        }
+    }
 }
 
+} // namespace
+
 void NMSBoxes(const std::vector<Rect>& bboxes, const std::vector<float>& scores,
                           const float score_threshold, const float nms_threshold,
                           std::vector<int>& indices, const float eta, const int top_k)
 {
-    CV_Assert_N(bboxes.size() == scores.size(), score_threshold >= 0,
-        nms_threshold >= 0, eta > 0);
-    NMSFast_(bboxes, scores, score_threshold, nms_threshold, eta, top_k, indices, rectOverlap);
+    NMSBoxesImpl(bboxes, scores, NULL, score_threshold, nms_threshold, indices, eta, top_k, NMS_IOU);
 }
 
 void NMSBoxes(const std::vector<Rect2d>& bboxes, const std::vector<float>& scores,
                           const float score_threshold, const float nms_threshold,
                           std::vector<int>& indices, const float eta, const int top_k)
 {
-    CV_Assert_N(bboxes.size() == scores.size(), score_threshold >= 0,
-        nms_threshold >= 0, eta > 0);
-    NMSFast_(bboxes, scores, score_threshold, nms_threshold, eta, top_k, indices, rectOverlap);
+    NMSBoxesImpl(bboxes, scores, NULL, score_threshold, nms_threshold, indices, eta, top_k, NMS_IOU);
 }
 
 static inline float rotatedRectIOU(const RotatedRect& a, const RotatedRect& b)
@@ -61,6 +480,44 @@ void NMSBoxes(const std::vector<RotatedRect>& bboxes, const std::vector<float>&
     NMSFast_(bboxes, scores, score_threshold, nms_threshold, eta, top_k, indices, rotatedRectIOU);
 }
 
+void NMSBoxesBatched(const std::vector<Rect>& bboxes, const std::vector<float>& scores,
+                     const std::vector<int>& class_ids,
+                     const float score_threshold, const float nms_threshold,
+                     std::vector<int>& indices, const float eta, const int top_k,
+                     const int method)
+{
+    NMSBoxesImpl(bboxes, scores, &class_ids, score_threshold, nms_threshold, indices, eta, top_k, method);
+}
+
+void NMSBoxesBatched(const std::vector<Rect2d>& bboxes, const std::vector<float>& scores,
+                     const std::vector<int>& class_ids,
+                     const float score_threshold, const float nms_threshold,
+                     std::vector<int>& indices, const float eta, const int top_k,
+                     const int method)
+{
+    NMSBoxesImpl(bboxes, scores, &class_ids, score_threshold, nms_threshold, indices, eta, top_k, method);
+}
+
+void softNMSBoxes(const std::vector<Rect>& bboxes, const std::vector<float>& scores,
+                  std::vector<float>& updated_scores,
+                  const float score_threshold, const float nms_threshold,
+                  std::vector<int>& indices, size_t top_k,
+                  const float sigma, const int method)
+{
+    softNMSBoxesImpl(bboxes, scores, updated_scores, score_threshold, nms_threshold,
+                     indices, top_k, sigma, method);
+}
+
+void softNMSBoxes(const std::vector<Rect2d>& bboxes, const std::vector<float>& scores,
+                  std::vector<float>& updated_scores,
+                  const float score_threshold, const float nms_threshold,
+                  std::vector<int>& indices, size_t top_k,
+                  const float sigma, const int method)
+{
+    softNMSBoxesImpl(bboxes, scores, updated_scores, score_threshold, nms_threshold,
+                     indices, top_k, sigma, method);
+}
+
 CV__DNN_EXPERIMENTAL_NS_END
 }// dnn
 }// cv
@@ -6,6 +6,7 @@
 // Third party copyrights are property of their respective owners.
 
 #include "../precomp.hpp"
+#include "../mapped_file.hpp"
 #include <opencv2/dnn/shape_utils.hpp>
 
 #ifdef HAVE_PROTOBUF
@@ -31,9 +32,93 @@ namespace dnn {
 CV__DNN_EXPERIMENTAL_NS_BEGIN
 
 
+// Location of initializer's raw data in the model file.
+struct RawDataRef
+{
+    size_t offset, size;
+    RawDataRef() : offset(0), size(0) {}
+};
+
+static uint64_t readVarint(const uchar*& ptr, const uchar* end)
+{
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (ptr >= end)
+            break;
+        uchar byte = *ptr++;
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return value;
+    }
+    CV_Error(Error::StsUnsupportedFormat, "Failed to parse onnx model");
+}
+
+static void writeVarint(std::vector<uchar>& dst, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        dst.push_back((uchar)(value | 0x80));
+        value >>= 7;
+    }
+    dst.push_back((uchar)value);
+}
+
+// Copies serialized message [begin, end) of protobuf wire format skipping raw_data
+// fields of graph's initializers. Their locations are collected into [rawData]
+// in order of initializers. [level] is 0 for ModelProto, 1 for GraphProto and 2 for TensorProto.
+static void stripInitializers(const uchar* base, const uchar* begin, const uchar* end, int level,
+                              std::vector<uchar>& dst, std::vector<RawDataRef>& rawData)
+{
+    const int ModelProto_graph = 7, GraphProto_initializer = 5, TensorProto_raw_data = 9;
+    const uchar* ptr = begin;
+    while (ptr < end)
+    {
+        const uchar* field = ptr;
+        uint64_t tag = readVarint(ptr, end);
+        const uchar* payload = ptr;
+        size_t payloadSize = 0;
+        switch (tag & 7)
+        {
+            case 0: readVarint(ptr, end); break;
+            case 1: payloadSize = 8; break;
+            case 2: payloadSize = (size_t)readVarint(ptr, end); payload = ptr; break;
+            case 5: payloadSize = 4; break;
+            default: CV_Error(Error::StsUnsupportedFormat, "Failed to parse onnx model");
+        }
+        if ((size_t)(end - ptr) < payloadSize)
+            CV_Error(Error::StsUnsupportedFormat, "Failed to parse onnx model");
+        ptr += payloadSize;
+
+        const int fieldId = (int)(tag >> 3);
+        const bool isMessage = (tag & 7) == 2;
+        if (isMessage && ((level == 0 && fieldId == ModelProto_graph) ||
+                          (level == 1 && fieldId == GraphProto_initializer)))
+        {
+            if (level == 1)
+                rawData.push_back(RawDataRef());
+            std::vector<uchar> message;
+            stripInitializers(base, payload, payload + payloadSize, level + 1, message, rawData);
+            writeVarint(dst, tag);
+            writeVarint(dst, message.size());
+            dst.insert(dst.end(), message.begin(), message.end());
+        }
+        else if (isMessage && level == 2 && fieldId == TensorProto_raw_data)
+        {
+            rawData.back().offset = payload - base;
+            rawData.back().size = payloadSize;
+        }
+        else
+            dst.insert(dst.end(), field, ptr);
+    }
+}
+
 class ONNXImporter
 {
     opencv_onnx::ModelProto model_proto;
+    // Model file and locations of initializers data if the model is memory mapped.
+    Ptr<MappedFile> modelFile;
+    std::vector<RawDataRef> initializersData;
     struct LayerInfo {
         int layerId;
         int outputId;
@@ -41,7 +126,7 @@ class ONNXImporter
     };
 
     std::map<std::string, Mat> getGraphTensors(
-                                    const opencv_onnx::GraphProto& graph_proto);
+                                    opencv_onnx::GraphProto& graph_proto);
     Mat getBlob(const opencv_onnx::NodeProto& node_proto, const std::map<std::string, Mat>& constBlobs, int index);
 
     LayerParams getLayerParams(const opencv_onnx::NodeProto& node_proto);
@@ -51,9 +136,15 @@ public:
 
     ONNXImporter(const char *onnxFile)
     {
-        std::fstream input(onnxFile, std::ios::in | std::ios::binary);
-
-        if (!model_proto.ParseFromIstream(&input))
+        // Initializers are parsed from the memory mapped file directly.
+        // The rest of the model is small and parsed by protobuf.
+        modelFile = makePtr<MappedFile>(String(onnxFile));
+        const uchar* data = modelFile->data();
+        std::vector<uchar> model;
+        stripInitializers(data, data, data + modelFile->size(), 0, model, initializersData);
+
+        if (model.size() > (size_t)std::numeric_limits<int>::max() ||
+            !model_proto.ParseFromArray(model.empty() ? NULL : &model[0], (int)model.size()))
             CV_Error(Error::StsUnsupportedFormat, "Failed to parse onnx model");
     }
 
@@ -189,15 +280,35 @@ void runLayer(LayerParams& params, const std::vector<Mat>& inputs,
 }
 
 std::map<std::string, Mat> ONNXImporter::getGraphTensors(
-                                        const opencv_onnx::GraphProto& graph_proto)
+                                        opencv_onnx::GraphProto& graph_proto)
 {
-  opencv_onnx::TensorProto tensor_proto;
   std::map<std::string, Mat> layers_weights;
 
   for (int i = 0; i < graph_proto.initializer_size(); i++)
   {
-    tensor_proto = graph_proto.initializer(i);
-    Mat mat = getMatFromTensor(tensor_proto);
+    opencv_onnx::TensorProto& tensor_proto = *graph_proto.mutable_initializer(i);
+    Mat mat;
+    if (i < (int)initializersData.size() && initializersData[i].size > 0)
+    {
+        const RawDataRef& ref = initializersData[i];
+        if (tensor_proto.data_type() == opencv_onnx::TensorProto_DataType_FLOAT &&
+            ref.offset % sizeof(float) == 0)
+        {
+            // Aligned float data is used from the mapped file without copying.
+            std::vector<int> sizes(tensor_proto.dims().begin(), tensor_proto.dims().end());
+            if (sizes.empty())
+                sizes.assign(1, 1);
+            mat = MappedFile::wrap(modelFile, ref.offset, (int)sizes.size(), &sizes[0], CV_32F);
+            if (mat.total() * sizeof(float) != ref.size)
+                CV_Error(Error::StsUnsupportedFormat, "Wrong size of tensor " + tensor_proto.name());
+            if (tensor_proto.dims_size() == 0)
+                mat.dims = 1;  // To force 1-dimensional cv::Mat for scalars.
+        }
+        else
+            tensor_proto.set_raw_data(modelFile->data() + ref.offset, ref.size);
+    }
+    if (mat.empty())
+        mat = getMatFromTensor(tensor_proto);
     releaseONNXTensor(tensor_proto);
     layers_weights.insert(std::make_pair(tensor_proto.name(), mat));
   }
@@ -322,10 +433,187 @@ Mat ONNXImporter::getBlob(const opencv_onnx::NodeProto& node_proto,
     return constBlob->second;
 }
 
+// Replaces x * sigmoid(x) subgraphs (SiLU activation exported from PyTorch
+// as a pair of Sigmoid and Mul nodes) by a single Swish node. So the
+// activation may be fused into the preceding convolution.
+static void simplifySwish(opencv_onnx::GraphProto& graph_proto)
+{
+    std::map<std::string, int> numConsumers;
+    for (int i = 0; i < graph_proto.node_size(); ++i)
+    {
+        const opencv_onnx::NodeProto& node_proto = graph_proto.node(i);
+        for (int j = 0; j < node_proto.input_size(); ++j)
+            numConsumers[node_proto.input(j)] += 1;
+    }
+    for (int i = 0; i < graph_proto.output_size(); ++i)
+        numConsumers[graph_proto.output(i).name()] += 1;
+
+    std::map<std::string, int> sigmoids;
+    for (int i = 0; i < graph_proto.node_size(); ++i)
+    {
+        const opencv_onnx::NodeProto& node_proto = graph_proto.node(i);
+        if (node_proto.op_type() == "Sigmoid" && node_proto.input_size() == 1 &&
+            node_proto.output_size() == 1 && numConsumers[node_proto.output(0)] == 1)
+            sigmoids[node_proto.output(0)] = i;
+    }
+    if (sigmoids.empty())
+        return;
+
+    std::vector<int> nodesToRemove;
+    for (int i = 0; i < graph_proto.node_size(); ++i)
+    {
+        opencv_onnx::NodeProto* node_proto = graph_proto.mutable_node(i);
+        if (node_proto->op_type() != "Mul" || node_proto->input_size() != 2)
+            continue;
+        for (int j = 0; j < 2; ++j)
+        {
+            std::map<std::string, int>::iterator sigmoidIt = sigmoids.find(node_proto->input(j));
+            if (sigmoidIt == sigmoids.end() ||
+                graph_proto.node(sigmoidIt->second).input(0) != node_proto->input(1 - j))
+                continue;
+
+            std::string input = node_proto->input(1 - j);
+            node_proto->set_op_type("Swish");
+            node_proto->clear_input();
+            node_proto->add_input(input);
+            nodesToRemove.push_back(sigmoidIt->second);
+            break;
+        }
+    }
+
+    std::sort(nodesToRemove.begin(), nodesToRemove.end());
+    for (int i = (int)nodesToRemove.size() - 1; i >= 0; --i)
+        graph_proto.mutable_node()->DeleteSubrange(nodesToRemove[i], 1);
+}
+
+static void addIntAttribute(opencv_onnx::NodeProto* node_proto, const std::string& name, int value)
+{
+    opencv_onnx::AttributeProto* attribute_proto = node_proto->add_attribute();
+    attribute_proto->set_name(name);
+    attribute_proto->set_type(opencv_onnx::AttributeProto_AttributeType_INT);
+    attribute_proto->set_i(value);
+}
+
+// Returns kernel size of MaxPool with square odd kernel, unit strides and
+// paddings which keep spatial size or 0 for the rest of nodes.
+static int getSamePaddedMaxPoolKernel(const opencv_onnx::NodeProto& node_proto)
+{
+    if (node_proto.op_type() != "MaxPool" || node_proto.input_size() != 1 ||
+        node_proto.output_size() != 1)
+        return 0;
+    int kernel = 0;
+    std::vector<int> pads;
+    for (int i = 0; i < node_proto.attribute_size(); ++i)
+    {
+        const opencv_onnx::AttributeProto& attribute_proto = node_proto.attribute(i);
+        const std::string& name = attribute_proto.name();
+        if (name == "kernel_shape")
+        {
+            if (attribute_proto.ints_size() != 2 || attribute_proto.ints(0) != attribute_proto.ints(1))
+                return 0;
+            kernel = (int)attribute_proto.ints(0);
+        }
+        else if (name == "pads")
+        {
+            for (int j = 0; j < attribute_proto.ints_size(); ++j)
+                pads.push_back((int)attribute_proto.ints(j));
+        }
+        else if (name == "strides" || name == "dilations")
+        {
+            for (int j = 0; j < attribute_proto.ints_size(); ++j)
+                if (attribute_proto.ints(j) != 1)
+                    return 0;
+        }
+        else if (name == "ceil_mode" || name == "auto_pad")
+        {
+            if (attribute_proto.i() != 0 || (!attribute_proto.s().empty() && attribute_proto.s() != "NOTSET"))
+                return 0;
+        }
+        else if (name != "storage_order")
+            return 0;
+    }
+    if (kernel <= 0 || kernel % 2 == 0)
+        return 0;
+    if (pads.empty())
+        pads.assign(4, 0);
+    if (pads.size() != 4 || std::count(pads.begin(), pads.end(), kernel / 2) != 4)
+        return 0;
+    return kernel;
+}
+
+// Replaces spatial pyramid pooling block Concat(x, MaxPool(x), MaxPool(MaxPool(x)), ...)
+// with chained max poolings of the same kernel by a single SPPF node.
+static void simplifySPPF(opencv_onnx::GraphProto& graph_proto)
+{
+    std::map<std::string, int> numConsumers;
+    for (int i = 0; i < graph_proto.node_size(); ++i)
+    {
+        const opencv_onnx::NodeProto& node_proto = graph_proto.node(i);
+        for (int j = 0; j < node_proto.input_size(); ++j)
+            numConsumers[node_proto.input(j)] += 1;
+    }
+    for (int i = 0; i < graph_proto.output_size(); ++i)
+        numConsumers[graph_proto.output(i).name()] += 1;
+
+    std::map<std::string, int> pools;
+    for (int i = 0; i < graph_proto.node_size(); ++i)
+    {
+        if (getSamePaddedMaxPoolKernel(graph_proto.node(i)))
+            pools[graph_proto.node(i).output(0)] = i;
+    }
+    if (pools.empty())
+        return;
+
+    std::vector<int> nodesToRemove;
+    for (int i = 0; i < graph_proto.node_size(); ++i)
+    {
+        opencv_onnx::NodeProto* node_proto = graph_proto.mutable_node(i);
+        if (node_proto->op_type() != "Concat" || node_proto->input_size() < 2 ||
+            node_proto->attribute_size() != 1 || node_proto->attribute(0).name() != "axis" ||
+            node_proto->attribute(0).i() != 1)
+            continue;
+
+        const int numPools = node_proto->input_size() - 1;
+        std::vector<int> chain;
+        int kernel = 0;
+        for (int j = 1; j <= numPools; ++j)
+        {
+            std::map<std::string, int>::iterator poolIt = pools.find(node_proto->input(j));
+            if (poolIt == pools.end())
+                break;
+            const opencv_onnx::NodeProto& pool_proto = graph_proto.node(poolIt->second);
+            int poolKernel = getSamePaddedMaxPoolKernel(pool_proto);
+            // Intermediate results are consumed by Concat and the next pooling only.
+            if (pool_proto.input(0) != node_proto->input(j - 1) || (kernel && poolKernel != kernel) ||
+                numConsumers[node_proto->input(j)] != (j == numPools ? 1 : 2))
+                break;
+            kernel = poolKernel;
+            chain.push_back(poolIt->second);
+        }
+        if ((int)chain.size() != numPools)
+            continue;
+
+        std::string input = node_proto->input(0);
+        node_proto->set_op_type("SPPF");
+        node_proto->clear_input();
+        node_proto->add_input(input);
+        node_proto->clear_attribute();
+        addIntAttribute(node_proto, "kernel_size", kernel);
+        addIntAttribute(node_proto, "num_pools", numPools);
+        nodesToRemove.insert(nodesToRemove.end(), chain.begin(), chain.end());
+    }
+
+    std::sort(nodesToRemove.begin(), nodesToRemove.end());
+    for (int i = (int)nodesToRemove.size() - 1; i >= 0; --i)
+        graph_proto.mutable_node()->DeleteSubrange(nodesToRemove[i], 1);
+}
+
 void ONNXImporter::populateNet(Net dstNet)
 {
     CV_Assert(model_proto.has_graph());
-    opencv_onnx::GraphProto graph_proto = model_proto.graph();
+    opencv_onnx::GraphProto& graph_proto = *model_proto.mutable_graph();
+    simplifySwish(graph_proto);
+    simplifySPPF(graph_proto);
     std::map<std::string, Mat> constBlobs = getGraphTensors(graph_proto);
     // List of internal blobs shapes.
     std::map<std::string, MatShape> outShapes;
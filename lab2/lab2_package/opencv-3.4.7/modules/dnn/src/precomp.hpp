@@ -65,7 +65,11 @@
 namespace cv { namespace dnn {
 CV__DNN_EXPERIMENTAL_NS_BEGIN
 #define IS_DNN_OPENCL_TARGET(id) (id == DNN_TARGET_OPENCL || id == DNN_TARGET_OPENCL_FP16)
+#define IS_DNN_CPU_TARGET(id) (id == DNN_TARGET_CPU || id == DNN_TARGET_CPU_FP16)
 Mutex& getInitializationMutex();
+//! Layers report here which implementation was chosen for the current forward call (a string literal).
+void setForwardKernel(const char* kernel);
+const char* getForwardKernel();
 void initializeLayerFactory();
 CV__DNN_EXPERIMENTAL_NS_END
 }} // namespace
@@ -0,0 +1,388 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include <opencv2/imgproc.hpp>
+
+namespace cv { namespace dnn {
+CV__DNN_EXPERIMENTAL_NS_BEGIN
+
+struct TiledDetector::Impl
+{
+    Impl(const Net& net, Size tileSize, int overlap)
+        : net(net), tileSize(tileSize), overlap(overlap), scale(1.0), swapRB(false),
+          confThreshold(0.25f), nmsThreshold(0.45f), includeFullImage(true), maxBatchSize(0),
+          normalizedCoordinates(true), planFullImage(false), useFullImage(false), fullImageScale(1.0)
+    {
+        CV_Assert(!tileSize.empty());
+        CV_Assert(overlap >= 0 && overlap < std::min(tileSize.width, tileSize.height));
+    }
+
+    // Tile origins along a dimension of the image. Tiles are spread evenly so
+    // the neighbour ones overlap at least by [overlap] pixels.
+    std::vector<int> getOrigins(int imageSize, int tile) const
+    {
+        std::vector<int> origins(1, 0);
+        if (imageSize <= tile)
+            return origins;
+        int n = (imageSize - overlap + tile - overlap - 1) / (tile - overlap);
+        n = std::max(n, 2);
+        origins.resize(n);
+        for (int i = 1; i < n; ++i)
+            origins[i] = cvRound((double)i * (imageSize - tile) / (n - 1));
+        return origins;
+    }
+
+    void updatePlan(Size imageSize)
+    {
+        if (imageSize == planSize && planFullImage == includeFullImage)
+            return;
+        std::vector<int> xs = getOrigins(imageSize.width, tileSize.width);
+        std::vector<int> ys = getOrigins(imageSize.height, tileSize.height);
+        tiles.clear();
+        for (size_t y = 0; y < ys.size(); ++y)
+            for (size_t x = 0; x < xs.size(); ++x)
+                tiles.push_back(Rect(xs[x], ys[y], tileSize.width, tileSize.height) &
+                                Rect(Point(), imageSize));
+        // The whole image is resized to fit the tile keeping aspect ratio.
+        fullImageScale = std::max((double)imageSize.width / tileSize.width,
+                                  (double)imageSize.height / tileSize.height);
+        fullImageSize = Size(std::min(cvRound(imageSize.width / fullImageScale), tileSize.width),
+                             std::min(cvRound(imageSize.height / fullImageScale), tileSize.height));
+        planSize = imageSize;
+        planFullImage = includeFullImage;
+        // A single tile already covers the whole image.
+        useFullImage = includeFullImage && tiles.size() > 1;
+    }
+
+    // Returns tile image of the network input size. ROIs are used as is, the
+    // border tiles of images smaller than the tile are padded by zeros.
+    Mat getTileImage(const Mat& frame, int i)
+    {
+        if (buffers.size() <= (size_t)i)
+            buffers.resize(i + 1);
+        Mat& buf = buffers[i];
+        if (i == (int)tiles.size())
+        {
+            buf.create(tileSize, frame.type());
+            buf.setTo(Scalar::all(0));
+            resize(frame, buf(Rect(Point(), fullImageSize)), fullImageSize, 0, 0, INTER_AREA);
+            return buf;
+        }
+        const Rect& tile = tiles[i];
+        if (tile.size() == tileSize)
+            return frame(tile);
+        buf.create(tileSize, frame.type());
+        buf.setTo(Scalar::all(0));
+        frame(tile).copyTo(buf(Rect(Point(), tile.size())));
+        return buf;
+    }
+
+    // Collects detections of tiles [first, first + num) from the network output.
+    void parseOutput(const Mat& out, int first, int num,
+                     std::vector<int>& tileIds, std::vector<int>& classIds,
+                     std::vector<float>& confidences, std::vector<Rect2d>& boxes) const
+    {
+        if (out.dims == 4 && out.size[3] == 7)
+        {
+            // DetectionOutput rows: [tile_id, class_id, confidence, left, top, right, bottom]
+            const float* data = out.ptr<float>();
+            const size_t numRows = out.total() / 7;
+            for (size_t i = 0; i < numRows; ++i, data += 7)
+            {
+                float confidence = data[2];
+                if (confidence <= confThreshold)
+                    continue;
+                int tileId = (int)data[0];
+                CV_Assert(0 <= tileId && tileId < num);
+                double left = data[3], top = data[4], right = data[5], bottom = data[6];
+                if (normalizedCoordinates)
+                {
+                    left *= tileSize.width;
+                    right *= tileSize.width;
+                    top *= tileSize.height;
+                    bottom *= tileSize.height;
+                }
+                tileIds.push_back(first + tileId);
+                classIds.push_back((int)data[1]);
+                confidences.push_back(confidence);
+                boxes.push_back(Rect2d(left, top, right - left, bottom - top));
+            }
+        }
+        else if (out.dims == 3 && out.size[0] == num && out.size[2] > 5)
+        {
+            // YOLO rows: [center_x, center_y, width, height, objectness, class scores]
+            const int numRows = out.size[1], rowSize = out.size[2];
+            for (int t = 0; t < num; ++t)
+            {
+                const float* data = out.ptr<float>(t);
+                for (int i = 0; i < numRows; ++i, data += rowSize)
+                {
+                    float objectness = data[4];
+                    if (objectness <= confThreshold)
+                        continue;
+                    const float* scores = data + 5;
+                    int classId = (int)(std::max_element(scores, data + rowSize) - scores);
+                    float confidence = objectness * scores[classId];
+                    if (confidence <= confThreshold)
+                        continue;
+                    tileIds.push_back(first + t);
+                    classIds.push_back(classId);
+                    confidences.push_back(confidence);
+                    boxes.push_back(Rect2d(data[0] - 0.5 * data[2], data[1] - 0.5 * data[3],
+                                           data[2], data[3]));
+                }
+            }
+        }
+        else
+            CV_Error(Error::StsNotImplemented, "Unsupported output of detection network");
+    }
+
+    // Checks if a box touches the tile border which is inside of the image,
+    // so the object may continue in the neighbour tile.
+    bool isCutBySeam(const Rect2d& box, const Rect& tile, bool& cutX, bool& cutY) const
+    {
+        const double eps = 1.0;
+        cutX = (tile.x > 0 && box.x <= tile.x + eps) ||
+               (tile.br().x < planSize.width && box.br().x >= tile.br().x - eps);
+        cutY = (tile.y > 0 && box.y <= tile.y + eps) ||
+               (tile.br().y < planSize.height && box.br().y >= tile.br().y - eps);
+        return cutX || cutY;
+    }
+
+    static int findRoot(std::vector<int>& parents, int i)
+    {
+        while (parents[i] != i)
+            i = parents[i] = parents[parents[i]];
+        return i;
+    }
+
+    // Merges parts of objects which cross seams between tiles. Parts of neighbour tiles
+    // are of the same object if they match in the common area of the tiles. Every group
+    // of parts is replaced by the union of their boxes with the highest confidence.
+    // Unmatched parts are dropped if the downscaled image is expected to find them.
+    void mergeSeamParts(const std::vector<int>& partTiles, std::vector<Rect2d>& parts,
+                        std::vector<float>& partScores, std::vector<int>& partIds,
+                        std::vector<Rect2d>& rects, std::vector<float>& scores,
+                        std::vector<int>& ids) const
+    {
+        const double minIoU = 0.5;
+        const int n = (int)parts.size();
+        std::vector<int> parents(n);
+        for (int i = 0; i < n; ++i)
+            parents[i] = i;
+        for (int i = 0; i < n; ++i)
+        {
+            for (int j = i + 1; j < n; ++j)
+            {
+                if (partTiles[i] == partTiles[j] || partIds[i] != partIds[j])
+                    continue;
+                Rect2d common = Rect2d(tiles[partTiles[i]] & tiles[partTiles[j]]);
+                Rect2d a = parts[i] & common, b = parts[j] & common;
+                double intersection = (a & b).area();
+                if (intersection <= 0 || intersection < minIoU * (a.area() + b.area() - intersection))
+                    continue;
+                parents[findRoot(parents, j)] = findRoot(parents, i);
+            }
+        }
+
+        std::vector<int> sizes(n, 0);
+        for (int i = 0; i < n; ++i)
+        {
+            int root = findRoot(parents, i);
+            sizes[root] += 1;
+            if (root == i)
+                continue;
+            parts[root] |= parts[i];
+            partScores[root] = std::max(partScores[root], partScores[i]);
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            if (parents[i] != i || (sizes[i] == 1 && useFullImage))
+                continue;
+            rects.push_back(parts[i]);
+            scores.push_back(partScores[i]);
+            ids.push_back(partIds[i]);
+        }
+    }
+
+    void detect(const Mat& frame, std::vector<int>& classIds,
+                std::vector<float>& confidences, std::vector<Rect>& boxes)
+    {
+        CV_Assert(!frame.empty());
+        updatePlan(frame.size());
+
+        const int numTiles = (int)tiles.size() + (useFullImage ? 1 : 0);
+        const int batchSize = maxBatchSize > 0 ? std::min(maxBatchSize, numTiles) : numTiles;
+
+        std::vector<int> tileIds, ids;
+        std::vector<float> scores;
+        std::vector<Rect2d> rects;
+        std::vector<Mat> images, outs;
+        std::vector<String> outNames = net.getUnconnectedOutLayersNames();
+        for (int first = 0; first < numTiles; first += batchSize)
+        {
+            const int num = std::min(batchSize, numTiles - first);
+            images.resize(num);
+            for (int i = 0; i < num; ++i)
+                images[i] = getTileImage(frame, first + i);
+            blobFromImages(images, blob, scale, Size(), mean, swapRB, false);
+            net.setInput(blob);
+            net.forward(outs, outNames);
+            CV_Assert(!outs.empty());
+            parseOutput(outs[0], first, num, tileIds, ids, scores, rects);
+        }
+
+        // Map detections to the image.
+        const Rect2d imageRect(0, 0, frame.cols, frame.rows);
+        std::vector<Rect2d> globalRects, parts;
+        std::vector<float> globalScores, partScores;
+        std::vector<int> globalIds, partIds, partTiles;
+        for (size_t i = 0; i < rects.size(); ++i)
+        {
+            Rect2d box = rects[i];
+            if (tileIds[i] == (int)tiles.size())
+            {
+                box.x *= fullImageScale;
+                box.y *= fullImageScale;
+                box.width *= fullImageScale;
+                box.height *= fullImageScale;
+            }
+            else
+            {
+                const Rect& tile = tiles[tileIds[i]];
+                box.x += tile.x;
+                box.y += tile.y;
+                bool cutX, cutY;
+                if (isCutBySeam(box, tile, cutX, cutY))
+                {
+                    // A small object is found entirely by the neighbour tile.
+                    if ((cutX && box.width < overlap) || (cutY && box.height < overlap))
+                        continue;
+                    box &= imageRect;
+                    if (box.area() <= 0)
+                        continue;
+                    parts.push_back(box);
+                    partScores.push_back(scores[i]);
+                    partIds.push_back(ids[i]);
+                    partTiles.push_back(tileIds[i]);
+                    continue;
+                }
+            }
+            box &= imageRect;
+            if (box.area() <= 0)
+                continue;
+            globalRects.push_back(box);
+            globalScores.push_back(scores[i]);
+            globalIds.push_back(ids[i]);
+        }
+        mergeSeamParts(partTiles, parts, partScores, partIds, globalRects, globalScores, globalIds);
+
+        std::vector<int> indices;
+        NMSBoxesBatched(globalRects, globalScores, globalIds, confThreshold, nmsThreshold, indices);
+
+        classIds.resize(indices.size());
+        confidences.resize(indices.size());
+        boxes.resize(indices.size());
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            const Rect2d& box = globalRects[indices[i]];
+            classIds[i] = globalIds[indices[i]];
+            confidences[i] = globalScores[indices[i]];
+            boxes[i] = Rect(cvRound(box.x), cvRound(box.y), cvRound(box.width), cvRound(box.height));
+        }
+    }
+
+    Net net;
+    Size tileSize;
+    int overlap;
+    double scale;
+    Scalar mean;
+    bool swapRB;
+    float confThreshold, nmsThreshold;
+    bool includeFullImage;
+    int maxBatchSize;
+    bool normalizedCoordinates;
+
+    // Tiles plan for images of [planSize].
+    Size planSize;
+    bool planFullImage, useFullImage;
+    std::vector<Rect> tiles;
+    double fullImageScale;
+    Size fullImageSize;
+
+    std::vector<Mat> buffers;
+    Mat blob;
+};
+
+TiledDetector::TiledDetector() {}
+
+TiledDetector::TiledDetector(const Net& net, Size tileSize, int overlap)
+    : impl(new Impl(net, tileSize, overlap))
+{
+}
+
+TiledDetector& TiledDetector::setInputParams(double scale, const Scalar& mean, bool swapRB)
+{
+    CV_Assert(impl);
+    impl->scale = scale;
+    impl->mean = mean;
+    impl->swapRB = swapRB;
+    return *this;
+}
+
+TiledDetector& TiledDetector::setThresholds(float confThreshold, float nmsThreshold)
+{
+    CV_Assert(impl);
+    CV_Assert(confThreshold >= 0 && nmsThreshold >= 0);
+    impl->confThreshold = confThreshold;
+    impl->nmsThreshold = nmsThreshold;
+    return *this;
+}
+
+TiledDetector& TiledDetector::setIncludeFullImage(bool include)
+{
+    CV_Assert(impl);
+    impl->includeFullImage = include;
+    return *this;
+}
+
+TiledDetector& TiledDetector::setNormalizedCoordinates(bool normalized)
+{
+    CV_Assert(impl);
+    impl->normalizedCoordinates = normalized;
+    return *this;
+}
+
+TiledDetector& TiledDetector::setMaxBatchSize(int maxBatchSize)
+{
+    CV_Assert(impl);
+    CV_Assert(maxBatchSize >= 0);
+    impl->maxBatchSize = maxBatchSize;
+    return *this;
+}
+
+std::vector<Rect> TiledDetector::getTiles(Size imageSize) const
+{
+    CV_Assert(impl);
+    impl->updatePlan(imageSize);
+    return impl->tiles;
+}
+
+void TiledDetector::detect(InputArray frame, std::vector<int>& classIds,
+                           std::vector<float>& confidences, std::vector<Rect>& boxes)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    impl->detect(frame.getMat(), classIds, confidences, boxes);
+}
+
+Net TiledDetector::getNetwork() const
+{
+    CV_Assert(impl);
+    return impl->net;
+}
+
+CV__DNN_EXPERIMENTAL_NS_END
+}}  // namespace cv::dnn
@@ -105,6 +105,53 @@ TEST(Test_Darknet, read_yolo_voc_stream)
     }
 }
 
+// Weights read by path are used from the memory mapped file.
+TEST(Test_Darknet, read_mapped_weights)
+{
+    const std::string cfg =
+        "[net]\nwidth=8\nheight=8\nchannels=3\n\n"
+        "[convolutional]\nbatch_normalize=1\nfilters=4\nsize=3\nstride=1\npad=1\nactivation=leaky\n\n"
+        "[convolutional]\nfilters=2\nsize=1\nstride=1\npad=0\nactivation=linear\n";
+    // Header (major, minor, revision, seen) followed by biases, batch normalization
+    // parameters and weights of the first convolution, biases and weights of the second one.
+    const int numWeights = 4 * 4 + 4 * 3 * 3 * 3 + 2 + 2 * 4;
+    Mat weights(1, numWeights, CV_32F);
+    randu(weights, 0.5f, 1.0f);
+    std::vector<char> weightsData(sizeof(int32_t) * 3 + sizeof(uint64_t));
+    int32_t version[] = {0, 2, 0};
+    memcpy(&weightsData[0], version, sizeof(version));
+    weightsData.insert(weightsData.end(), weights.data, weights.data + numWeights * sizeof(float));
+
+    const std::string cfgFile = cv::tempfile(".cfg");
+    const std::string weightsFile = cv::tempfile(".weights");
+    std::ofstream(cfgFile.c_str()) << cfg;
+    std::ofstream(weightsFile.c_str(), std::ios::binary).write(&weightsData[0], weightsData.size());
+
+    Mat inp(std::vector<int>(shape(1, 3, 8, 8)), CV_32F);
+    randu(inp, -1, 1);
+
+    Net ref = readNetFromDarknet(cfg.c_str(), cfg.size(), &weightsData[0], weightsData.size());
+    ref.setInput(inp);
+    ref.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat refOut = ref.forward();
+
+    Mat out;
+    {
+        Net net = readNetFromDarknet(cfgFile, weightsFile);
+        remove(weightsFile.c_str());
+        net.setInput(inp);
+        net.setPreferableBackend(DNN_BACKEND_OPENCV);
+        out = net.forward().clone();
+    }
+    normAssert(refOut, out, "", 0, 0);
+
+    // Truncated weights file
+    std::ofstream(weightsFile.c_str(), std::ios::binary).write(&weightsData[0], weightsData.size() / 2);
+    EXPECT_THROW(readNetFromDarknet(cfgFile, weightsFile), cv::Exception);
+    remove(cfgFile.c_str());
+    remove(weightsFile.c_str());
+}
+
 class Test_Darknet_layers : public DNNTestLayer
 {
 public:
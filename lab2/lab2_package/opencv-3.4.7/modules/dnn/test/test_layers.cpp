@@ -1343,6 +1343,108 @@ TEST(Layer_Test_PoolingIndices, Accuracy)
     normAssert(indices, outputs[1].reshape(1, 5));
 }
 
+// Max pooling without indices is compared with a naive implementation.
+// Parameters: kernel, stride, pad.
+typedef testing::TestWithParam<Vec3i> Layer_Test_MaxPooling;
+TEST_P(Layer_Test_MaxPooling, Accuracy)
+{
+    const int kernel = GetParam()[0], stride = GetParam()[1], pad = GetParam()[2];
+    LayerParams lp;
+    lp.set("pool", "max");
+    lp.set("kernel_size", kernel);
+    lp.set("stride", stride);
+    lp.set("pad", pad);
+    lp.type = "Pooling";
+    lp.name = "testLayer";
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+    // Max pooling computes indices if there are no consumers of the output.
+    LayerParams identityParams;
+    net.addLayerToPrev("identity", "Identity", identityParams);
+
+    const int inpShape[] = {2, 3, 13, 37};
+    Mat inp(4, inpShape, CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat out = net.forward();
+    ASSERT_EQ(4, out.dims);
+
+    Mat ref(4, out.size.p, CV_32F);
+    for (int n = 0; n < inpShape[0]; ++n)
+    {
+        for (int c = 0; c < inpShape[1]; ++c)
+        {
+            const float* src = inp.ptr<float>(n, c);
+            float* dst = ref.ptr<float>(n, c);
+            for (int y = 0; y < out.size[2]; ++y)
+            {
+                for (int x = 0; x < out.size[3]; ++x)
+                {
+                    float maxVal = -FLT_MAX;
+                    for (int ky = 0; ky < kernel; ++ky)
+                    {
+                        for (int kx = 0; kx < kernel; ++kx)
+                        {
+                            int sy = y * stride - pad + ky, sx = x * stride - pad + kx;
+                            if (0 <= sy && sy < inpShape[2] && 0 <= sx && sx < inpShape[3])
+                                maxVal = std::max(maxVal, src[sy * inpShape[3] + sx]);
+                        }
+                    }
+                    dst[y * out.size[3] + x] = maxVal == -FLT_MAX ? 0.f : maxVal;
+                }
+            }
+        }
+    }
+    normAssert(ref, out, "", 0, 0);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Test_MaxPooling, Values(
+    Vec3i(2, 2, 0), Vec3i(3, 2, 1), Vec3i(3, 1, 1), Vec3i(5, 1, 2),
+    Vec3i(3, 2, 0), Vec3i(2, 1, 0), Vec3i(7, 3, 2)
+));
+
+// SPPF is compared with a chain of max poolings and concatenation.
+TEST(Layer_Test_SPPF, Accuracy)
+{
+    const int kernel = 5, numPools = 3;
+    const int inpShape[] = {2, 4, 11, 19};
+    Mat inp(4, inpShape, CV_32F);
+    randu(inp, -1, 1);
+
+    LayerParams lp;
+    lp.set("kernel_size", kernel);
+    lp.set("num_pools", numPools);
+    Net net;
+    net.addLayerToPrev("sppf", "SPPF", lp);
+    net.setInput(inp);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat out = net.forward();
+
+    Net refNet;
+    LayerParams poolParams;
+    poolParams.set("pool", "max");
+    poolParams.set("kernel_size", kernel);
+    poolParams.set("stride", 1);
+    poolParams.set("pad", kernel / 2);
+    std::vector<int> poolIds(1, 0);
+    for (int i = 0; i < numPools; ++i)
+    {
+        poolIds.push_back(refNet.addLayer(format("pool%d", i), "Pooling", poolParams));
+        refNet.connect(poolIds[i], 0, poolIds[i + 1], 0);
+    }
+    LayerParams concatParams;
+    int concatId = refNet.addLayer("concat", "Concat", concatParams);
+    for (int i = 0; i <= numPools; ++i)
+        refNet.connect(poolIds[i], 0, concatId, i);
+    refNet.setInput(inp);
+    refNet.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat ref = refNet.forward("concat");
+
+    ASSERT_EQ(shape(inpShape[0], inpShape[1] * (numPools + 1), inpShape[2], inpShape[3]), shape(out));
+    normAssert(ref, out, "", 0, 0);
+}
+
 typedef testing::TestWithParam<tuple<Vec4i, int, tuple<Backend, Target> > > Layer_Test_ShuffleChannel;
 TEST_P(Layer_Test_ShuffleChannel, Accuracy)
 {
@@ -1386,6 +1488,124 @@ INSTANTIATE_TEST_CASE_P(/**/, Layer_Test_ShuffleChannel, Combine(
 /*group*/        Values(1, 2, 3, 6), dnnBackendsAndTargets(/*with IE*/ false)
 ));
 
+typedef testing::TestWithParam<tuple<Vec2i, std::string> > Layer_Test_Resize;
+TEST_P(Layer_Test_Resize, Accuracy)
+{
+    const Size outSize(get<0>(GetParam())[0], get<0>(GetParam())[1]);
+    const std::string interpolation = get<1>(GetParam());
+
+    LayerParams lp;
+    lp.set("width", outSize.width);
+    lp.set("height", outSize.height);
+    lp.set("interpolation", interpolation);
+    lp.type = "Resize";
+    lp.name = "testLayer";
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+
+    const int inpShape[] = {2, 3, 10, 13};
+    Mat inp(4, inpShape, CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat out = net.forward();
+    ASSERT_EQ(shape(2, 3, outSize.height, outSize.width), shape(out));
+
+    const float scaleY = (float)inpShape[2] / outSize.height;
+    const float scaleX = (float)inpShape[3] / outSize.width;
+    for (int n = 0; n < inpShape[0]; ++n)
+    {
+        for (int c = 0; c < inpShape[1]; ++c)
+        {
+            Mat inpPlane = getPlane(inp, n, c);
+            Mat ref;
+            if (interpolation == "nearest")
+                resize(inpPlane, ref, outSize, 0, 0, INTER_NEAREST);
+            else
+            {
+                ref.create(outSize, CV_32F);
+                for (int y = 0; y < outSize.height; ++y)
+                {
+                    float fy = y * scaleY;
+                    int y0 = (int)fy, y1 = std::min(y0 + 1, inpShape[2] - 1);
+                    for (int x = 0; x < outSize.width; ++x)
+                    {
+                        float fx = x * scaleX;
+                        int x0 = (int)fx, x1 = std::min(x0 + 1, inpShape[3] - 1);
+                        float top = inpPlane.at<float>(y0, x0) + (fx - x0) * (inpPlane.at<float>(y0, x1) - inpPlane.at<float>(y0, x0));
+                        float bottom = inpPlane.at<float>(y1, x0) + (fx - x0) * (inpPlane.at<float>(y1, x1) - inpPlane.at<float>(y1, x0));
+                        ref.at<float>(y, x) = top + (fy - y0) * (bottom - top);
+                    }
+                }
+            }
+            normAssert(ref, getPlane(out, n, c), "", 1e-6, 1e-5);
+        }
+    }
+}
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Test_Resize, Combine(
+/*output size*/  Values(Vec2i(26, 20), Vec2i(39, 30), Vec2i(17, 13), Vec2i(6, 5), Vec2i(13, 21)),
+/*interpolation*/Values("nearest", "bilinear")
+));
+
+typedef testing::TestWithParam<bool> Layer_Test_Region;
+TEST_P(Layer_Test_Region, Accuracy)
+{
+    const bool useSoftmax = GetParam();
+    const int batch = 2, rows = 5, cols = 7, anchors = 3, classes = 10, cellSize = classes + 5;
+    const float thresh = 0.3f;
+
+    LayerParams lp;
+    lp.set("classes", classes);
+    lp.set("anchors", anchors);
+    lp.set("softmax", useSoftmax);
+    lp.set("logistic", !useSoftmax);
+    lp.set("thresh", thresh);
+    lp.set("nms_threshold", 0.0f);
+    Mat biases(1, 2 * anchors, CV_32F);
+    randu(biases, 1, 5);
+    lp.blobs.push_back(biases);
+    lp.type = "Region";
+    lp.name = "testLayer";
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+
+    const int inpShape[] = {batch, rows, cols, anchors * cellSize};
+    Mat inp(4, inpShape, CV_32F);
+    randu(inp, -4, 4);
+    net.setInput(inp);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat out = net.forward();
+    ASSERT_EQ(shape(batch, rows * cols * anchors, cellSize), shape(out));
+
+    Mat ref(out.dims, out.size.p, CV_32F);
+    const float* src = inp.ptr<float>();
+    float* dst = ref.ptr<float>();
+    for (int b = 0; b < batch; ++b)
+    for (int y = 0; y < rows; ++y)
+    for (int x = 0; x < cols; ++x)
+    for (int a = 0; a < anchors; ++a, src += cellSize, dst += cellSize)
+    {
+        dst[0] = (x + 1.0f / (1.0f + std::exp(-src[0]))) / cols;
+        dst[1] = (y + 1.0f / (1.0f + std::exp(-src[1]))) / rows;
+        dst[2] = std::exp(src[2]) * biases.at<float>(2 * a) / cols;
+        dst[3] = std::exp(src[3]) * biases.at<float>(2 * a + 1) / rows;
+        dst[4] = 1.0f / (1.0f + std::exp(-src[4]));
+        float sum = 0;
+        for (int c = 0; c < classes; ++c)
+        {
+            dst[5 + c] = useSoftmax ? std::exp(src[5 + c]) : 1.0f / (1.0f + std::exp(-src[5 + c]));
+            sum += dst[5 + c];
+        }
+        for (int c = 0; c < classes; ++c)
+        {
+            float prob = dst[4] * dst[5 + c] / (useSoftmax ? sum : 1.0f);
+            dst[5 + c] = prob > thresh ? prob : 0;
+        }
+    }
+    normAssert(ref, out, "", 1e-6, 1e-5);
+}
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Test_Region, testing::Bool());
+
 // Check if relu is not fused to convolution if we requested it's output
 TEST(Layer_Test_Convolution, relu_fusion)
 {
@@ -1418,4 +1638,327 @@ TEST(Layer_Test_Convolution, relu_fusion)
     normAssert(input, output);
 }
 
+// Swish fused into convolution must match its x * sigmoid(x) decomposition
+TEST(Layer_Test_Convolution, swish_fusion)
+{
+    LayerParams convParams;
+    convParams.set("kernel_size", 3);
+    convParams.set("num_output", 4);
+    convParams.set("pad", 1);
+    convParams.type = "Convolution";
+    convParams.name = "testConv";
+    int weightsShape[] = {4, 3, 3, 3};
+    Mat weights(4, &weightsShape[0], CV_32F);
+    randu(weights, -1.0f, 1.0f);
+    Mat bias(1, 4, CV_32F);
+    randu(bias, -1.0f, 1.0f);
+    convParams.blobs.push_back(weights);
+    convParams.blobs.push_back(bias);
+
+    Net net;
+    net.addLayerToPrev(convParams.name, convParams.type, convParams);
+    LayerParams swishParams;
+    net.addLayerToPrev("testSwish", "Swish", swishParams);
+
+    Net refNet;
+    int convId = refNet.addLayerToPrev(convParams.name, convParams.type, convParams);
+    LayerParams sigmoidParams;
+    int sigmoidId = refNet.addLayerToPrev("testSigmoid", "Sigmoid", sigmoidParams);
+    LayerParams mulParams;
+    mulParams.set("operation", "prod");
+    int mulId = refNet.addLayer("testMul", "Eltwise", mulParams);
+    refNet.connect(convId, 0, mulId, 0);
+    refNet.connect(sigmoidId, 0, mulId, 1);
+
+    int sz[] = {1, 3, 8, 8};
+    Mat input(4, &sz[0], CV_32F);
+    randu(input, -1.0f, 1.0f);
+
+    net.setInput(input);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat out = net.forward();
+
+    refNet.setInput(input);
+    refNet.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat ref = refNet.forward();
+
+    normAssert(ref, out);
+}
+
+// Weights of convolution and fully connected layers are kept in half precision
+TEST(Layer_Test_Convolution, fp16_weights)
+{
+    Net net;
+    std::vector<Mat> weightsList, weightsRef;
+    const int numChannels[] = {3, 70, 16};
+    for (int i = 0; i < 2; ++i)
+    {
+        LayerParams lp;
+        lp.set("kernel_size", 3);
+        lp.set("num_output", numChannels[i + 1]);
+        lp.set("pad", 1);
+        lp.set("bias_term", true);
+        lp.type = "Convolution";
+        lp.name = format("testConv%d", i);
+        int weightsShape[] = {numChannels[i + 1], numChannels[i], 3, 3};
+        Mat weights(4, &weightsShape[0], CV_32F);
+        randu(weights, -0.5f, 0.5f);
+        Mat bias(1, numChannels[i + 1], CV_32F);
+        randu(bias, -0.5f, 0.5f);
+        lp.blobs.push_back(weights);
+        lp.blobs.push_back(bias);
+        net.addLayerToPrev(lp.name, lp.type, lp);
+        weightsList.push_back(weights);
+        weightsRef.push_back(weights.clone());
+
+        LayerParams reluParams;
+        net.addLayerToPrev(format("testReLU%d", i), "ReLU", reluParams);
+    }
+    LayerParams fcParams;
+    fcParams.set("num_output", 10);
+    fcParams.set("bias_term", false);
+    fcParams.type = "InnerProduct";
+    fcParams.name = "testFC";
+    Mat fcWeights(10, 16 * 8 * 8, CV_32F);
+    randu(fcWeights, -0.1f, 0.1f);
+    fcParams.blobs.push_back(fcWeights);
+    net.addLayerToPrev(fcParams.name, fcParams.type, fcParams);
+    weightsList.push_back(fcWeights);
+    weightsRef.push_back(fcWeights.clone());
+
+    int sz[] = {2, 3, 8, 8};
+    Mat input(4, &sz[0], CV_32F);
+    randu(input, -1.0f, 1.0f);
+    net.setInput(input);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    Mat ref = net.forward().clone();
+    Mat refConv = net.forward("testConv1").clone();
+
+    net.setPreferableTarget(DNN_TARGET_CPU_FP16);
+    Mat out = net.forward().clone();
+    Mat outConv = net.forward("testConv1").clone();
+    normAssert(refConv, outConv, "conv", 4e-3, 2e-2);
+    normAssert(ref, out, "fc", 4e-3, 2e-2);
+
+    // Learned parameters, and the weights they share with the caller, stay unchanged.
+    for (size_t i = 0; i < weightsList.size(); ++i)
+    {
+        EXPECT_EQ(0, cvtest::norm(weightsRef[i], weightsList[i], NORM_INF)) << i;
+    }
+    EXPECT_EQ(CV_32F, net.getParam(net.getLayerId("testConv1")).depth());
+    EXPECT_EQ(CV_32F, net.getParam(net.getLayerId("testFC")).depth());
+
+    Net cloned = net.clone();
+    cloned.setInput(input);
+    normAssert(out, cloned.forward(), "clone", 0, 0);
+
+    net.setPreferableTarget(DNN_TARGET_CPU);
+    out = net.forward();
+    normAssert(ref, out, "fp32", 0, 0);
+}
+
+
+static float sigmoid(float x) { return 1.f / (1.f + std::exp(-x)); }
+
+// Raw head value of attribute k of anchor a in cell (y, x)
+static float getHeadValue(const Mat& head, int b, int a, int k, int y, int x)
+{
+    if (head.dims == 4)
+    {
+        int cellSize = head.size[1] / 3;
+        int idx[] = {b, a * cellSize + k, y, x};
+        return head.at<float>(idx);
+    }
+    int idx[] = {b, a, y, x, k};
+    return head.at<float>(idx);
+}
+
+// Decodes every anchor with activations and filters them afterwards
+static void refYoloDetections(const std::vector<Mat>& heads, const std::vector<float>& anchors,
+                              const std::vector<float>& strides, bool yolov5,
+                              float confThreshold, float nmsThreshold, Mat& ref)
+{
+    const int numAnchors = 3;
+    std::vector<float> rows;
+    for (int b = 0; b < heads[0].size[0]; ++b)
+    {
+        std::vector<Rect2d> boxes;
+        std::vector<float> scores;
+        std::vector<int> classIds, indices;
+        for (size_t i = 0; i < heads.size(); ++i)
+        {
+            const Mat& head = heads[i];
+            const int h = head.size[2], w = head.size[3];
+            const int classes = (head.dims == 4 ? head.size[1] / numAnchors : head.size[4]) - 5;
+            const float stride = strides[i];
+            for (int a = 0; a < numAnchors; ++a)
+            for (int y = 0; y < h; ++y)
+            for (int x = 0; x < w; ++x)
+            {
+                float v[5];
+                for (int k = 0; k < 5; ++k)
+                    v[k] = getHeadValue(head, b, a, k, y, x);
+                float cx, cy, bw, bh;
+                float anchorW = anchors[2 * (i * numAnchors + a)], anchorH = anchors[2 * (i * numAnchors + a) + 1];
+                if (yolov5)
+                {
+                    cx = (x + 2 * sigmoid(v[0]) - 0.5f) * stride;
+                    cy = (y + 2 * sigmoid(v[1]) - 0.5f) * stride;
+                    bw = 4 * sigmoid(v[2]) * sigmoid(v[2]) * anchorW;
+                    bh = 4 * sigmoid(v[3]) * sigmoid(v[3]) * anchorH;
+                }
+                else
+                {
+                    cx = (x + sigmoid(v[0])) * stride;
+                    cy = (y + sigmoid(v[1])) * stride;
+                    bw = std::exp(v[2]) * anchorW;
+                    bh = std::exp(v[3]) * anchorH;
+                }
+                int classId = 0;
+                float conf = 0;
+                for (int c = 0; c < classes; ++c)
+                {
+                    float score = sigmoid(v[4]) * sigmoid(getHeadValue(head, b, a, 5 + c, y, x));
+                    if (score > conf)
+                    {
+                        conf = score;
+                        classId = c;
+                    }
+                }
+                if (conf <= confThreshold)
+                    continue;
+                float normW = w * stride, normH = h * stride;
+                boxes.push_back(Rect2d((cx - 0.5f * bw) / normW, (cy - 0.5f * bh) / normH, bw / normW, bh / normH));
+                scores.push_back(conf);
+                classIds.push_back(classId);
+            }
+        }
+        NMSBoxesBatched(boxes, scores, classIds, confThreshold, nmsThreshold, indices);
+        for (size_t i = 0; i < indices.size(); ++i)
+        {
+            const Rect2d& box = boxes[indices[i]];
+            float row[] = {(float)b, (float)classIds[indices[i]], scores[indices[i]],
+                           (float)box.x, (float)box.y, (float)(box.x + box.width), (float)(box.y + box.height)};
+            rows.insert(rows.end(), row, row + 7);
+        }
+    }
+    Mat(rows, true).reshape(1, (int)rows.size() / 7).copyTo(ref);
+}
+
+typedef testing::TestWithParam<bool> Layer_Test_YoloDetectionOutput;
+TEST_P(Layer_Test_YoloDetectionOutput, Accuracy)
+{
+    const bool yolov5 = GetParam();
+    const int numClasses = 4, batch = 2;
+    const int sizes[] = {8, 4};
+    float anchorsData[] = {10, 13, 16, 30, 33, 23, 30, 61, 62, 45, 59, 119};
+    float stridesData[] = {8, 16};
+    std::vector<float> anchors(anchorsData, anchorsData + 12), strides(stridesData, stridesData + 2);
+    const float confThreshold = 0.3f, nmsThreshold = 0.45f;
+
+    LayerParams lp;
+    lp.type = "YoloDetectionOutput";
+    lp.name = "testLayer";
+    lp.set("decode", yolov5 ? "yolov5" : "darknet");
+    lp.set("anchors", DictValue::arrayReal(anchorsData, 12));
+    lp.set("strides", DictValue::arrayReal(stridesData, 2));
+    lp.set("confidence_threshold", confThreshold);
+    lp.set("nms_threshold", nmsThreshold);
+    lp.set("keep_top_k", 500);
+
+    Net net;
+    int id = net.addLayer(lp.name, lp.type, lp);
+    std::vector<String> inpNames(2);
+    inpNames[0] = "head_0";
+    inpNames[1] = "head_1";
+    net.setInputsNames(inpNames);
+    net.connect(0, 0, id, 0);
+    net.connect(0, 1, id, 1);
+
+    std::vector<Mat> heads(2);
+    for (int i = 0; i < 2; ++i)
+    {
+        if (yolov5)
+        {
+            int shape[] = {batch, 3, sizes[i], sizes[i], 5 + numClasses};
+            heads[i].create(5, shape, CV_32F);
+        }
+        else
+        {
+            int shape[] = {batch, 3 * (5 + numClasses), sizes[i], sizes[i]};
+            heads[i].create(4, shape, CV_32F);
+        }
+        randu(heads[i], -3.0f, 3.0f);
+        net.setInput(heads[i], inpNames[i]);
+    }
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat out = net.forward();
+    ASSERT_EQ(out.total(), (size_t)batch * 500 * 7);
+    out = out.reshape(1, (int)out.total() / 7);
+
+    Mat ref;
+    refYoloDetections(heads, anchors, strides, yolov5, confThreshold, nmsThreshold, ref);
+    ASSERT_GT(ref.rows, 0);
+    ASSERT_LT(ref.rows, out.rows);
+    normAssert(ref, out.rowRange(0, ref.rows), "", 1e-5, 1e-5);
+    EXPECT_EQ(0, countNonZero(out.rowRange(ref.rows, out.rows)));
+}
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Test_YoloDetectionOutput, testing::Bool());
+
+// keep_top_k limits the detections after NMS: a crowd of overlapping candidates
+// with the highest scores must not push out the other objects.
+TEST(Layer_Test_YoloDetectionOutput_Dense, keep_top_k)
+{
+    const int numCrowd = 20, numObjects = 3, keepTopK = 4;
+    const int shape[] = {1, numCrowd + numObjects, 6};
+    Mat inp(3, shape, CV_32F, Scalar(0));
+    for (int i = 0; i < numCrowd + numObjects; ++i)
+    {
+        float* row = inp.ptr<float>(0, i);
+        // [cx, cy, w, h, objectness, class score]
+        const bool crowd = i < numCrowd;
+        row[0] = crowd ? 10.f + 0.1f * i : 100.f * (i - numCrowd + 1);
+        row[1] = 10.f;
+        row[2] = row[3] = 10.f;
+        row[4] = crowd ? 0.99f - 0.001f * i : 0.9f - 0.1f * (i - numCrowd);
+        row[5] = 1.f;
+    }
+
+    LayerParams lp;
+    lp.type = "YoloDetectionOutput";
+    lp.name = "testLayer";
+    lp.set("decode", "none");
+    lp.set("nms_threshold", 0.5f);
+    lp.set("keep_top_k", keepTopK);
+
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+    net.setInput(inp);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat out = net.forward();
+    ASSERT_EQ(out.total(), (size_t)keepTopK * 7);
+    out = out.reshape(1, keepTopK);
+
+    // The best box of the crowd and all the separate objects.
+    const float refCx[] = {10.f, 100.f, 200.f, 300.f};
+    for (int i = 0; i < keepTopK; ++i)
+    {
+        EXPECT_EQ(0.f, out.at<float>(i, 1)) << i;
+        EXPECT_NEAR(i == 0 ? 0.99f : 0.9f - 0.1f * (i - 1), out.at<float>(i, 2), 1e-6) << i;
+        EXPECT_NEAR(refCx[i] - 5.f, out.at<float>(i, 3), 1e-4) << i;
+        EXPECT_NEAR(refCx[i] + 5.f, out.at<float>(i, 5), 1e-4) << i;
+    }
+
+    // Fewer candidates are suppressed if NMS sees only a part of them.
+    lp.set("top_k", 2);
+    Net netTopK;
+    netTopK.addLayerToPrev(lp.name, lp.type, lp);
+    netTopK.setInput(inp);
+    netTopK.setPreferableBackend(DNN_BACKEND_OPENCV);
+    out = netTopK.forward().reshape(1, keepTopK);
+    EXPECT_NEAR(0.99f, out.at<float>(0, 2), 1e-6);
+    EXPECT_EQ(0, countNonZero(out.rowRange(1, keepTopK)));
+}
+
 }} // namespace
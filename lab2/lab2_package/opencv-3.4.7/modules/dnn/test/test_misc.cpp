@@ -9,6 +9,7 @@
 #include <opencv2/core/ocl.hpp>
 #include <opencv2/core/opencl/ocl_defs.hpp>
 #include <opencv2/dnn/layer.details.hpp>  // CV_DNN_REGISTER_LAYER_CLASS
+#include <opencv2/dnn/shape_utils.hpp>
 
 namespace opencv_test { namespace {
 
@@ -360,6 +361,522 @@ TEST(Net, forwardAndRetrieve)
     normAssert(outBlobs[0][1], inp.rowRange(2, 4), "second part");
 }
 
+TEST(Net, clone)
+{
+    LayerParams lp;
+    lp.set("kernel_size", 3);
+    lp.set("num_output", 4);
+    lp.set("pad", 1);
+    lp.set("bias_term", false);
+    int weightsShape[] = {4, 2, 3, 3};
+    Mat weights(4, &weightsShape[0], CV_32F);
+    randu(weights, -1, 1);
+    lp.blobs.push_back(weights);
+
+    Net net;
+    int convId = net.addLayerToPrev("conv", "Convolution", lp);
+    LayerParams reluParams;
+    net.addLayerToPrev("relu", "ReLU", reluParams);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    int inpShape[] = {1, 2, 5, 5};
+    Mat inp(4, &inpShape[0], CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    Mat ref = net.forward();
+
+    Net copy = net.clone();
+    ASSERT_FALSE(copy.empty());
+    EXPECT_EQ(net.getLayerNames(), copy.getLayerNames());
+    EXPECT_EQ(net.getParam(convId).data, copy.getParam(convId).data);
+
+    copy.setInput(inp);
+    Mat out = copy.forward();
+    EXPECT_NE(ref.data, out.data);
+    normAssert(ref, out);
+}
+
+TEST(Net, memoryPlan)
+{
+    // Chain of layers with the same output shapes needs only two alternating buffers.
+    Net net;
+    for (int i = 0; i < 4; ++i)
+    {
+        LayerParams lp;
+        lp.set("kernel_size", 1);
+        lp.set("num_output", 8);
+        lp.set("bias_term", false);
+        int weightsShape[] = {8, 8, 1, 1};
+        Mat weights(4, &weightsShape[0], CV_32F);
+        randu(weights, -1, 1);
+        lp.blobs.push_back(weights);
+        net.addLayerToPrev(format("conv%d", i), "Convolution", lp);
+    }
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    MatShape inpShape = shape(1, 8, 16, 16);
+    size_t weights = 0, blobs = 0, plannedBlobs = 0;
+    net.getMemoryConsumption(std::vector<MatShape>(1, inpShape), weights, blobs, plannedBlobs);
+    EXPECT_EQ(4 * 8 * 8 * sizeof(float), weights);
+    EXPECT_EQ(5 * total(inpShape) * sizeof(float), blobs);
+    EXPECT_EQ(2 * total(inpShape) * sizeof(float), plannedBlobs);
+
+    Mat inp(inpShape, CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    Mat out = net.forward().clone();
+
+    Net ref = net.clone();
+    ref.enableFusion(false);
+    ref.setInput(inp);
+    normAssert(ref.forward(), out);
+}
+
+TEST(Net, layersProfile)
+{
+    Net net;
+    LayerParams lp;
+    lp.set("kernel_size", 3);
+    lp.set("num_output", 4);
+    lp.set("bias_term", false);
+    int weightsShape[] = {4, 3, 3, 3};
+    Mat weights(4, &weightsShape[0], CV_32F);
+    randu(weights, -1, 1);
+    lp.blobs.push_back(weights);
+    net.addLayerToPrev("conv", "Convolution", lp);
+    LayerParams reluParams;
+    net.addLayerToPrev("relu", "ReLU", reluParams);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    std::vector<LayerProfile> profile;
+    EXPECT_EQ(0, net.getLayersProfile(profile));
+    EXPECT_TRUE(profile.empty());
+
+    MatShape inpShape = shape(1, 3, 10, 10);
+    Mat inp(inpShape, CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    net.forward();
+
+    std::vector<double> timings;
+    int64 totalTicks = net.getLayersProfile(profile);
+    EXPECT_EQ(net.getPerfProfile(timings), totalTicks);
+    ASSERT_EQ(2u, profile.size());
+
+    const LayerProfile& conv = profile[0];
+    EXPECT_EQ("conv", conv.name);
+    EXPECT_EQ("Convolution", conv.type);
+    EXPECT_EQ((int64)timings[0], conv.ticks);
+    EXPECT_EQ(net.getFLOPS(net.getLayerId("conv"), inpShape), conv.flops);
+    EXPECT_EQ((total(inpShape) + weights.total()) * sizeof(float), conv.bytesRead);
+    EXPECT_EQ(4 * 8 * 8 * sizeof(float), conv.bytesWritten);
+    EXPECT_EQ(conv.bytesWritten, conv.allocatedBytes);
+    EXPECT_FALSE(conv.kernel.empty());
+
+    // ReLU is fused into convolution.
+    const LayerProfile& relu = profile[1];
+    EXPECT_EQ("relu", relu.name);
+    EXPECT_EQ("fused", relu.kernel);
+    EXPECT_EQ(0, relu.ticks);
+    EXPECT_EQ(0u, relu.allocatedBytes);
+
+    FileStorage fs(net.dumpProfile(true), FileStorage::READ | FileStorage::MEMORY | FileStorage::FORMAT_JSON);
+    FileNode events = fs["traceEvents"];
+    ASSERT_EQ(2u, events.size());
+    EXPECT_EQ("conv", (String)events[0]["name"]);
+    EXPECT_EQ("X", (String)events[0]["ph"]);
+    EXPECT_EQ(conv.kernel, (String)events[0]["args"]["kernel"]);
+
+    fs.open(net.dumpProfile(), FileStorage::READ | FileStorage::MEMORY | FileStorage::FORMAT_JSON);
+    FileNode layers = fs["layers"];
+    ASSERT_EQ(2u, layers.size());
+    EXPECT_EQ("relu", (String)layers[1]["name"]);
+    EXPECT_EQ((double)conv.flops, (double)layers[0]["flops"]);
+
+    // Layers which aren't computed by the latest pass have no timings.
+    net.enableFusion(false);
+    net.forward();
+    net.getLayersProfile(profile);
+    ASSERT_EQ(2u, profile.size());
+    EXPECT_FALSE(profile[1].kernel.empty());
+    net.forward("conv");
+    net.getLayersProfile(profile);
+    ASSERT_EQ(2u, profile.size());
+    EXPECT_EQ(0, profile[1].ticks);
+    EXPECT_TRUE(profile[1].kernel.empty());
+
+    EXPECT_THROW(net.dumpProfileToFile(tempfile() + "/profile.json"), cv::Exception);
+}
+
+TEST(Net, cache)
+{
+    Net net;
+    {
+        LayerParams lp;
+        lp.set("kernel_size", 3);
+        lp.set("num_output", 4);
+        lp.set("pad", 1);
+        int weightsShape[] = {4, 3, 3, 3};
+        Mat weights(4, &weightsShape[0], CV_32F);
+        randu(weights, -1, 1);
+        Mat bias(1, 4, CV_32F);
+        randu(bias, -1, 1);
+        lp.blobs.push_back(weights);
+        lp.blobs.push_back(bias);
+        net.addLayerToPrev("conv", "Convolution", lp);
+    }
+    {
+        LayerParams lp;
+        lp.set("negative_slope", 0.1);
+        net.addLayerToPrev("relu", "ReLU", lp);
+    }
+    {
+        LayerParams lp;
+        lp.set("pool", "max");
+        lp.set("kernel_size", 2);
+        lp.set("stride", 2);
+        net.addLayerToPrev("pool", "Pooling", lp);
+    }
+    {
+        LayerParams lp;
+        lp.set("num_output", 5);
+        Mat weights(5, 4 * 4 * 4, CV_32F);
+        randu(weights, -1, 1);
+        lp.blobs.push_back(weights);
+        lp.blobs.push_back(Mat::zeros(1, 5, CV_32F));
+        net.addLayerToPrev("fc", "InnerProduct", lp);
+    }
+    net.setInputsNames(std::vector<String>(1, "data"));
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    Mat inp(std::vector<int>(shape(2, 3, 8, 8)), CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    Mat ref = net.forward().clone();
+
+    const String path = cv::tempfile(".dnncache");
+    net.writeCache(path);
+    {
+        Net cached = readNet(path);
+        ASSERT_FALSE(cached.empty());
+        EXPECT_EQ(net.getLayerNames(), cached.getLayerNames());
+        EXPECT_EQ(net.getLayerId("conv"), cached.getLayerId("conv"));
+        EXPECT_EQ("Pooling", cached.getLayer(cached.getLayerId("pool"))->type);
+
+        // Clones keep the mapped weights alive.
+        Net copy = cached.clone();
+        cached = Net();
+        copy.setInput(inp, "data");
+        normAssert(ref, copy.forward(), "", 0, 0);
+    }
+
+    // Truncated file
+    {
+        std::vector<char> content;
+        {
+            std::ifstream ifs(path.c_str(), std::ios::binary);
+            content.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+        }
+        std::ofstream ofs(path.c_str(), std::ios::binary | std::ios::trunc);
+        ofs.write(&content[0], content.size() / 2);
+    }
+    EXPECT_THROW(readNetFromCache(path), cv::Exception);
+    remove(path.c_str());
+}
+
+static Net createFullyConvNet(const Mat& weights1, const Mat& weights2)
+{
+    Net net;
+    {
+        // In-place on the network input.
+        LayerParams lp;
+        lp.set("negative_slope", 0.5);
+        net.addLayerToPrev("relu0", "ReLU", lp);
+    }
+    {
+        LayerParams lp;
+        lp.set("kernel_size", 3);
+        lp.set("num_output", weights1.size[0]);
+        lp.set("pad", 1);
+        lp.set("bias_term", false);
+        lp.blobs.push_back(weights1);
+        net.addLayerToPrev("conv1", "Convolution", lp);
+    }
+    {
+        LayerParams lp;
+        net.addLayerToPrev("relu1", "ReLU", lp);
+    }
+    {
+        LayerParams lp;
+        lp.set("pool", "max");
+        lp.set("kernel_size", 2);
+        lp.set("stride", 2);
+        net.addLayerToPrev("pool", "Pooling", lp);
+    }
+    {
+        LayerParams lp;
+        lp.set("kernel_size", 1);
+        lp.set("num_output", weights2.size[0]);
+        lp.set("bias_term", false);
+        lp.blobs.push_back(weights2);
+        net.addLayerToPrev("conv2", "Convolution", lp);
+    }
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    return net;
+}
+
+TEST(Net, allocation_plans)
+{
+    int weightsShape1[] = {8, 3, 3, 3};
+    int weightsShape2[] = {4, 8, 1, 1};
+    Mat weights1(4, &weightsShape1[0], CV_32F), weights2(4, &weightsShape2[0], CV_32F);
+    randu(weights1, -1, 1);
+    randu(weights2, -1, 1);
+
+    Net net = createFullyConvNet(weights1, weights2);
+    net.setMaxAllocationPlans(2);
+    net.prepareAllocationPlan(std::vector<MatShape>(1, shape(1, 3, 24, 24)));
+
+    const int sizes[] = {16, 24, 32, 24, 16, 24};
+    std::map<int, const uchar*> outputData;
+    for (int i = 0; i < 6; ++i)
+    {
+        Mat inp(std::vector<int>(shape(1, 3, sizes[i], sizes[i])), CV_32F);
+        randu(inp, -1, 1);
+
+        Net refNet = createFullyConvNet(weights1, weights2);
+        refNet.setInput(inp);
+        Mat ref = refNet.forward();
+
+        net.setInput(inp);
+        Mat out = net.forward();
+        normAssert(ref, out, format("size %d", sizes[i]).c_str(), 1e-5, 1e-4);
+
+        // 24x24 plan is used every second pass so it's never evicted.
+        if (sizes[i] == 24 && outputData.count(24))
+        {
+            EXPECT_EQ(outputData[24], out.data);
+        }
+        outputData[sizes[i]] = out.data;
+    }
+}
+
+// Intermediate blobs are placed into the memory arena of the network. An output
+// returned by forward() has to stay valid after the network is released.
+TEST(Net, memoryArena_outputOwnership)
+{
+    int weightsShape1[] = {8, 3, 3, 3};
+    int weightsShape2[] = {4, 8, 1, 1};
+    Mat weights1(4, &weightsShape1[0], CV_32F), weights2(4, &weightsShape2[0], CV_32F);
+    randu(weights1, -1, 1);
+    randu(weights2, -1, 1);
+    Mat inp(shape(1, 3, 24, 24), CV_32F);
+    randu(inp, -1, 1);
+
+    Mat out, ref;
+    {
+        Net net = createFullyConvNet(weights1, weights2);
+        net.setInput(inp);
+        out = net.forward();
+        ref = out.clone();
+    }
+    ASSERT_TRUE(out.u != NULL);
+
+    // Memory of the released network would be reused by the new one.
+    Net net = createFullyConvNet(weights1, weights2);
+    Mat inp2(shape(1, 3, 48, 48), CV_32F);
+    randu(inp2, -1, 1);
+    net.setInput(inp2);
+    net.forward();
+    normAssert(ref, out);
+}
+
+// Detects bounding box of bright pixels of every image in a batch.
+class BrightSpotDetectorLayer CV_FINAL : public Layer
+{
+public:
+    BrightSpotDetectorLayer(const LayerParams &params) : Layer(params)
+    {
+        normalized = params.get<bool>("normalized", false);
+    }
+
+    static Ptr<Layer> create(LayerParams& params)
+    {
+        return Ptr<Layer>(new BrightSpotDetectorLayer(params));
+    }
+
+    bool getMemoryShapes(const std::vector<MatShape> &inputs, const int,
+                         std::vector<MatShape> &outputs, std::vector<MatShape> &) const CV_OVERRIDE
+    {
+        outputs.assign(1, shape(1, 1, inputs[0][0], 7));
+        return false;
+    }
+
+    void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays) CV_OVERRIDE
+    {
+        std::vector<Mat> inputs, outputs;
+        inputs_arr.getMatVector(inputs);
+        outputs_arr.getMatVector(outputs);
+        const int h = inputs[0].size[2], w = inputs[0].size[3];
+        for (int b = 0; b < inputs[0].size[0]; ++b)
+        {
+            Mat mask = Mat(h, w, CV_32F, inputs[0].ptr<float>(b, 0)) > 0.5f;
+            Rect box = boundingRect(mask);
+            const float sx = normalized ? 1.f / w : 1.f, sy = normalized ? 1.f / h : 1.f;
+            float row[] = {(float)b, 0, std::min(1.f, countNonZero(mask) / 400.f),
+                           box.x * sx, box.y * sy, box.br().x * sx, box.br().y * sy};
+            std::copy(row, row + 7, outputs[0].ptr<float>(0, 0, b));
+        }
+    }
+
+    bool normalized;
+};
+
+TEST(TiledDetector, getTiles)
+{
+    TiledDetector detector(Net(), Size(640, 640), 64);
+    std::vector<Rect> tiles = detector.getTiles(Size(1920, 1080));
+    ASSERT_EQ(8u, tiles.size());
+    EXPECT_EQ(Rect(0, 0, 640, 640), tiles[0]);
+    EXPECT_EQ(Rect(1280, 440, 640, 640), tiles[7]);
+    for (size_t i = 0; i + 1 < tiles.size(); ++i)
+    {
+        if (tiles[i].y == tiles[i + 1].y)
+        {
+            EXPECT_GE(tiles[i].br().x - tiles[i + 1].x, 64);
+        }
+    }
+
+    tiles = detector.getTiles(Size(320, 240));
+    ASSERT_EQ(1u, tiles.size());
+    EXPECT_EQ(Rect(0, 0, 320, 240), tiles[0]);
+}
+
+TEST(TiledDetector, detect)
+{
+    CV_DNN_REGISTER_LAYER_CLASS(BrightSpotDetector, BrightSpotDetectorLayer);
+    Net net;
+    LayerParams lp;
+    net.addLayerToPrev("detector", "BrightSpotDetector", lp);
+
+    Mat frame(1080, 1920, CV_8UC3, Scalar::all(0));
+    // Inside of overlapping tiles. The test detector merges all the spots of
+    // an image so none of the tiles (and not the full image) has both of them.
+    frame(Rect(1500, 800, 20, 20)).setTo(Scalar::all(255));
+    // Crosses the right border of the first tile.
+    frame(Rect(630, 200, 20, 20)).setTo(Scalar::all(255));
+
+    for (int maxBatchSize = 0; maxBatchSize <= 1; ++maxBatchSize)
+    {
+        TiledDetector detector(net, Size(640, 640), 64);
+        detector.setInputParams(1.0 / 255).setThresholds(0.05f, 0.4f).setMaxBatchSize(maxBatchSize)
+                .setIncludeFullImage(false).setNormalizedCoordinates(false);
+
+        std::vector<int> classIds;
+        std::vector<float> confidences;
+        std::vector<Rect> boxes;
+        detector.detect(frame, classIds, confidences, boxes);
+        ASSERT_EQ(2u, boxes.size()) << maxBatchSize;
+        std::sort(boxes.begin(), boxes.end(), [](const Rect& a, const Rect& b) { return a.x < b.x; });
+        EXPECT_EQ(Rect(630, 200, 20, 20), boxes[0]);
+        EXPECT_EQ(Rect(1500, 800, 20, 20), boxes[1]);
+        EXPECT_EQ(1.f, confidences[0]);
+        EXPECT_EQ(1.f, confidences[1]);
+    }
+    LayerFactory::unregisterLayer("BrightSpotDetector");
+}
+
+// An object wider than the overlap crosses the seam between the first two tiles,
+// [427, 640) is shared by them. Its parts are merged instead of being dropped.
+TEST(TiledDetector, detect_across_seam)
+{
+    CV_DNN_REGISTER_LAYER_CLASS(BrightSpotDetector, BrightSpotDetectorLayer);
+    Net net;
+    LayerParams lp;
+    lp.set("normalized", true);
+    net.addLayerToPrev("detector", "BrightSpotDetector", lp);
+
+    Mat frame(1080, 1920, CV_8UC3, Scalar::all(0));
+    const Rect object(300, 200, 500, 20);
+    frame(object).setTo(Scalar::all(255));
+
+    for (int includeFullImage = 1; includeFullImage >= 0; --includeFullImage)
+    {
+        TiledDetector detector(net, Size(640, 640), 64);
+        detector.setInputParams(1.0 / 255).setThresholds(0.05f, 0.4f);
+        if (!includeFullImage)
+            detector.setIncludeFullImage(false);
+
+        std::vector<int> classIds;
+        std::vector<float> confidences;
+        std::vector<Rect> boxes;
+        detector.detect(frame, classIds, confidences, boxes);
+        ASSERT_EQ(1u, boxes.size()) << includeFullImage;
+        EXPECT_EQ(1.f, confidences[0]);
+        // The downscaled image finds the object with an error of the scale factor.
+        if (includeFullImage)
+        {
+            EXPECT_LE(std::abs(boxes[0].x - object.x), 3);
+            EXPECT_LE(std::abs(boxes[0].br().x - object.br().x), 3);
+        }
+        else
+        {
+            EXPECT_EQ(object, boxes[0]);
+        }
+    }
+    LayerFactory::unregisterLayer("BrightSpotDetector");
+}
+
+// Blobs with long lifetimes in a branched graph: the planned arena must not
+// place any of them over a blob which is alive at the same time.
+TEST(Net, memoryPlan_branches)
+{
+    Net net;
+    std::map<String, int> ids;
+    const char* convs[][2] = {{"conv0", ""}, {"conv1a", "conv0"}, {"conv2a", "conv1a"}, {"conv1b", "conv0"}};
+    for (int i = 0; i < 4; ++i)
+    {
+        LayerParams lp;
+        lp.set("kernel_size", 1);
+        lp.set("num_output", 8);
+        lp.set("bias_term", false);
+        int weightsShape[] = {8, 8, 1, 1};
+        Mat weights(4, &weightsShape[0], CV_32F);
+        randu(weights, -1, 1);
+        lp.blobs.push_back(weights);
+        ids[convs[i][0]] = net.addLayer(convs[i][0], "Convolution", lp);
+        net.connect(*convs[i][1] ? ids[convs[i][1]] : 0, 0, ids[convs[i][0]], 0);
+    }
+    LayerParams sumParams;
+    sumParams.set("operation", "sum");
+    ids["sum"] = net.addLayer("sum", "Eltwise", sumParams);
+    net.connect(ids["conv2a"], 0, ids["sum"], 0);
+    net.connect(ids["conv1b"], 0, ids["sum"], 1);
+    net.connect(ids["conv0"], 0, ids["sum"], 2);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    // Layers are executed in the order of ids so a layer can't consume
+    // an output of the layer added after it.
+    EXPECT_ANY_THROW(net.connect(ids["sum"], 0, ids["conv1b"], 0));
+
+    Mat inp(shape(1, 8, 16, 16), CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    Mat out = net.forward("sum").clone();
+
+    // Requested outputs are never reused so all the blobs are kept apart.
+    std::vector<String> names;
+    names.push_back("conv0");
+    names.push_back("conv1a");
+    names.push_back("conv2a");
+    names.push_back("conv1b");
+    names.push_back("sum");
+    std::vector<Mat> outs;
+    net.setInput(inp);
+    net.forward(outs, names);
+    normAssert(outs[4], out);
+}
+
 #ifdef HAVE_INF_ENGINE
 static const std::chrono::milliseconds async_timeout(500);
 
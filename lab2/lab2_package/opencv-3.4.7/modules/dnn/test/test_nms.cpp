@@ -37,4 +37,155 @@ TEST(NMS, Accuracy)
         ASSERT_EQ(indices[i], ref_indices[i]);
 }
 
+static float refIoU(const Rect& a, const Rect& b)
+{
+    float inter = (float)(a & b).area();
+    return inter == 0 ? 0.f : inter / ((float)a.area() + (float)b.area() - inter);
+}
+
+// Brute-force greedy NMS
+static void refNMSBoxes(const std::vector<Rect>& bboxes, const std::vector<float>& scores,
+                        const std::vector<int>& class_ids, float score_thresh, float nms_thresh,
+                        std::vector<int>& indices)
+{
+    std::vector<std::pair<float, int> > order;
+    for (size_t i = 0; i < scores.size(); ++i)
+        if (scores[i] > score_thresh)
+            order.push_back(std::make_pair(-scores[i], (int)i));
+    std::stable_sort(order.begin(), order.end());
+    indices.clear();
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        int idx = order[i].second;
+        bool keep = true;
+        for (size_t k = 0; k < indices.size() && keep; ++k)
+            keep = class_ids[idx] != class_ids[indices[k]] || refIoU(bboxes[idx], bboxes[indices[k]]) <= nms_thresh;
+        if (keep)
+            indices.push_back(idx);
+    }
+}
+
+static void generateBoxes(int n, int numClasses, std::vector<Rect>& bboxes,
+                          std::vector<float>& scores, std::vector<int>& class_ids)
+{
+    RNG& rng = theRNG();
+    bboxes.resize(n);
+    scores.resize(n);
+    class_ids.resize(n);
+    for (int i = 0; i < n; ++i)
+    {
+        bboxes[i] = Rect(rng.uniform(0, 600), rng.uniform(0, 400), rng.uniform(1, 100), rng.uniform(1, 100));
+        scores[i] = rng.uniform(0.f, 1.f);
+        class_ids[i] = rng.uniform(0, numClasses);
+    }
+}
+
+TEST(NMS, Random)
+{
+    std::vector<Rect> bboxes;
+    std::vector<float> scores;
+    std::vector<int> class_ids, indices, ref;
+    generateBoxes(3000, 1, bboxes, scores, class_ids);
+
+    NMSBoxes(bboxes, scores, 0.1f, 0.4f, indices);
+    refNMSBoxes(bboxes, scores, class_ids, 0.1f, 0.4f, ref);
+    EXPECT_EQ(ref, indices);
+}
+
+TEST(NMS, Batched)
+{
+    std::vector<Rect> bboxes;
+    std::vector<float> scores;
+    std::vector<int> class_ids, indices, ref;
+    generateBoxes(3000, 5, bboxes, scores, class_ids);
+
+    NMSBoxesBatched(bboxes, scores, class_ids, 0.1f, 0.4f, indices);
+    refNMSBoxes(bboxes, scores, class_ids, 0.1f, 0.4f, ref);
+    EXPECT_EQ(ref, indices);
+}
+
+TEST(NMS, DIoU)
+{
+    // IoU is 70 / 130 but centers of boxes are shifted.
+    std::vector<Rect> bboxes;
+    bboxes.push_back(Rect(0, 0, 10, 10));
+    bboxes.push_back(Rect(0, 3, 10, 10));
+    std::vector<float> scores(2, 0.9f);
+    scores[1] = 0.8f;
+    std::vector<int> class_ids(2, 0), indices;
+
+    NMSBoxesBatched(bboxes, scores, class_ids, 0.5f, 0.52f, indices, 1.f, 0, NMS_IOU);
+    ASSERT_EQ(1u, indices.size());
+    EXPECT_EQ(0, indices[0]);
+
+    NMSBoxesBatched(bboxes, scores, class_ids, 0.5f, 0.52f, indices, 1.f, 0, NMS_DIOU);
+    ASSERT_EQ(2u, indices.size());
+    EXPECT_EQ(0, indices[0]);
+    EXPECT_EQ(1, indices[1]);
+}
+
+TEST(NMS, emptyBoxes)
+{
+    // Overlap of empty boxes is 1, so they aren't suppressed by a threshold of 1.
+    std::vector<Rect> bboxes(2, Rect(5, 5, 0, 0));
+    std::vector<float> scores(2, 0.9f);
+    scores[1] = 0.8f;
+    std::vector<int> indices;
+
+    NMSBoxes(bboxes, scores, 0.5f, 0.5f, indices);
+    ASSERT_EQ(1u, indices.size());
+    EXPECT_EQ(0, indices[0]);
+
+    NMSBoxes(bboxes, scores, 0.5f, 1.f, indices);
+    EXPECT_EQ(2u, indices.size());
+}
+
+TEST(SoftNMS, Random)
+{
+    std::vector<Rect> bboxes;
+    std::vector<float> scores;
+    std::vector<int> class_ids;
+    generateBoxes(500, 1, bboxes, scores, class_ids);
+    const float score_thresh = 0.3f, nms_thresh = 0.3f, sigma = 0.5f;
+
+    for (int method = SOFTNMS_LINEAR; method <= SOFTNMS_GAUSSIAN; ++method)
+    {
+        std::vector<float> updated_scores;
+        std::vector<int> indices;
+        softNMSBoxes(bboxes, scores, updated_scores, score_thresh, nms_thresh, indices, 0, sigma, method);
+        ASSERT_EQ(indices.size(), updated_scores.size());
+
+        // Brute-force reference
+        std::vector<float> current = scores;
+        std::vector<bool> done(scores.size(), false);
+        std::vector<int> ref;
+        std::vector<float> refScores;
+        for (;;)
+        {
+            int best = -1;
+            for (size_t i = 0; i < current.size(); ++i)
+                if (!done[i] && current[i] >= score_thresh && (best < 0 || current[i] > current[best]))
+                    best = (int)i;
+            if (best < 0)
+                break;
+            done[best] = true;
+            ref.push_back(best);
+            refScores.push_back(current[best]);
+            for (size_t i = 0; i < current.size(); ++i)
+            {
+                if (done[i])
+                    continue;
+                float iou = refIoU(bboxes[best], bboxes[i]);
+                if (method == SOFTNMS_LINEAR)
+                    current[i] *= iou > nms_thresh ? 1.f - iou : 1.f;
+                else
+                    current[i] *= std::exp(-(iou * iou) / sigma);
+            }
+        }
+        ASSERT_EQ(ref.size(), indices.size()) << "method=" << method;
+        EXPECT_EQ(ref, indices) << "method=" << method;
+        EXPECT_LE(cvtest::norm(refScores, updated_scores, NORM_INF), 1e-5) << "method=" << method;
+    }
+}
+
 }} // namespace
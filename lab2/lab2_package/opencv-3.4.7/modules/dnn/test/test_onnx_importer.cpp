@@ -350,6 +350,121 @@ TEST_P(Test_ONNX_layers, Softmax)
 
 INSTANTIATE_TEST_CASE_P(/*nothing*/, Test_ONNX_layers, dnnBackendsAndTargets());
 
+// Minimal serializer of ONNX messages in protobuf wire format.
+class ONNXWriter
+{
+public:
+    ONNXWriter& varint(int field, uint64_t value)
+    {
+        tag(field, 0);
+        writeVarint(value);
+        return *this;
+    }
+
+    ONNXWriter& bytes(int field, const std::string& value)
+    {
+        tag(field, 2);
+        writeVarint(value.size());
+        data += value;
+        return *this;
+    }
+
+    ONNXWriter& message(int field, const ONNXWriter& msg) { return bytes(field, msg.data); }
+
+    std::string data;
+
+private:
+    void tag(int field, int wireType) { writeVarint((uint64_t)(field << 3 | wireType)); }
+
+    void writeVarint(uint64_t value)
+    {
+        for (; value >= 0x80; value >>= 7)
+            data += (char)(value | 0x80);
+        data += (char)value;
+    }
+};
+
+static ONNXWriter onnxIntsAttribute(const std::string& name, int value, int num)
+{
+    ONNXWriter attr;
+    attr.bytes(1, name).varint(20, 7);  // AttributeProto: name, type (INTS)
+    for (int i = 0; i < num; ++i)
+        attr.varint(8, value);  // ints
+    return attr;
+}
+
+static ONNXWriter onnxTensorInfo(const std::string& name, const MatShape& shape)
+{
+    ONNXWriter dims;
+    for (size_t i = 0; i < shape.size(); ++i)
+        dims.message(1, ONNXWriter().varint(1, shape[i]));  // TensorShapeProto.dim
+    ONNXWriter tensorType;
+    tensorType.varint(1, 1).message(2, dims);  // elem_type (FLOAT), shape
+    return ONNXWriter().bytes(1, name).message(2, ONNXWriter().message(1, tensorType));
+}
+
+// YOLOv5 spatial pyramid pooling block: Concat(x, y1, y2, y3) where
+// y1 = MaxPool(x), y2 = MaxPool(y1), y3 = MaxPool(y2).
+TEST(Test_ONNX_importer, SPPF_fusion)
+{
+    const int kernel = 5;
+    const MatShape inpShape = shape(1, 8, 20, 20);
+    ONNXWriter graph;
+    const char* names[] = {"x", "y1", "y2", "y3"};
+    for (int i = 1; i < 4; ++i)
+    {
+        ONNXWriter node;
+        node.bytes(1, names[i - 1]).bytes(2, names[i]).bytes(4, "MaxPool")
+            .message(5, onnxIntsAttribute("kernel_shape", kernel, 2))
+            .message(5, onnxIntsAttribute("strides", 1, 2))
+            .message(5, onnxIntsAttribute("pads", kernel / 2, 4));
+        graph.message(1, node);
+    }
+    ONNXWriter concat;
+    for (int i = 0; i < 4; ++i)
+        concat.bytes(1, names[i]);
+    concat.bytes(2, "out").bytes(4, "Concat")
+          .message(5, ONNXWriter().bytes(1, "axis").varint(3, 1).varint(20, 2));
+    graph.message(1, concat).bytes(2, "sppf");
+    graph.message(11, onnxTensorInfo("x", inpShape));
+    graph.message(12, onnxTensorInfo("out", shape(1, 32, 20, 20)));
+    ONNXWriter model;
+    model.varint(1, 4).message(7, graph).message(8, ONNXWriter().varint(2, 9));  // ir_version, graph, opset
+
+    Net net = readNetFromONNX(model.data.data(), model.data.size());
+    ASSERT_FALSE(net.empty());
+    EXPECT_EQ(1, net.getLayersCount("SPPF"));
+    EXPECT_EQ(0, net.getLayersCount("Pooling"));
+
+    Mat inp(inpShape, CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat out = net.forward();
+
+    // Reference by poolings of the same input.
+    Mat ref(shape(1, 32, 20, 20), CV_32F);
+    Mat src = inp;
+    for (int i = 0; i < 4; ++i)
+    {
+        if (i > 0)
+        {
+            LayerParams lp;
+            lp.set("pool", "max");
+            lp.set("kernel_size", kernel);
+            lp.set("stride", 1);
+            lp.set("pad", kernel / 2);
+            Net pool;
+            pool.addLayerToPrev("pool", "Pooling", lp);
+            pool.setInput(src);
+            pool.setPreferableBackend(DNN_BACKEND_OPENCV);
+            src = pool.forward().clone();
+        }
+        src.copyTo(Mat(src.dims, src.size.p, CV_32F, ref.ptr<float>(0, 8 * i)));
+    }
+    normAssert(ref, out, "", 0, 0);
+}
+
 class Test_ONNX_nets : public Test_ONNX_layers
 {
 public:
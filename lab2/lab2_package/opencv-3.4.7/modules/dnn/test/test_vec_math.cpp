@@ -0,0 +1,186 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "test_precomp.hpp"
+#include "../src/layers/vec_math.hpp"
+
+namespace opencv_test { namespace {
+
+#if CV_SIMD128
+
+// Distance between the result and the exact value in units in the last place.
+static double ulpError(float val, double ref)
+{
+    float r = (float)ref;
+    if (val == r)
+        return 0;
+    double ulp = std::abs((double)std::nextafter(r, r < 0 ? -FLT_MAX : FLT_MAX) - (double)r);
+    return std::abs((double)val - ref) / ulp;
+}
+
+typedef v_float32x4 (*VecMathFunc)(const v_float32x4&);
+
+static double maxUlpError(VecMathFunc func, double (*ref)(double), float minVal, float maxVal)
+{
+    const int n = 1 << 20;
+    double maxErr = 0;
+    float src[4], dst[4];
+    for (int i = 0; i < n; i += 4)
+    {
+        for (int j = 0; j < 4; ++j)
+            src[j] = minVal + (maxVal - minVal) * (float)(i + j) / n;
+        v_store(dst, func(v_load(src)));
+        for (int j = 0; j < 4; ++j)
+            maxErr = std::max(maxErr, ulpError(dst[j], ref(src[j])));
+    }
+    return maxErr;
+}
+
+static double refExp(double x) { return std::exp(x); }
+static double refLog(double x) { return std::log(x); }
+static double refTanh(double x) { return std::tanh(x); }
+static double refSigmoid(double x) { return 1.0 / (1.0 + std::exp(-x)); }
+static double refErf(double x) { return std::erf(x); }
+
+TEST(DNN_VecMath, exp)
+{
+    EXPECT_LE(maxUlpError(v_exp_approx, refExp, -80.f, 80.f), 2);
+    EXPECT_LE(maxUlpError(v_exp_approx, refExp, -1.f, 1.f), 2);
+}
+
+TEST(DNN_VecMath, log)
+{
+    EXPECT_LE(maxUlpError(v_log_approx, refLog, 1e-6f, 1.f), 2);
+    EXPECT_LE(maxUlpError(v_log_approx, refLog, 0.5f, 1e6f), 2);
+
+    float src[] = {0.f, -1.f, std::numeric_limits<float>::infinity(), 1.f}, dst[4];
+    v_store(dst, v_log_approx(v_load(src)));
+    EXPECT_EQ(-std::numeric_limits<float>::infinity(), dst[0]);
+    EXPECT_TRUE(cvIsNaN(dst[1]));
+    EXPECT_EQ(std::numeric_limits<float>::infinity(), dst[2]);
+    EXPECT_EQ(0.f, dst[3]);
+}
+
+TEST(DNN_VecMath, tanh)
+{
+    EXPECT_LE(maxUlpError(v_tanh_approx, refTanh, -10.f, 10.f), 2);
+    EXPECT_LE(maxUlpError(v_tanh_approx, refTanh, -1e-3f, 1e-3f), 2);
+}
+
+TEST(DNN_VecMath, sigmoid)
+{
+    EXPECT_LE(maxUlpError(v_sigmoid_approx, refSigmoid, -80.f, 80.f), 4);
+}
+
+TEST(DNN_VecMath, erf)
+{
+    // see the accuracy of v_erf_approx
+    EXPECT_LE(maxUlpError(v_erf_approx, refErf, -5.f, 5.f), 8);
+    EXPECT_LE(maxUlpError(v_erf_approx, refErf, -0.5f, 0.5f), 4);
+    EXPECT_LE(maxUlpError(v_erf_approx, refErf, -1e-3f, 1e-3f), 4);
+}
+
+#endif  // CV_SIMD128
+
+// Activations are compared with scalar implementations. Sizes are chosen to
+// cover both the vectorized loops and tails.
+typedef testing::TestWithParam<std::string> Layer_Test_Activation;
+TEST_P(Layer_Test_Activation, Accuracy)
+{
+    const std::string type = GetParam();
+    LayerParams lp;
+    lp.type = type;
+    lp.name = "testLayer";
+    if (type == "LogSoftMax")
+    {
+        lp.type = "Softmax";
+        lp.set("log_softmax", true);
+    }
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+
+    const int inpShape[] = {2, 7, 5, 11};
+    Mat inp(4, inpShape, CV_32F);
+    randu(inp, -10, 10);
+    net.setInput(inp);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat out = net.forward();
+
+    Mat ref(4, inpShape, CV_32F);
+    const float* src = inp.ptr<float>();
+    float* dst = ref.ptr<float>();
+    if (lp.type == "Softmax")
+    {
+        // Along channels.
+        const int channels = inpShape[1], planeSize = inpShape[2] * inpShape[3];
+        for (int n = 0; n < inpShape[0]; ++n)
+        {
+            for (int i = 0; i < planeSize; ++i)
+            {
+                const int offset = n * channels * planeSize + i;
+                double maxVal = -DBL_MAX, sum = 0;
+                for (int c = 0; c < channels; ++c)
+                    maxVal = std::max(maxVal, (double)src[offset + c * planeSize]);
+                for (int c = 0; c < channels; ++c)
+                    sum += std::exp(src[offset + c * planeSize] - maxVal);
+                for (int c = 0; c < channels; ++c)
+                {
+                    double v = std::exp(src[offset + c * planeSize] - maxVal) / sum;
+                    dst[offset + c * planeSize] = (float)(type == "LogSoftMax" ? std::log(v) : v);
+                }
+            }
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < inp.total(); ++i)
+        {
+            double x = src[i];
+            if (type == "TanH")
+                dst[i] = (float)std::tanh(x);
+            else if (type == "Sigmoid")
+                dst[i] = (float)(1.0 / (1.0 + std::exp(-x)));
+            else if (type == "Swish")
+                dst[i] = (float)(x / (1.0 + std::exp(-x)));
+            else if (type == "ELU")
+                dst[i] = (float)(x >= 0 ? x : std::exp(x) - 1);
+            else if (type == "BNLL")
+                dst[i] = (float)(std::max(x, 0.0) + std::log(1.0 + std::exp(-std::abs(x))));
+            else
+                FAIL() << "Unknown activation " << type;
+        }
+    }
+    normAssert(ref, out, type.c_str(), 1e-6, 1e-5);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Test_Activation, Values(
+    "TanH", "Sigmoid", "Swish", "ELU", "BNLL", "Softmax", "LogSoftMax"
+));
+
+TEST(Layer_Test_Softmax, last_axis)
+{
+    LayerParams lp;
+    lp.set("axis", -1);
+    Net net;
+    net.addLayerToPrev("softmax", "Softmax", lp);
+
+    Mat inp(13, 85, CV_32F);
+    randu(inp, -20, 20);
+    net.setInput(inp);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    Mat out = net.forward();
+
+    Mat ref(inp.size(), CV_32F);
+    for (int y = 0; y < inp.rows; ++y)
+    {
+        double maxVal;
+        minMaxLoc(inp.row(y), 0, &maxVal);
+        Mat e;
+        exp(inp.row(y) - maxVal, e);
+        Mat(e / sum(e)[0]).copyTo(ref.row(y));
+    }
+    normAssert(ref, out.reshape(1, inp.rows), "", 1e-6, 1e-5);
+}
+
+}} // namespace
@@ -784,7 +784,28 @@ enum ColorConversionCodes {
     COLOR_BayerRG2RGBA = COLOR_BayerBG2BGRA,
     COLOR_BayerGR2RGBA = COLOR_BayerGB2BGRA,
 
-    COLOR_COLORCVT_MAX  = 143
+    //! YUV 4:2:0 and 4:2:2 family to BGR565 in a single pass, see #COLOR_BGR2BGR565
+    COLOR_YUV2BGR565_NV12 = 143,
+    COLOR_YUV2BGR565_NV21 = 144,
+    COLOR_YUV420sp2BGR565 = COLOR_YUV2BGR565_NV21,
+
+    COLOR_YUV2BGR565_UYVY = 145,
+    COLOR_YUV2BGR565_Y422 = COLOR_YUV2BGR565_UYVY,
+    COLOR_YUV2BGR565_UYNV = COLOR_YUV2BGR565_UYVY,
+
+    COLOR_YUV2BGR565_YUY2 = 146,
+    COLOR_YUV2BGR565_YVYU = 147,
+    COLOR_YUV2BGR565_YUYV = COLOR_YUV2BGR565_YUY2,
+    COLOR_YUV2BGR565_YUNV = COLOR_YUV2BGR565_YUY2,
+
+    //! BGR565 to YUV 4:2:0 family in a single pass
+    COLOR_BGR5652YUV_NV12 = 148,
+    COLOR_BGR5652YUV_NV21 = 149,
+    COLOR_BGR5652YUV_I420 = 150,
+    COLOR_BGR5652YUV_IYUV = COLOR_BGR5652YUV_I420,
+    COLOR_BGR5652YUV_YV12 = 151,
+
+    COLOR_COLORCVT_MAX  = 152
 };
 
 //! @addtogroup imgproc_shape
@@ -1383,8 +1404,8 @@ In-place operation is supported.
 
 @note The median filter uses #BORDER_REPLICATE internally to cope with border pixels, see #BorderTypes
 
-@param src input 1-, 3-, or 4-channel image; when ksize is 3 or 5, the image depth should be
-CV_8U, CV_16U, or CV_32F, for larger aperture sizes, it can only be CV_8U.
+@param src input image; when ksize is 3, 5, 7 or 9, the image depth should be CV_8U, CV_16U, CV_16S
+or CV_32F, for larger aperture sizes, it can only be 1-, 3-, or 4-channel CV_8U.
 @param dst destination array of the same size and type as src.
 @param ksize aperture linear size; it must be odd and greater than 1, for example: 3, 5, 7 ...
 @sa  bilateralFilter, blur, boxFilter, GaussianBlur
@@ -3298,6 +3319,33 @@ The algorithm normalizes the brightness and increases the contrast of the image.
  */
 CV_EXPORTS_W void equalizeHist( InputArray src, OutputArray dst );
 
+/** @brief Extracts the luma of a YUV frame, optionally downscaling it and equalizing its histogram.
+
+The function is a single-pass front-end for detectors working on camera frames. It is equivalent to
+@code
+    cvtColor(src, gray, code);
+    gray = gray(Rect(0, 0, gray.cols/scale*scale, gray.rows/scale*scale));
+    resize(gray, small, Size(gray.cols/scale, gray.rows/scale), 0, 0, INTER_AREA);
+    if (equalize)
+        equalizeHist(small, small);
+@endcode
+except that the source frame is read only once: every destination row is averaged from scale luma
+rows as they are extracted, and its histogram is computed on the fly. The equalization table is then
+applied to the downscaled image in place.
+
+@param src Source 8-bit frame: a single-channel 4:2:0 image (NV12, NV21, YV12, I420) of height*3/2
+rows for #COLOR_YUV2GRAY_420, or a 2-channel 4:2:2 image for #COLOR_YUV2GRAY_UYVY and
+#COLOR_YUV2GRAY_YUY2 (YUYV, YVYU).
+@param dst Destination 8-bit single-channel image of size (width/scale, height/scale), where width and
+height are the luma size. Luma rows and columns which don't make a whole block are dropped.
+@param code Source layout, one of #COLOR_YUV2GRAY_420, #COLOR_YUV2GRAY_UYVY, #COLOR_YUV2GRAY_YUY2 or
+their aliases.
+@param scale Integer downscaling factor from 1 to 16. Blocks of scale x scale pixels are averaged
+the same way as #resize with #INTER_AREA does.
+@param equalize If true, the histogram of dst is equalized as #equalizeHist does.
+ */
+CV_EXPORTS_W void extractLuma( InputArray src, OutputArray dst, int code, int scale = 1, bool equalize = false );
+
 /** @brief Creates a smart pointer to a cv::CLAHE class and initializes it.
 
 @param clipLimit Threshold for contrast limiting.
@@ -3695,6 +3743,8 @@ This function only supports YUV420 to RGB conversion as of now.
 - #COLOR_YUV2RGB_NV21
 - #COLOR_YUV2BGRA_NV21
 - #COLOR_YUV2RGBA_NV21
+- #COLOR_YUV2BGR565_NV12
+- #COLOR_YUV2BGR565_NV21
 */
 CV_EXPORTS_W void cvtColorTwoPlane( InputArray src1, InputArray src2, OutputArray dst, int code );
 
@@ -3824,6 +3874,30 @@ not set by default. Currently, only the #TM_SQDIFF and #TM_CCORR_NORMED methods
 CV_EXPORTS_W void matchTemplate( InputArray image, InputArray templ,
                                  OutputArray result, int method, InputArray mask = noArray() );
 
+/** @brief Compares several templates against overlapped image regions.
+
+The function computes the same comparison results as #matchTemplate does for every template. The
+spectrum of the image and its integrals are computed once and shared by all the templates, and the
+templates are processed in parallel.
+
+If maxLevel is positive, the search is coarse-to-fine: the image and the templates are reduced
+maxLevel times by #pyrDown, the exhaustive search is done on the coarsest level, and then only the
+neighbourhood of the best match of every template is refined on each finer level. The rest of the
+result maps is filled by the worst score (FLT_MAX for #TM_SQDIFF and #TM_SQDIFF_NORMED, -FLT_MAX
+otherwise), so the best match is found by #minMaxLoc the same way. The number of levels is reduced
+so that the coarsest templates are at least 8 pixels wide and high.
+
+@param image Image where the search is running. It must be 8-bit or 32-bit floating-point.
+@param templs Searched templates. They must be not greater than the source image and have the same
+data type.
+@param results Maps of comparison results, one per template, see #matchTemplate.
+@param method Parameter specifying the comparison method, see #TemplateMatchModes
+@param maxLevel 0-based index of the coarsest pyramid level to start the search from, 0 means the
+exhaustive search.
+ */
+CV_EXPORTS_W void matchTemplates( InputArray image, InputArrayOfArrays templs,
+                                  OutputArrayOfArrays results, int method, int maxLevel = 0 );
+
 //! @}
 
 //! @addtogroup imgproc_shape
@@ -4804,6 +4878,42 @@ CV_EXPORTS_W double getFontScaleFromHeight(const int fontFace,
                                            const int pixelHeight,
                                            const int thickness = 1);
 
+//! Flags of #drawOverlay
+enum OverlayFlags {
+    OVERLAY_BGR565 = 1 //!< the image is CV_8UC2 with packed BGR565 pixels, as produced by #COLOR_BGR2BGR565
+};
+
+/** @brief Draws a set of labeled boxes, e.g. results of an object detector.
+
+The function draws every box as #rectangle does and puts its label on a filled background of the box
+color above the box. The label is shifted to stay inside the image. Items are drawn in order, so later
+ones overlap earlier ones.
+
+Labels are drawn with the thickness 1 from Hershey glyphs rasterized once and cached for subsequent
+calls, so the cost per label doesn't depend on the font complexity. Glyphs are placed with the pen
+position rounded to a quarter of a pixel, so the text can be shifted by up to 1/8 pixel from what
+#putText draws unless the glyph advances are multiples of a quarter pixel at the given fontScale.
+
+@param img Image.
+@param boxes Boxes to draw.
+@param labels Labels of the boxes, either empty or of the same size as boxes. Empty labels are skipped.
+@param colors Colors of the boxes and label backgrounds: one for all boxes or one per box.
+@param thickness Thickness of the box lines. Negative value means a filled box, zero draws labels only.
+@param fontFace Font type, see #HersheyFonts.
+@param fontScale Font scale factor that is multiplied by the font-specific base size.
+@param textColor Color of the labels text.
+@param lineType Type of the box lines and glyph strokes. See #LineTypes
+@param flags Operation flags, see #OverlayFlags. With #OVERLAY_BGR565 colors are packed into 16-bit
+pixels, so overlays can be drawn right in a framebuffer image; #LINE_AA is applied to labels text only
+in this case.
+@see rectangle, putText
+ */
+CV_EXPORTS void drawOverlay( InputOutputArray img, const std::vector<Rect>& boxes,
+                             const std::vector<String>& labels, const std::vector<Scalar>& colors,
+                             int thickness = 2, int fontFace = FONT_HERSHEY_SIMPLEX,
+                             double fontScale = 0.5, const Scalar& textColor = Scalar::all(0),
+                             int lineType = LINE_8, int flags = 0 );
+
 /** @brief Line iterator
 
 The class is used to iterate over all the pixels on the raster line
@@ -47,6 +47,37 @@ PERF_TEST_P(TestFindContours, findContours,
     SANITY_CHECK_NOTHING();
 }
 
+// Segmentation masks at camera resolution: blobs in rows of objects.
+typedef TestBaseWithParam< tuple<Size, RetrMode> > TestFindContoursMask;
+
+PERF_TEST_P(TestFindContoursMask, findContours_mask,
+            Combine(
+               Values( sz1080p, sz2160p ), // image size
+               Values( RETR_EXTERNAL, RETR_TREE ) // retrieval mode
+            )
+           )
+{
+    Size img_size = get<0>(GetParam());
+    int retr_mode = get<1>(GetParam());
+
+    RNG rng;
+    Mat img = Mat::zeros(img_size, CV_8UC1);
+    int cell = img_size.height / 12;
+    for( int y = cell/2; y < img.rows - cell/2; y += cell )
+        for( int x = cell/2; x < img.cols - cell/2; x += cell/2 )
+        {
+            Size axes(rng.uniform(cell/8, cell/4), rng.uniform(cell/8, cell*2/5));
+            ellipse(img, Point(x, y), axes, rng.uniform(0, 180), 0, 360, Scalar::all(255), -1);
+            ellipse(img, Point(x, y), axes/2, 0, 0, 360, Scalar::all(0), -1);
+        }
+    vector< vector<Point> > contours;
+    vector<Vec4i> hierarchy;
+
+    TEST_CYCLE() findContours( img, contours, hierarchy, retr_mode, CHAIN_APPROX_SIMPLE );
+
+    SANITY_CHECK_NOTHING();
+}
+
 typedef TestBaseWithParam< tuple<Size, ApproxMode, int> > TestFindContoursFF;
 
 PERF_TEST_P(TestFindContoursFF, findContours,
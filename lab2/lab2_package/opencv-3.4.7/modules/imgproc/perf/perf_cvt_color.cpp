@@ -471,6 +471,40 @@ PERF_TEST_P(Size_CvtMode3, cvtColorRGB2YUV420p,
     SANITY_CHECK(dst, 1);
 }
 
+CV_ENUM(CvtModeBGR565, COLOR_YUV2BGR565_NV12, COLOR_YUV2BGR565_UYVY, COLOR_YUV2BGR565_YUY2,
+                       COLOR_BGR5652YUV_NV12, COLOR_BGR5652YUV_I420)
+
+typedef tuple<Size, CvtModeBGR565> Size_CvtModeBGR565_t;
+typedef perf::TestBaseWithParam<Size_CvtModeBGR565_t> Size_CvtModeBGR565;
+
+PERF_TEST_P(Size_CvtModeBGR565, cvtColorYUV_BGR565,
+            testing::Combine(
+                testing::Values(szVGA, sz720p, sz1080p, Size(130, 60)),
+                CvtModeBGR565::all()
+                )
+            )
+{
+    Size sz = get<0>(GetParam());
+    int mode = get<1>(GetParam());
+
+    Mat src, dst;
+    if (mode == COLOR_YUV2BGR565_NV12)
+        src.create(sz.height + sz.height / 2, sz.width, CV_8UC1);
+    else
+        src.create(sz, CV_8UC2);
+    if (mode == COLOR_BGR5652YUV_NV12 || mode == COLOR_BGR5652YUV_I420)
+        dst.create(sz.height + sz.height / 2, sz.width, CV_8UC1);
+    else
+        dst.create(sz, CV_8UC2);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    int runs = (sz.width <= 640) ? 8 : 1;
+    TEST_CYCLE_MULTIRUN(runs) cvtColor(src, dst, mode);
+
+    SANITY_CHECK_NOTHING();
+}
+
 CV_ENUM(EdgeAwareBayerMode, COLOR_BayerBG2BGR_EA, COLOR_BayerGB2BGR_EA, COLOR_BayerRG2BGR_EA, COLOR_BayerGR2BGR_EA)
 
 typedef tuple<Size, EdgeAwareBayerMode> EdgeAwareParams;
@@ -0,0 +1,41 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "perf_precomp.hpp"
+
+namespace opencv_test {
+
+CV_ENUM(OverlayTarget, CV_8UC3, CV_8UC2)
+
+typedef tuple<int, OverlayTarget> Detections_Target_t;
+typedef perf::TestBaseWithParam<Detections_Target_t> Detections_Target;
+
+PERF_TEST_P(Detections_Target, drawOverlay,
+            testing::Combine(
+                testing::Values(10, 50, 200),
+                OverlayTarget::all()
+            )
+)
+{
+    const int n = get<0>(GetParam()), type = get<1>(GetParam());
+    Size sz = sz720p;
+    RNG rng(0);
+    std::vector<Rect> boxes;
+    std::vector<String> labels;
+    std::vector<Scalar> colors;
+    for (int i = 0; i < n; i++)
+    {
+        boxes.push_back(Rect(rng.uniform(0, sz.width - 100), rng.uniform(0, sz.height - 100),
+                             rng.uniform(20, 100), rng.uniform(20, 100)));
+        labels.push_back(format("person %.1f%%", rng.uniform(0., 100.)));
+        colors.push_back(Scalar(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256)));
+    }
+    Mat img(sz, type, Scalar::all(0));
+    int flags = type == CV_8UC2 ? OVERLAY_BGR565 : 0;
+
+    TEST_CYCLE() drawOverlay(img, boxes, labels, colors, 2, FONT_HERSHEY_SIMPLEX, 0.5, Scalar::all(0), LINE_8, flags);
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
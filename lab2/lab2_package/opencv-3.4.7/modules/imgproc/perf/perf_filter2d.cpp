@@ -97,4 +97,31 @@ PERF_TEST_P( Image_KernelSize, GaborFilter2d,
     SANITY_CHECK(filteredImage, 1e-6, ERROR_RELATIVE);
 }
 
+typedef TestBaseWithParam< tuple<Size, int> > TestFilter2d_Threads;
+
+PERF_TEST_P( TestFilter2d_Threads, Filter2d,
+             Combine(
+                Values( szVGA, sz1080p ),
+                Values( 1, 2, 4 )
+             )
+)
+{
+    Size sz = get<0>(GetParam());
+    int threads = get<1>(GetParam());
+
+    Mat src(sz, CV_8UC4);
+    Mat dst(sz, CV_8UC4);
+
+    Mat kernel(5, 5, CV_32FC1);
+    randu(kernel, -3, 10);
+    double s = fabs( sum(kernel)[0] );
+    if(s > 1e-3) kernel /= s;
+
+    declare.in(src, WARMUP_RNG).out(dst).tbb_threads(threads);
+
+    TEST_CYCLE() cv::filter2D(src, dst, CV_8UC4, kernel);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -116,6 +116,29 @@ PERF_TEST_P(MatSize, equalizeHist,
 }
 #undef MatSize
 
+// Face detector front-end: luma of a YUV frame downscaled and equalized
+typedef TestBaseWithParam< tuple<Size, int, int> > Size_Code_Scale;
+PERF_TEST_P(Size_Code_Scale, extractLuma,
+            testing::Combine(testing::Values(szVGA, sz720p, sz1080p),
+                             testing::Values((int)COLOR_YUV2GRAY_420, (int)COLOR_YUV2GRAY_YUY2),
+                             testing::Values(1, 2, 4))
+            )
+{
+    Size size = get<0>(GetParam());
+    int code = get<1>(GetParam());
+    int scale = get<2>(GetParam());
+    Mat source = code == COLOR_YUV2GRAY_420 ? Mat(size.height / 2 * 3, size.width, CV_8UC1) : Mat(size, CV_8UC2);
+    Mat destination;
+    declare.in(source, WARMUP_RNG);
+
+    TEST_CYCLE()
+    {
+        extractLuma(source, destination, code, scale, true);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 typedef TestBaseWithParam< tuple<int, int> > Dim_Cmpmethod;
 PERF_TEST_P(Dim_Cmpmethod, compareHist,
             testing::Combine(testing::Values(1, 3),
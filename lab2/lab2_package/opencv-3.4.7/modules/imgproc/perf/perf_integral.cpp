@@ -82,4 +82,29 @@ PERF_TEST_P( Size_MatType_OutMatDepth, integral_sqsum_tilted,
     SANITY_CHECK(tilted, 1e-6, tilted.depth() > CV_32S ? ERROR_RELATIVE : ERROR_ABSOLUTE);
 }
 
+// Depths of the sum and the squared sum.
+typedef tuple<Size, Vec2i> Size_SumDepths_t;
+typedef perf::TestBaseWithParam<Size_SumDepths_t> Size_SumDepths;
+
+PERF_TEST_P(Size_SumDepths, integral_sqsum_8u,
+            testing::Combine(
+                testing::Values(sz720p, sz1080p, sz2160p),
+                testing::Values(Vec2i(CV_32S, CV_32S), Vec2i(CV_32S, CV_64F), Vec2i(CV_32F, CV_64F), Vec2i(CV_64F, CV_64F))
+                )
+            )
+{
+    Size sz = get<0>(GetParam());
+    int sdepth = get<1>(GetParam())[0];
+    int sqdepth = get<1>(GetParam())[1];
+
+    Mat src(sz, CV_8UC1);
+    Mat sum, sqsum;
+
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() integral(src, sum, sqsum, sdepth, sqdepth);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -81,4 +81,29 @@ PERF_TEST_P(ImgSize_TmplSize_Method, matchTemplateBig,
     SANITY_CHECK(result, eps);
 }
 
+// Several logo-sized templates against the same frame, exhaustive and coarse-to-fine.
+typedef tuple<int, int> NTempls_MaxLevel_t;
+typedef perf::TestBaseWithParam<NTempls_MaxLevel_t> NTempls_MaxLevel;
+
+PERF_TEST_P(NTempls_MaxLevel, matchTemplates,
+            testing::Combine(
+                testing::Values(1, 4, 8),
+                testing::Values(0, 2)
+                )
+    )
+{
+    int ntempls = get<0>(GetParam());
+    int maxLevel = get<1>(GetParam());
+
+    Mat img(sz720p, CV_8UC1);
+    declare.in(img, WARMUP_RNG);
+    std::vector<Mat> templs, results;
+    for (int i = 0; i < ntempls; i++)
+        templs.push_back(img(Rect(i*100, i*50, 64, 48)).clone());
+
+    TEST_CYCLE() matchTemplates(img, templs, results, TM_CCOEFF_NORMED, maxLevel);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
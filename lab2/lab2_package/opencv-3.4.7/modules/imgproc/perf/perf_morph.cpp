@@ -39,4 +39,34 @@ PERF_TEST_P(Size_MatType, dilate, TYPICAL_MATS_MORPH)
     SANITY_CHECK(dst);
 }
 
+CV_ENUM(MorphShape, MORPH_RECT, MORPH_ELLIPSE)
+
+typedef tuple<Size, MatType, MorphShape, int> Size_MatType_Shape_KSize_t;
+typedef perf::TestBaseWithParam<Size_MatType_Shape_KSize_t> Size_MatType_Shape_KSize;
+
+PERF_TEST_P(Size_MatType_Shape_KSize, erode_ksize,
+            testing::Combine(
+                testing::Values(szVGA, sz1080p),
+                testing::Values(CV_8UC1, CV_8UC4),
+                MorphShape::all(),
+                testing::Values(3, 7, 15, 31)
+            )
+)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int shape = get<2>(GetParam());
+    int ksize = get<3>(GetParam());
+
+    Mat src(sz, type);
+    Mat dst(sz, type);
+    Mat kernel = getStructuringElement(shape, Size(ksize, ksize));
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() cv::erode(src, dst, kernel);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -95,4 +95,27 @@ PERF_TEST_P(Size_MatType, buildPyramid, testing::Combine(
     SANITY_CHECK(dst4, eps, error_type);
 }
 
+typedef tuple<Size, MatType, int> Size_MatType_MaxLevel_t;
+typedef perf::TestBaseWithParam<Size_MatType_MaxLevel_t> Size_MatType_MaxLevel;
+
+PERF_TEST_P(Size_MatType_MaxLevel, buildPyramid_levels, testing::Combine(
+                testing::Values(sz1080p, sz2160p),
+                testing::Values(CV_8UC1, CV_8UC3, CV_32FC1),
+                testing::Values(3, 6)
+                )
+            )
+{
+    Size sz = get<0>(GetParam());
+    int matType = get<1>(GetParam());
+    int maxLevel = get<2>(GetParam());
+    Mat src(sz, matType);
+    std::vector<Mat> dst;
+
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() buildPyramid(src, dst, maxLevel);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
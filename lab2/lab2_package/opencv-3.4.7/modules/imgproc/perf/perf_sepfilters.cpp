@@ -242,4 +242,48 @@ PERF_TEST_P(Size_MatType_dx_dy_Border3x3ROI, scharrViaSobelFilter,
     SANITY_CHECK(dst);
 }
 
+/**************** Threads scaling ********************/
+
+typedef perf::TestBaseWithParam<tuple<Size, int> > Size_Threads;
+
+PERF_TEST_P(Size_Threads, gaussianBlur7x7,
+            testing::Combine(
+                testing::Values(szVGA, sz1080p),
+                testing::Values(1, 2, 4)
+            )
+          )
+{
+    Size size = get<0>(GetParam());
+    int threads = get<1>(GetParam());
+
+    Mat src(size, CV_8UC1);
+    Mat dst(size, CV_8UC1);
+
+    declare.in(src, WARMUP_RNG).out(dst).tbb_threads(threads);
+
+    TEST_CYCLE() GaussianBlur(src, dst, Size(7, 7), 0);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_Threads, sobelFilter3x3,
+            testing::Combine(
+                testing::Values(szVGA, sz1080p),
+                testing::Values(1, 2, 4)
+            )
+          )
+{
+    Size size = get<0>(GetParam());
+    int threads = get<1>(GetParam());
+
+    Mat src(size, CV_8UC1);
+    Mat dst(size, CV_16SC1);
+
+    declare.in(src, WARMUP_RNG).out(dst).tbb_threads(threads);
+
+    TEST_CYCLE() Sobel(src, dst, CV_16S, 1, 0, 3);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
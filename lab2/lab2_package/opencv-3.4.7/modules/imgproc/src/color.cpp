@@ -161,6 +161,7 @@ void cvtColorTwoPlane( InputArray _ysrc, InputArray _uvsrc, OutputArray _dst, in
     {
         case COLOR_YUV2BGR_NV21:  case COLOR_YUV2RGB_NV21:  case COLOR_YUV2BGR_NV12:  case COLOR_YUV2RGB_NV12:
         case COLOR_YUV2BGRA_NV21: case COLOR_YUV2RGBA_NV21: case COLOR_YUV2BGRA_NV12: case COLOR_YUV2RGBA_NV12:
+        case COLOR_YUV2BGR565_NV21: case COLOR_YUV2BGR565_NV12:
             break;
         default:
             CV_Error( CV_StsBadFlag, "Unknown/unsupported color conversion code" );
@@ -341,6 +342,22 @@ void cvtColor( InputArray _src, OutputArray _dst, int code, int dcn )
             cvtColorYUV2Gray_ch(_src, _dst, code == COLOR_YUV2GRAY_UYVY ? 1 : 0);
             break;
 
+        case COLOR_YUV2BGR565_NV21: case COLOR_YUV2BGR565_NV12:
+            cvtColorTwoPlaneYUV2BGR565(_src, _dst, uIndex(code));
+            break;
+
+        case COLOR_YUV2BGR565_UYVY: case COLOR_YUV2BGR565_YUY2: case COLOR_YUV2BGR565_YVYU:
+            cvtColorOnePlaneYUV2BGR565(_src, _dst, uIndex(code), code == COLOR_YUV2BGR565_UYVY ? 1 : 0);
+            break;
+
+        case COLOR_BGR5652YUV_NV12: case COLOR_BGR5652YUV_NV21:
+            cvtColorBGR5652TwoPlaneYUV(_src, _dst, uIndex(code));
+            break;
+
+        case COLOR_BGR5652YUV_I420: case COLOR_BGR5652YUV_YV12:
+            cvtColorBGR5652ThreePlaneYUV(_src, _dst, uIndex(code));
+            break;
+
         case COLOR_RGBA2mRGBA:
             cvtColorRGBA2mRGBA(_src, _dst);
             break;
@@ -71,6 +71,9 @@ inline bool swapBlue(int code)
     case COLOR_YUV2BGR_UYVY: case COLOR_YUV2BGRA_UYVY: case COLOR_YUV2BGR_YUY2:
     case COLOR_YUV2BGRA_YUY2:  case COLOR_YUV2BGR_YVYU: case COLOR_YUV2BGRA_YVYU:
     case COLOR_BGR2YUV_IYUV: case COLOR_BGRA2YUV_IYUV: case COLOR_BGR2YUV_YV12: case COLOR_BGRA2YUV_YV12:
+    case COLOR_YUV2BGR565_NV12: case COLOR_YUV2BGR565_NV21: case COLOR_YUV2BGR565_UYVY:
+    case COLOR_YUV2BGR565_YUY2: case COLOR_YUV2BGR565_YVYU:
+    case COLOR_BGR5652YUV_NV12: case COLOR_BGR5652YUV_NV21: case COLOR_BGR5652YUV_I420: case COLOR_BGR5652YUV_YV12:
         return false;
     default:
         return true;
@@ -113,6 +116,11 @@ inline int dstChannels(int code)
 
             return 3;
 
+        case COLOR_YUV2BGR565_NV12: case COLOR_YUV2BGR565_NV21: case COLOR_YUV2BGR565_UYVY:
+        case COLOR_YUV2BGR565_YUY2: case COLOR_YUV2BGR565_YVYU:
+
+            return 2;
+
         default:
             return 0;
     }
@@ -144,6 +152,7 @@ inline int uIndex(int code)
     switch( code )
     {
         case COLOR_RGB2YUV_YV12: case COLOR_BGR2YUV_YV12: case COLOR_RGBA2YUV_YV12: case COLOR_BGRA2YUV_YV12:
+        case COLOR_BGR5652YUV_YV12: case COLOR_BGR5652YUV_NV21:
 
             return 2;
 
@@ -151,6 +160,8 @@ inline int uIndex(int code)
         case COLOR_RGB2YUV_IYUV: case COLOR_BGR2YUV_IYUV: case COLOR_RGBA2YUV_IYUV: case COLOR_BGRA2YUV_IYUV:
         case COLOR_YUV2BGR_NV21:  case COLOR_YUV2RGB_NV21: case COLOR_YUV2BGRA_NV21: case COLOR_YUV2RGBA_NV21:
         case COLOR_YUV2BGR_YV12: case COLOR_YUV2RGB_YV12: case COLOR_YUV2BGRA_YV12: case COLOR_YUV2RGBA_YV12:
+        case COLOR_YUV2BGR565_NV21: case COLOR_YUV2BGR565_YVYU:
+        case COLOR_BGR5652YUV_I420: case COLOR_BGR5652YUV_NV12:
 
             return 1;
 
@@ -158,6 +169,7 @@ inline int uIndex(int code)
         case COLOR_YUV2BGR_IYUV: case COLOR_YUV2RGB_IYUV: case COLOR_YUV2BGRA_IYUV: case COLOR_YUV2RGBA_IYUV:
         case COLOR_YUV2RGB_UYVY: case COLOR_YUV2BGR_UYVY: case COLOR_YUV2RGBA_UYVY: case COLOR_YUV2BGRA_UYVY:
         case COLOR_YUV2RGB_YUY2: case COLOR_YUV2BGR_YUY2: case COLOR_YUV2RGBA_YUY2: case COLOR_YUV2BGRA_YUY2:
+        case COLOR_YUV2BGR565_NV12: case COLOR_YUV2BGR565_UYVY: case COLOR_YUV2BGR565_YUY2:
 
             return 0;
 
@@ -539,6 +551,10 @@ void cvtColorThreePlaneYUV2BGR( InputArray _src, OutputArray _dst, int dcn, bool
 void cvtColorBGR2ThreePlaneYUV( InputArray _src, OutputArray _dst, bool swapb, int uidx);
 void cvtColorYUV2Gray_420( InputArray _src, OutputArray _dst );
 void cvtColorYUV2Gray_ch( InputArray _src, OutputArray _dst, int coi );
+void cvtColorOnePlaneYUV2BGR565( InputArray _src, OutputArray _dst, int uidx, int ycn );
+void cvtColorTwoPlaneYUV2BGR565( InputArray _src, OutputArray _dst, int uidx );
+void cvtColorBGR5652TwoPlaneYUV( InputArray _src, OutputArray _dst, int uidx );
+void cvtColorBGR5652ThreePlaneYUV( InputArray _src, OutputArray _dst, int uidx );
 
 void cvtColorBGR2HLS( InputArray _src, OutputArray _dst, bool swapb, bool fullRange );
 void cvtColorBGR2HSV( InputArray _src, OutputArray _dst, bool swapb, bool fullRange );
@@ -400,7 +400,7 @@ void cvtColorTwoPlaneYUV2BGRpair( InputArray _ysrc, InputArray _uvsrc, OutputArr
     int stype = _ysrc.type();
     int depth = CV_MAT_DEPTH(stype);
     Size ysz = _ysrc.size(), uvs = _uvsrc.size();
-    CV_Assert( dcn == 3 || dcn == 4 );
+    CV_Assert( dcn == 3 || dcn == 4 || (dcn == 2 && !swapb) );
     CV_Assert( depth == CV_8U );
     CV_Assert( ysz.width == uvs.width * 2 && ysz.height == uvs.height * 2 );
 
@@ -414,4 +414,39 @@ void cvtColorTwoPlaneYUV2BGRpair( InputArray _ysrc, InputArray _uvsrc, OutputArr
                              dcn, swapb, uidx);
 }
 
+// Direct conversions between YUV and BGR565 of displays and overlays: HAL functions take dcn (scn) == 2
+// as packed BGR565, so there is no intermediate 3-channel image.
+
+void cvtColorOnePlaneYUV2BGR565( InputArray _src, OutputArray _dst, int uidx, int ycn )
+{
+    CvtHelper< Set<2>, Set<2>, Set<CV_8U> > h(_src, _dst, 2);
+
+    hal::cvtOnePlaneYUVtoBGR(h.src.data, h.src.step, h.dst.data, h.dst.step, h.src.cols, h.src.rows,
+                             2, false, uidx, ycn);
+}
+
+void cvtColorTwoPlaneYUV2BGR565( InputArray _src, OutputArray _dst, int uidx )
+{
+    CvtHelper< Set<1>, Set<2>, Set<CV_8U>, FROM_YUV > h(_src, _dst, 2);
+
+    hal::cvtTwoPlaneYUVtoBGR(h.src.data, h.src.step, h.dst.data, h.dst.step, h.dst.cols, h.dst.rows,
+                             2, false, uidx);
+}
+
+void cvtColorBGR5652TwoPlaneYUV( InputArray _src, OutputArray _dst, int uidx )
+{
+    CvtHelper< Set<2>, Set<1>, Set<CV_8U>, TO_YUV > h(_src, _dst, 1);
+
+    hal::cvtBGRtoTwoPlaneYUV(h.src.data, h.src.step, h.dst.data, h.dst.data + h.dst.step * h.src.rows, h.dst.step,
+                             h.src.cols, h.src.rows, 2, false, uidx);
+}
+
+void cvtColorBGR5652ThreePlaneYUV( InputArray _src, OutputArray _dst, int uidx )
+{
+    CvtHelper< Set<2>, Set<1>, Set<CV_8U>, TO_YUV > h(_src, _dst, 1);
+
+    hal::cvtBGRtoThreePlaneYUV(h.src.data, h.src.step, h.dst.data, h.dst.step, h.src.cols, h.src.rows,
+                               2, false, uidx);
+}
+
 } // namespace cv
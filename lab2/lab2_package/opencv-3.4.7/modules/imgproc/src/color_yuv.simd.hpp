@@ -1122,6 +1122,49 @@ static inline void yRGBuvToRGBA(const v_uint8& vy,
     bb = v_pack_u(b0, b1);
 }
 
+// dcn == 2 means packed BGR565 output, the same as RGB2RGB5x5 produces
+template<int bIdx, int dcn>
+static inline void storeRGB8(uchar* dst, const uchar r, const uchar g, const uchar b, const uchar a)
+{
+    if(dcn == 2)
+    {
+        *(ushort*)dst = (ushort)((b >> 3)|((g & ~3) << 3)|((r & ~7) << 8));
+    }
+    else
+    {
+        dst[2-bIdx] = r;
+        dst[1]      = g;
+        dst[bIdx]   = b;
+        if(dcn == 4)
+            dst[3] = a;
+    }
+}
+
+#if CV_SIMD
+static inline void v_store_bgr565(uchar* dst, const v_uint8& r, const v_uint8& g, const v_uint8& b)
+{
+    v_uint16 r0, r1, g0, g1, b0, b1;
+    v_expand(r & vx_setall_u8((uchar)~7), r0, r1);
+    v_expand(g & vx_setall_u8((uchar)~3), g0, g1);
+    v_expand(b, b0, b1);
+
+    ushort* d = (ushort*)dst;
+    v_store(d, (b0 >> 3) | (g0 << 3) | (r0 << 8));
+    v_store(d + v_uint16::nlanes, (b1 >> 3) | (g1 << 3) | (r1 << 8));
+}
+
+static inline void v_load_bgr565(const uchar* src, v_uint8& r, v_uint8& g, v_uint8& b)
+{
+    const ushort* s = (const ushort*)src;
+    v_uint16 t0 = vx_load(s), t1 = vx_load(s + v_uint16::nlanes);
+    v_uint16 m3 = vx_setall_u16(0xfc), m7 = vx_setall_u16(0xf8);
+
+    b = v_pack((t0 << 3) & m7, (t1 << 3) & m7);
+    g = v_pack((t0 >> 3) & m3, (t1 >> 3) & m3);
+    r = v_pack((t0 >> 8) & m7, (t1 >> 8) & m7);
+}
+#endif
+
 template<int bIdx, int dcn, bool is420>
 static inline void cvtYuv42xxp2RGB8(const uchar u, const uchar v,
                                     const uchar vy01, const uchar vy11, const uchar vy02, const uchar vy12,
@@ -1136,17 +1179,8 @@ static inline void cvtYuv42xxp2RGB8(const uchar u, const uchar v,
     yRGBuvToRGBA(vy01, ruv, guv, buv, r00, g00, b00, a00);
     yRGBuvToRGBA(vy11, ruv, guv, buv, r01, g01, b01, a01);
 
-    row1[2-bIdx] = r00;
-    row1[1]      = g00;
-    row1[bIdx]   = b00;
-    if(dcn == 4)
-        row1[3] = a00;
-
-    row1[dcn+2-bIdx] = r01;
-    row1[dcn+1]      = g01;
-    row1[dcn+0+bIdx] = b01;
-    if(dcn == 4)
-        row1[7] = a01;
+    storeRGB8<bIdx, dcn>(row1,       r00, g00, b00, a00);
+    storeRGB8<bIdx, dcn>(row1 + dcn, r01, g01, b01, a01);
 
     if(is420)
     {
@@ -1156,21 +1190,12 @@ static inline void cvtYuv42xxp2RGB8(const uchar u, const uchar v,
         yRGBuvToRGBA(vy02, ruv, guv, buv, r10, g10, b10, a10);
         yRGBuvToRGBA(vy12, ruv, guv, buv, r11, g11, b11, a11);
 
-        row2[2-bIdx] = r10;
-        row2[1]      = g10;
-        row2[bIdx]   = b10;
-        if(dcn == 4)
-            row2[3] = a10;
-
-        row2[dcn+2-bIdx] = r11;
-        row2[dcn+1]      = g11;
-        row2[dcn+0+bIdx] = b11;
-        if(dcn == 4)
-            row2[7] = a11;
+        storeRGB8<bIdx, dcn>(row2,       r10, g10, b10, a10);
+        storeRGB8<bIdx, dcn>(row2 + dcn, r11, g11, b11, a11);
     }
 }
 
-// bIdx is 0 or 2, uIdx is 0 or 1, dcn is 3 or 4
+// bIdx is 0 or 2, uIdx is 0 or 1, dcn is 3 or 4, or 2 for BGR565 with bIdx 0
 template<int bIdx, int uIdx, int dcn>
 struct YUV420sp2RGB8Invoker : ParallelLoopBody
 {
@@ -1250,6 +1275,14 @@ struct YUV420sp2RGB8Invoker : ParallelLoopBody
                     v_store_interleave(row2 + 0*vsize, b1_0, g1_0, r1_0, a);
                     v_store_interleave(row2 + 4*vsize, b1_1, g1_1, r1_1, a);
                 }
+                else if(dcn == 2)
+                {
+                    v_store_bgr565(row1 + 0*vsize, r0_0, g0_0, b0_0);
+                    v_store_bgr565(row1 + 2*vsize, r0_1, g0_1, b0_1);
+
+                    v_store_bgr565(row2 + 0*vsize, r1_0, g1_0, b1_0);
+                    v_store_bgr565(row2 + 2*vsize, r1_1, g1_1, b1_1);
+                }
                 else //dcn == 3
                 {
                     v_store_interleave(row1 + 0*vsize, b0_0, g0_0, r0_0);
@@ -1563,6 +1596,11 @@ struct RGB8toYUV420pInvoker: public ParallelLoopBody
                     v_load_deinterleave(srcRow + 2*4*i + 0*vsize, b0, g0, r0, a0);
                     v_load_deinterleave(srcRow + 2*4*i + 4*vsize, b1, g1, r1, a1);
                 }
+                else if(scn == 2)
+                {
+                    v_load_bgr565(srcRow + 2*2*i + 0*vsize, r0, g0, b0);
+                    v_load_bgr565(srcRow + 2*2*i + 2*vsize, r1, g1, b1);
+                }
                 else // scn == 3
                 {
                     v_load_deinterleave(srcRow + 2*3*i + 0*vsize, b0, g0, r0);
@@ -1610,12 +1648,23 @@ struct RGB8toYUV420pInvoker: public ParallelLoopBody
             {
                 uchar b0, g0, r0;
                 uchar b1, g1, r1;
-                b0 = srcRow[(2*i+0)*scn + 0];
-                g0 = srcRow[(2*i+0)*scn + 1];
-                r0 = srcRow[(2*i+0)*scn + 2];
-                b1 = srcRow[(2*i+1)*scn + 0];
-                g1 = srcRow[(2*i+1)*scn + 1];
-                r1 = srcRow[(2*i+1)*scn + 2];
+                if(scn == 2)
+                {
+                    // the same unpacking as RGB5x52RGB does
+                    int t0 = ((const ushort*)srcRow)[2*i+0];
+                    int t1 = ((const ushort*)srcRow)[2*i+1];
+                    b0 = (uchar)(t0 << 3); g0 = (uchar)((t0 >> 3) & ~3); r0 = (uchar)((t0 >> 8) & ~7);
+                    b1 = (uchar)(t1 << 3); g1 = (uchar)((t1 >> 3) & ~3); r1 = (uchar)((t1 >> 8) & ~7);
+                }
+                else
+                {
+                    b0 = srcRow[(2*i+0)*scn + 0];
+                    g0 = srcRow[(2*i+0)*scn + 1];
+                    r0 = srcRow[(2*i+0)*scn + 2];
+                    b1 = srcRow[(2*i+1)*scn + 0];
+                    g1 = srcRow[(2*i+1)*scn + 1];
+                    r1 = srcRow[(2*i+1)*scn + 2];
+                }
 
                 if(swapBlue)
                 {
@@ -1667,7 +1716,7 @@ struct RGB8toYUV420pInvoker: public ParallelLoopBody
 
 ///////////////////////////////////// YUV422 -> RGB /////////////////////////////////////
 
-// bIdx is 0 or 2; [uIdx, yIdx] is [0, 0], [0, 1], [1, 0]; dcn is 3 or 4
+// bIdx is 0 or 2; [uIdx, yIdx] is [0, 0], [0, 1], [1, 0]; dcn is 3 or 4, or 2 for BGR565 with bIdx 0
 template<int bIdx, int uIdx, int yIdx, int dcn>
 struct YUV422toRGB8Invoker : ParallelLoopBody
 {
@@ -1746,6 +1795,11 @@ struct YUV422toRGB8Invoker : ParallelLoopBody
                     v_store_interleave(row + 0*vsize, b0_0, g0_0, r0_0, a);
                     v_store_interleave(row + 4*vsize, b0_1, g0_1, r0_1, a);
                 }
+                else if(dcn == 2)
+                {
+                    v_store_bgr565(row + 0*vsize, r0_0, g0_0, b0_0);
+                    v_store_bgr565(row + 2*vsize, r0_1, g0_1, b0_1);
+                }
                 else //dcn == 3
                 {
                     v_store_interleave(row + 0*vsize, b0_0, g0_0, r0_0);
@@ -1848,6 +1902,8 @@ void cvtTwoPlaneYUVtoBGR(const uchar * y_data, const uchar * uv_data, size_t src
     cvt_2plane_yuv_ptr_t cvtPtr;
     switch(dcn*100 + blueIdx * 10 + uIdx)
     {
+    case 200: cvtPtr = cvtYUV420sp2RGB<0, 0, 2>; break;
+    case 201: cvtPtr = cvtYUV420sp2RGB<0, 1, 2>; break;
     case 300: cvtPtr = cvtYUV420sp2RGB<0, 0, 3>; break;
     case 301: cvtPtr = cvtYUV420sp2RGB<0, 1, 3>; break;
     case 320: cvtPtr = cvtYUV420sp2RGB<2, 0, 3>; break;
@@ -1954,6 +2010,9 @@ void cvtOnePlaneYUVtoBGR(const uchar * src_data, size_t src_step,
     int blueIdx = swapBlue ? 2 : 0;
     switch(dcn*1000 + blueIdx*100 + uIdx*10 + ycn)
     {
+    case 2000: cvtPtr = cvtYUV422toRGB<0,0,0,2>; break;
+    case 2001: cvtPtr = cvtYUV422toRGB<0,0,1,2>; break;
+    case 2010: cvtPtr = cvtYUV422toRGB<0,1,0,2>; break;
     case 3000: cvtPtr = cvtYUV422toRGB<0,0,0,3>; break;
     case 3001: cvtPtr = cvtYUV422toRGB<0,0,1,3>; break;
     case 3010: cvtPtr = cvtYUV422toRGB<0,1,0,3>; break;
@@ -1789,6 +1789,206 @@ cvFindContours( void*  img,  CvMemStorage*  storage,
     return cvFindContours_Impl(img, storage, firstContour, cntHeaderSize, mode, method, offset, 1);
 }
 
+namespace cv
+{
+
+/*
+   Contours of a binary image can be traced independently in horizontal bands if
+   no 8-connected component crosses the boundaries of the bands. Contours, their
+   order and hierarchy within a band are the same as in the whole image then, and
+   the bands come in the raster order. A boundary between the rows y - 1 and y is
+   valid iff there are no 8-adjacent runs of non-zero pixels in these rows, so the
+   image is converted to runs first, and the bands are made of the runs.
+*/
+
+// Runs of non-zero pixels of every row as pairs of [x0, x1)
+class ContourRunsInvoker : public ParallelLoopBody
+{
+public:
+    ContourRunsInvoker( const Mat& _src, std::vector<std::vector<int> >& _runs ) :
+        src(&_src), runs(&_runs)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        int width = src->cols;
+        for( int y = range.start; y < range.end; y++ )
+        {
+            const uchar* row = src->ptr(y);
+            std::vector<int>& rowRuns = (*runs)[y];
+            rowRuns.clear();
+            for( int x = 0; x < width; )
+            {
+                x = skipPixels(row, x, width, false);
+                if( x == width )
+                    break;
+                rowRuns.push_back(x);
+                x = skipPixels(row, x, width, true);
+                rowRuns.push_back(x);
+            }
+        }
+    }
+
+    static int countRuns( const uchar* row, int width )
+    {
+        int count = 0;
+        for( int x = skipPixels(row, 0, width, false); x < width; count++ )
+        {
+            x = skipPixels(row, x, width, true);
+            x = skipPixels(row, x, width, false);
+        }
+        return count;
+    }
+
+    // returns the position of the first pixel starting from x which is zero if
+    // nonzero is true and non-zero otherwise
+    static int skipPixels( const uchar* row, int x, int width, bool nonzero )
+    {
+#if CV_SIMD
+        v_uint8 v_zero = vx_setzero_u8();
+        for( ; x <= width - v_uint8::nlanes; x += v_uint8::nlanes )
+        {
+            v_uint8 vmask = vx_load(row + x) == v_zero;
+            if( !nonzero )
+                vmask = ~vmask;
+            if( v_check_any(vmask) )
+                return x + v_scan_forward(vmask);
+        }
+#endif
+        for( ; x < width && (row[x] != 0) == nonzero; x++ )
+            ;
+        return x;
+    }
+
+private:
+    const Mat* src;
+    std::vector<std::vector<int> >* runs;
+};
+
+static bool haveAdjacentRuns( const std::vector<int>& a, const std::vector<int>& b )
+{
+    size_t i = 0, j = 0;
+    while( i < a.size() && j < b.size() )
+    {
+        // [a0, a1) and [b0, b1) are 8-adjacent if a0 <= b1 && b0 <= a1
+        if( a[i+1] < b[j] )
+            i += 2;
+        else if( b[j+1] < a[i] )
+            j += 2;
+        else
+            return true;
+    }
+    return false;
+}
+
+// Traces contours of every band in a separate image with the zero frame
+class FindContoursBandInvoker : public ParallelLoopBody
+{
+public:
+    FindContoursBandInvoker( const std::vector<std::vector<int> >& _runs, const std::vector<int>& _bands,
+                             int _width, int _mode, int _method, Point _offset,
+                             std::vector<MemStorage>& _storages, std::vector<CvSeq*>& _firsts ) :
+        runs(&_runs), bands(&_bands), width(_width), mode(_mode), method(_method), offset(_offset),
+        storages(&_storages), firsts(&_firsts)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        for( int b = range.start; b < range.end; b++ )
+        {
+            int y0 = (*bands)[b], y1 = (*bands)[b+1];
+            Mat image = Mat::zeros(y1 - y0 + 2, width + 2, CV_8UC1);
+            for( int y = y0; y < y1; y++ )
+            {
+                const std::vector<int>& rowRuns = (*runs)[y];
+                uchar* row = image.ptr(y - y0 + 1) + 1;
+                for( size_t i = 0; i < rowRuns.size(); i += 2 )
+                    memset(row + rowRuns[i], 1, rowRuns[i+1] - rowRuns[i]);
+            }
+
+            MemStorage& storage = (*storages)[b];
+            storage = MemStorage(cvCreateMemStorage());
+            CvMat _cimage = cvMat(image);
+            cvFindContours_Impl(&_cimage, storage, &(*firsts)[b], sizeof(CvContour), mode, method,
+                                cvPoint(offset + Point(-1, y0 - 1)), 0);
+        }
+    }
+
+private:
+    const std::vector<std::vector<int> >* runs;
+    const std::vector<int>* bands;
+    int width, mode, method;
+    Point offset;
+    std::vector<MemStorage>* storages;
+    std::vector<CvSeq*>* firsts;
+};
+
+// Finds contours of the image by bands in parallel. Returns false if the image
+// can't be split, the contours are allocated in storages then.
+static bool findContoursByBands( const Mat& image, int mode, int method, Point offset,
+                                 std::vector<MemStorage>& storages, CvSeq*& first )
+{
+    int nthreads = getNumThreads();
+    if( nthreads <= 1 || image.type() != CV_8UC1 || mode < CV_RETR_EXTERNAL || mode >= CV_RETR_FLOODFILL ||
+        method < CV_CHAIN_APPROX_NONE || method > CV_CHAIN_APPROX_TC89_KCOS || (double)image.total() < (1 << 18) )
+        return false;
+
+    // Less than a couple of runs per row mean a single or a few large objects. They are
+    // traced fast by the single scan and likely cross all the band boundaries, so a sample
+    // of rows is checked before the runs of the whole image are found and scanned for adjacency.
+    int rows = image.rows;
+    const int minRunsPerRow = 2, nsamples = std::min(rows, 64);
+    int sampledRuns = 0;
+    for( int i = 0; i < nsamples; i++ )
+        sampledRuns += ContourRunsInvoker::countRuns(image.ptr(i*rows/nsamples), image.cols);
+    if( sampledRuns < nsamples*minRunsPerRow )
+        return false;
+
+    std::vector<std::vector<int> > runs(rows);
+    parallel_for_(Range(0, rows), ContourRunsInvoker(image, runs),
+                  std::max(std::min(rows/16, nthreads), 1));
+
+    // a few bands per thread to balance the load
+    const int minBandHeight = std::max(rows/(nthreads*4), 16);
+    std::vector<int> bands(1, 0);
+    for( int y = minBandHeight; y < rows; y++ )
+    {
+        if( y - bands.back() >= minBandHeight && !haveAdjacentRuns(runs[y-1], runs[y]) )
+            bands.push_back(y);
+    }
+    bands.push_back(rows);
+
+    int nbands = (int)bands.size() - 1;
+    if( nbands <= 1 )
+        return false;
+
+    storages.resize(nbands);
+    std::vector<CvSeq*> firsts(nbands, (CvSeq*)0);
+    parallel_for_(Range(0, nbands), FindContoursBandInvoker(runs, bands, image.cols, mode, method,
+                  offset, storages, firsts), nbands);
+
+    // the top level contours are linked in the reverse order of their finding
+    first = 0;
+    for( int b = 0; b < nbands; b++ )
+    {
+        CvSeq* bandFirst = firsts[b];
+        if( !bandFirst )
+            continue;
+        CvSeq* last = bandFirst;
+        while( last->h_next )
+            last = last->h_next;
+        last->h_next = first;
+        if( first )
+            first->h_prev = last;
+        first = bandFirst;
+    }
+    return true;
+}
+
+}
+
 void cv::findContours( InputOutputArray _image, OutputArrayOfArrays _contours,
                    OutputArray _hierarchy, int mode, int method, Point offset )
 {
@@ -1801,22 +2001,26 @@ void cv::findContours( InputOutputArray _image, OutputArrayOfArrays _contours,
     CV_Assert(_contours.empty() || (_contours.channels() == 2 && _contours.depth() == CV_32S));
 
     Mat image0 = _image.getMat(), image;
-    Point offset0(0, 0);
-    if(method != CV_LINK_RUNS)
-    {
-        offset0 = Point(-1, -1);
-        copyMakeBorder(image0, image, 1, 1, 1, 1, BORDER_CONSTANT | BORDER_ISOLATED, Scalar(0));
-    }
-    else
-    {
-        image = image0;
-    }
     MemStorage storage(cvCreateMemStorage());
-    CvMat _cimage = cvMat(image);
+    std::vector<MemStorage> bandStorages;
     CvSeq* _ccontours = 0;
     if( _hierarchy.needed() )
         _hierarchy.clear();
-    cvFindContours_Impl(&_cimage, storage, &_ccontours, sizeof(CvContour), mode, method, cvPoint(offset0 + offset), 0);
+    if( !findContoursByBands(image0, mode, method, offset, bandStorages, _ccontours) )
+    {
+        Point offset0(0, 0);
+        if(method != CV_LINK_RUNS)
+        {
+            offset0 = Point(-1, -1);
+            copyMakeBorder(image0, image, 1, 1, 1, 1, BORDER_CONSTANT | BORDER_ISOLATED, Scalar(0));
+        }
+        else
+        {
+            image = image0;
+        }
+        CvMat _cimage = cvMat(image);
+        cvFindContours_Impl(&_cimage, storage, &_ccontours, sizeof(CvContour), mode, method, cvPoint(offset0 + offset), 0);
+    }
     if( !_ccontours )
     {
         _contours.clear();
@@ -39,6 +39,7 @@
 //
 //M*/
 #include "precomp.hpp"
+#include <map>
 
 namespace cv
 {
@@ -2369,6 +2370,348 @@ double getFontScaleFromHeight(const int fontFace, const int pixelHeight, const i
     return static_cast<double>(pixelHeight - static_cast<double>((thickness + 1)) / 2.0) / static_cast<double>(cap_line + base_line);
 }
 
+// 8-bit coverage mask of a glyph or a box outline for drawOverlay
+struct OverlayMask
+{
+    Mat mask;
+    Point ofs;  // top-left corner of the mask relative to the pen position or the box corner
+};
+
+// Masks are rendered once and reused at any position: glyphs for quarter pixel horizontal
+// pen offsets (the subpixel offset of the base line is kept), box outlines for the box of
+// the minimal size to stretch in the middle.
+class OverlayMaskCache
+{
+public:
+    enum { PHASE_BITS = 2 };
+
+    OverlayMask glyph(int glyph, int baseLine, int hscale, int phase, int thickness, int lineType)
+    {
+        uint64 key = (uint64)(unsigned)hscale | ((uint64)glyph << 32) | ((uint64)(baseLine & 15) << 44) |
+                     ((uint64)thickness << 48) | ((uint64)lineTypeCode(lineType) << 56) |
+                     ((uint64)phase << 58);
+        OverlayMask m;
+        if( !find(key, m) )
+        {
+            m = renderGlyph(glyph, baseLine, hscale, phase, thickness, lineType);
+            add(key, m);
+        }
+        return m;
+    }
+
+    OverlayMask box(int thickness, int lineType)
+    {
+        uint64 key = (uint64)thickness | ((uint64)lineTypeCode(lineType) << 16) | ((uint64)1 << 63);
+        OverlayMask m;
+        if( !find(key, m) )
+        {
+            int margin = maskMargin(thickness), size = 2*boxCornerSize(thickness) + 1;
+            double buf[4];
+            scalarToRawData(Scalar::all(255), buf, CV_8U, 0);
+            Point2l pt[4];
+            pt[0] = Point2l(margin, margin);
+            pt[1] = Point2l(margin + size - 1, margin);
+            pt[2] = Point2l(margin + size - 1, margin + size - 1);
+            pt[3] = Point2l(margin, margin + size - 1);
+            m.mask = Mat::zeros(size + margin*2, size + margin*2, CV_8U);
+            m.ofs = Point(-margin, -margin);
+            PolyLine(m.mask, pt, 4, true, buf, thickness, lineType, 0);
+            add(key, m);
+        }
+        return m;
+    }
+
+    // LineAA doesn't draw in 2 pixels of the image border
+    static int maskMargin(int thickness) { return thickness/2 + 4; }
+    // corners of thick boxes are rounded, the outline is uniform farther from them
+    static int boxCornerSize(int thickness) { return thickness + 4; }
+
+protected:
+    enum { MAX_MASKS = 4096 };
+
+    static int lineTypeCode(int lineType) { return lineType == CV_AA ? 2 : lineType == 4 ? 1 : 0; }
+
+    bool find(uint64 key, OverlayMask& m)
+    {
+        AutoLock lock(mutex);
+        std::map<uint64, OverlayMask>::const_iterator it = masks.find(key);
+        if( it == masks.end() )
+            return false;
+        m = it->second;
+        return true;
+    }
+
+    void add(uint64 key, const OverlayMask& m)
+    {
+        AutoLock lock(mutex);
+        if( masks.size() >= MAX_MASKS )
+            masks.clear();
+        masks[key] = m;
+    }
+
+    static OverlayMask renderGlyph(int glyph, int baseLine, int hscale, int phase, int thickness, int lineType)
+    {
+        OverlayMask g;
+        int64 x0 = (int64)phase << (XY_SHIFT - PHASE_BITS);
+        const char* ptr = g_HersheyGlyphs[glyph];
+        std::vector<Point2l> pts;
+        std::vector<int> ends;
+        for( ptr += 2; *ptr; )
+        {
+            if( *ptr == ' ' )
+            {
+                ends.push_back((int)pts.size());
+                ptr++;
+                continue;
+            }
+            int x = (uchar)ptr[0] - 'R', y = (uchar)ptr[1] - 'R';
+            ptr += 2;
+            pts.push_back(Point2l((int64)x*hscale + x0, (int64)(y + baseLine)*hscale));
+        }
+        ends.push_back((int)pts.size());
+        if( pts.empty() )
+            return g;
+
+        int64 xmin = pts[0].x, xmax = xmin, ymin = pts[0].y, ymax = ymin;
+        for( size_t i = 1; i < pts.size(); i++ )
+        {
+            xmin = std::min(xmin, pts[i].x); xmax = std::max(xmax, pts[i].x);
+            ymin = std::min(ymin, pts[i].y); ymax = std::max(ymax, pts[i].y);
+        }
+        int margin = maskMargin(thickness);
+        g.ofs = Point((int)(xmin >> XY_SHIFT) - margin, (int)(ymin >> XY_SHIFT) - margin);
+        g.mask = Mat::zeros((int)(ymax >> XY_SHIFT) - g.ofs.y + margin + 1,
+                            (int)(xmax >> XY_SHIFT) - g.ofs.x + margin + 1, CV_8U);
+        for( size_t i = 0; i < pts.size(); i++ )
+            pts[i] -= Point2l((int64)g.ofs.x << XY_SHIFT, (int64)g.ofs.y << XY_SHIFT);
+
+        double buf[4];
+        scalarToRawData(Scalar::all(255), buf, CV_8U, 0);
+        for( size_t i = 0, start = 0; i < ends.size(); start = ends[i++] )
+            if( ends[i] - (int)start > 1 )
+                PolyLine(g.mask, &pts[start], ends[i] - (int)start, false, buf, thickness, lineType, XY_SHIFT);
+        return g;
+    }
+
+    Mutex mutex;
+    std::map<uint64, OverlayMask> masks;
+};
+
+static OverlayMaskCache& getOverlayMaskCache()
+{
+    static OverlayMaskCache cache;
+    return cache;
+}
+
+// Pixel color for drawOverlay: the raw one for solid drawing and
+// the unpacked channels to blend antialiased masks with.
+struct OverlayColor
+{
+    OverlayColor(const Scalar& color, int type, bool _bgr565) : bgr565(_bgr565)
+    {
+        if( bgr565 )
+        {
+            for( int k = 0; k < 3; k++ )
+                unpacked[k] = saturate_cast<uchar>(color[k]);
+            ushort t = (ushort)((unpacked[0] >> 3) | ((unpacked[1] & ~3) << 3) | ((unpacked[2] & ~7) << 8));
+            memcpy(raw, &t, sizeof(t));
+        }
+        else
+        {
+            scalarToRawData(color, raw, type, 0);
+            for( int k = 0; k < 4; k++ )
+                unpacked[k] = saturate_cast<uchar>(color[k]);
+        }
+    }
+
+    double raw[4];
+    uchar unpacked[4];
+    bool bgr565;
+};
+
+// Blends n pixels with the color by the mask; mstep is 0 for the constant mask value
+static void blendSpan( uchar* d, const uchar* m, int mstep, int n, int pix_size, int cn,
+                       const OverlayColor& color, bool antialiased )
+{
+    const uchar* raw = (const uchar*)color.raw;
+    const uchar* c = color.unpacked;
+
+    if( mstep == 0 && (*m == 255 || (*m != 0 && !antialiased)) )
+    {
+        if( n > 0 )
+            ICV_HLINE(d, 0, n - 1, raw, pix_size);
+        return;
+    }
+    for( int x = 0; x < n; x++, d += pix_size, m += mstep )
+    {
+        int a = *m;
+        if( a == 0 )
+            continue;
+        if( !antialiased || a == 255 )
+            memcpy(d, raw, pix_size);
+        else if( color.bgr565 )
+        {
+            int t = *(ushort*)d, b = (t << 3) & 0xf8, g = (t >> 3) & 0xfc, r = (t >> 8) & 0xf8;
+            b = (b*(255 - a) + c[0]*a + 127)/255;
+            g = (g*(255 - a) + c[1]*a + 127)/255;
+            r = (r*(255 - a) + c[2]*a + 127)/255;
+            *(ushort*)d = (ushort)((b >> 3) | ((g & ~3) << 3) | ((r & ~7) << 8));
+        }
+        else
+        {
+            for( int k = 0; k < cn; k++ )
+                d[k] = (uchar)((d[k]*(255 - a) + c[k]*a + 127)/255);
+        }
+    }
+}
+
+static void blendMask( Mat& img, const Mat& mask, Point tl, const OverlayColor& color, bool antialiased )
+{
+    Rect r = Rect(tl, mask.size()) & Rect(0, 0, img.cols, img.rows);
+    int pix_size = (int)img.elemSize(), cn = img.channels();
+    for( int y = r.y; y < r.y + r.height; y++ )
+        blendSpan(img.ptr(y) + r.x*pix_size, mask.ptr(y - tl.y) + (r.x - tl.x), 1, r.width,
+                  pix_size, cn, color, antialiased);
+}
+
+// Draws the box outline from the mask of the minimal box: the middle row and column of the
+// mask are repeated to stretch it to the box size.
+static void blendBox( Mat& img, const Rect& box, const OverlayMask& outline, int cornerSize,
+                      const OverlayColor& color, bool antialiased )
+{
+    const Mat& mask = outline.mask;
+    const int margin = -outline.ofs.x, mid = margin + cornerSize;
+    const Rect outer(box.x - margin, box.y - margin, box.width + margin*2, box.height + margin*2);
+    const Rect r = outer & Rect(0, 0, img.cols, img.rows);
+    const int pix_size = (int)img.elemSize(), cn = img.channels();
+    // columns of the image where the left corners end and the right ones start
+    const int x1 = std::max(std::min(box.x + cornerSize, r.x + r.width), r.x);
+    const int x2 = std::max(std::min(box.x + box.width - cornerSize, r.x + r.width), x1);
+    const int rx = outer.x + outer.width - mask.cols;
+
+    for( int y = r.y; y < r.y + r.height; y++ )
+    {
+        int my = y < box.y + cornerSize ? y - outer.y :
+                 y >= box.y + box.height - cornerSize ? y - (outer.y + outer.height - mask.rows) : mid;
+        const uchar* m = mask.ptr(my);
+        uchar* d = img.ptr(y);
+        blendSpan(d + r.x*pix_size, m + (r.x - outer.x), 1, x1 - r.x, pix_size, cn, color, antialiased);
+        if( m[mid] != 0 )
+            blendSpan(d + x1*pix_size, m + mid, 0, x2 - x1, pix_size, cn, color, antialiased);
+        blendSpan(d + x2*pix_size, m + (x2 - rx), 1, r.x + r.width - x2, pix_size, cn, color, antialiased);
+    }
+}
+
+static void overlayText( Mat& img, const String& text, Point org, int fontFace, double fontScale,
+                         const OverlayColor& color, int lineType )
+{
+    const int* ascii = getFontData(fontFace);
+    int base_line = -(ascii[0] & 15);
+    int hscale = cvRound(fontScale*XY_ONE);
+    OverlayMaskCache& cache = getOverlayMaskCache();
+    const int phase_shift = XY_SHIFT - OverlayMaskCache::PHASE_BITS;
+    int64 view_x = (int64)org.x << XY_SHIFT;
+
+    for( int i = 0; i < (int)text.size(); i++ )
+    {
+        int c = (uchar)text[i];
+        readCheck(c, i, text, fontFace);
+
+        int glyph = ascii[(c-' ')+1];
+        const char* ptr = g_HersheyGlyphs[glyph];
+        view_x -= ((uchar)ptr[0] - 'R')*hscale;
+        int64 pen_x = (view_x + (1 << (phase_shift - 1))) >> phase_shift;
+        int phase = (int)(pen_x & ((1 << OverlayMaskCache::PHASE_BITS) - 1));
+        OverlayMask g = cache.glyph(glyph, base_line, hscale, phase, 1, lineType);
+        if( !g.mask.empty() )
+        {
+            Point pen((int)(pen_x >> OverlayMaskCache::PHASE_BITS), org.y);
+            blendMask(img, g.mask, pen + g.ofs, color, lineType == CV_AA);
+        }
+        view_x += ((uchar)ptr[1] - 'R')*hscale;
+    }
+}
+
+void drawOverlay( InputOutputArray _img, const std::vector<Rect>& boxes,
+                  const std::vector<String>& labels, const std::vector<Scalar>& colors,
+                  int thickness, int fontFace, double fontScale, const Scalar& textColor,
+                  int lineType, int flags )
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( labels.empty() || labels.size() == boxes.size() );
+    CV_Assert( colors.size() == 1 || colors.size() == boxes.size() );
+    CV_Assert( thickness <= MAX_THICKNESS );
+    if( boxes.empty() )
+        return;
+
+    Mat img = _img.getMat();
+    const bool bgr565 = (flags & OVERLAY_BGR565) != 0;
+    if( bgr565 )
+        CV_Assert( img.type() == CV_8UC2 );
+    if( lineType == CV_AA && img.depth() != CV_8U )
+        lineType = 8;
+    // antialiased lines would blend bytes of packed pixels
+    const int boxLineType = bgr565 && lineType == CV_AA ? 8 : lineType;
+    getFontData(fontFace);
+
+    const int pix_size = (int)img.elemSize();
+    const OverlayColor text_color(textColor, img.type(), bgr565);
+    const int cornerSize = OverlayMaskCache::boxCornerSize(thickness);
+    OverlayMask outline;
+    if( thickness > 0 && thickness <= 255 )
+        outline = getOverlayMaskCache().box(thickness, boxLineType);
+
+    for( size_t i = 0; i < boxes.size(); i++ )
+    {
+        const Rect& box = boxes[i];
+        const OverlayColor color(colors[colors.size() == 1 ? 0 : i], img.type(), bgr565);
+
+        if( !box.empty() && thickness != 0 )
+        {
+            if( !outline.mask.empty() && std::min(box.width, box.height) > cornerSize*2 )
+                blendBox(img, box, outline, cornerSize, color, boxLineType == CV_AA);
+            else if( thickness < 0 && boxLineType != CV_AA )
+            {
+                Rect r = box & Rect(0, 0, img.cols, img.rows);
+                for( int y = r.y; y < r.y + r.height; y++ )
+                    ICV_HLINE(img.ptr(y), r.x, r.x + r.width - 1, color.raw, pix_size);
+            }
+            else
+            {
+                Point2l pt[4];
+                pt[0] = box.tl();
+                pt[2] = box.br() - Point(1, 1);
+                pt[1].x = pt[2].x;
+                pt[1].y = pt[0].y;
+                pt[3].x = pt[0].x;
+                pt[3].y = pt[2].y;
+                if( thickness > 0 )
+                    PolyLine( img, pt, 4, true, color.raw, thickness, boxLineType, 0 );
+                else
+                    FillConvexPoly( img, pt, 4, color.raw, boxLineType, 0 );
+            }
+        }
+
+        if( labels.empty() || labels[i].empty() )
+            continue;
+
+        // the label is put on top of the box and shifted inside the image
+        int baseLine = 0;
+        Size size = getTextSize(labels[i], fontFace, fontScale, 1, &baseLine);
+        Point org(box.x, box.y - size.height - baseLine);
+        org.x = std::max(std::min(org.x, img.cols - size.width), 0);
+        org.y = std::max(org.y, 0);
+
+        Rect background = Rect(org, Size(size.width, size.height + baseLine)) & Rect(0, 0, img.cols, img.rows);
+        for( int y = background.y; y < background.y + background.height; y++ )
+            ICV_HLINE(img.ptr(y), background.x, background.x + background.width - 1, color.raw, pix_size);
+
+        overlayText(img, labels[i], Point(org.x, org.y + size.height), fontFace, fontScale,
+                    text_color, lineType);
+    }
+}
+
 }
 
 
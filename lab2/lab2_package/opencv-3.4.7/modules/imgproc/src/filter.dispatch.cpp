@@ -1177,6 +1177,46 @@ static bool dftFilter2D(int stype, int dtype, int kernel_type,
     return true;
 }
 
+// Applies linear filter by horizontal stripes of the destination image. Every
+// stripe has its own filter engine (and so its own ring buffer of rows). The
+// stripe is processed as ROI of the whole source image so rows above and below
+// of it are read from the image and border extrapolation takes place at the
+// image borders only.
+class LinearFilterInvoker : public ParallelLoopBody
+{
+public:
+    LinearFilterInvoker(int _stype, int _dtype, const Mat& _kernel, const Mat& _kernelY,
+                        Point _anchor, double _delta, int _borderType,
+                        const Mat& _src, Mat& _dst, Size _wholeSize, Point _ofs)
+        : stype(_stype), dtype(_dtype), kernel(_kernel), kernelY(_kernelY), anchor(_anchor),
+          delta(_delta), borderType(_borderType), src(_src), dst(_dst), wholeSize(_wholeSize), ofs(_ofs)
+    {}
+
+    virtual void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        // Empty kernelY means 2D kernel.
+        Ptr<FilterEngine> f = kernelY.empty() ?
+            createLinearFilter(stype, dtype, kernel, anchor, delta, borderType) :
+            createSeparableLinearFilter(stype, dtype, kernel, kernelY, anchor, delta, borderType);
+        Mat dstStripe = dst.rowRange(range);
+        f->apply(src.rowRange(range), dstStripe, wholeSize, Point(ofs.x, ofs.y + range.start));
+    }
+
+private:
+    int stype, dtype;
+    const Mat& kernel;
+    const Mat& kernelY;
+    Point anchor;
+    double delta;
+    int borderType;
+    const Mat& src;
+    Mat& dst;
+    Size wholeSize;
+    Point ofs;
+};
+
 static void ocvFilter2D(int stype, int dtype, int kernel_type,
                         uchar * src_data, size_t src_step,
                         uchar * dst_data, size_t dst_step,
@@ -1190,10 +1230,20 @@ static void ocvFilter2D(int stype, int dtype, int kernel_type,
 {
     int borderTypeValue = borderType & ~BORDER_ISOLATED;
     Mat kernel = Mat(Size(kernel_width, kernel_height), kernel_type, kernel_data, kernel_step);
-    Ptr<FilterEngine> f = createLinearFilter(stype, dtype, kernel, Point(anchor_x, anchor_y), delta,
-                                             borderTypeValue);
     Mat src(Size(width, height), stype, src_data, src_step);
     Mat dst(Size(width, height), dtype, dst_data, dst_step);
+    int nstripes = getFilterNumStripes(src_data, src_step, dst_data, dst_step, width, height, kernel_height);
+    if (nstripes > 1)
+    {
+        parallel_for_(Range(0, height),
+                      LinearFilterInvoker(stype, dtype, kernel, Mat(), Point(anchor_x, anchor_y), delta,
+                                          borderTypeValue, src, dst, Size(full_width, full_height),
+                                          Point(offset_x, offset_y)),
+                      nstripes);
+        return;
+    }
+    Ptr<FilterEngine> f = createLinearFilter(stype, dtype, kernel, Point(anchor_x, anchor_y), delta,
+                                             borderTypeValue);
     f->apply(src, dst, Size(full_width, full_height), Point(offset_x, offset_y));
 }
 
@@ -1230,11 +1280,21 @@ static void ocvSepFilter(int stype, int dtype, int ktype,
 {
     Mat kernelX(Size(kernelx_len, 1), ktype, kernelx_data);
     Mat kernelY(Size(kernely_len, 1), ktype, kernely_data);
+    Mat src(Size(width, height), stype, src_data, src_step);
+    Mat dst(Size(width, height), dtype, dst_data, dst_step);
+    int nstripes = getFilterNumStripes(src_data, src_step, dst_data, dst_step, width, height, kernely_len);
+    if (nstripes > 1)
+    {
+        parallel_for_(Range(0, height),
+                      LinearFilterInvoker(stype, dtype, kernelX, kernelY, Point(anchor_x, anchor_y), delta,
+                                          borderType & ~BORDER_ISOLATED, src, dst,
+                                          Size(full_width, full_height), Point(offset_x, offset_y)),
+                      nstripes);
+        return;
+    }
     Ptr<FilterEngine> f = createSeparableLinearFilter(stype, dtype, kernelX, kernelY,
                                                       Point(anchor_x, anchor_y),
                                                       delta, borderType & ~BORDER_ISOLATED);
-    Mat src(Size(width, height), stype, src_data, src_step);
-    Mat dst(Size(width, height), dtype, dst_data, dst_step);
     f->apply(src, dst, Size(full_width, full_height), Point(offset_x, offset_y));
 };
 
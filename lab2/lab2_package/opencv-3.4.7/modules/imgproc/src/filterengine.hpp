@@ -338,6 +338,11 @@ Ptr<FilterEngine> createBoxFilter( int srcType, int dstType, Size ksize,
                                               int borderType = BORDER_DEFAULT);
 
 
+//! minimal kernel sizes to use van Herk/Gil-Werman 1D morphological filters for.
+//! Their cost doesn't depend on the kernel size, but it's higher than the cost of
+//! the vectorized straightforward filters for short kernels.
+enum { MORPH_VHGW_MIN_ROW_KSIZE = 64, MORPH_VHGW_MIN_COLUMN_KSIZE = 16 };
+
 //! returns horizontal 1D morphological filter
 Ptr<BaseRowFilter> getMorphologyRowFilter(int op, int type, int ksize, int anchor = -1);
 
@@ -364,6 +369,22 @@ static inline Point normalizeAnchor( Point anchor, Size ksize )
    return anchor;
 }
 
+// Returns number of horizontal stripes to filter an image by in parallel or 1
+// if single thread is better.
+static inline int getFilterNumStripes( const uchar* src_data, size_t src_step,
+                                       const uchar* dst_data, size_t dst_step,
+                                       int width, int height, int kernel_height )
+{
+    // In-place filtering reads rows which are already written by other stripes.
+    if( src_data < dst_data + dst_step*height && dst_data < src_data + src_step*height )
+        return 1;
+    // Stripes have to be high enough to amortize filtering of extra
+    // kernel_height - 1 rows and creation of filter engine.
+    const int minStripeHeight = std::max(16, 4*kernel_height);
+    double nstripes = std::min((double)height/minStripeHeight, (double)width*height/(1 << 16));
+    return (int)std::min(nstripes, (double)getNumThreads());
+}
+
 void preprocess2DKernel( const Mat& kernel, std::vector<Point>& coords, std::vector<uchar>& coeffs );
 void crossCorr( const Mat& src, const Mat& templ, Mat& dst,
                Point anchor=Point(0,0), double delta=0,
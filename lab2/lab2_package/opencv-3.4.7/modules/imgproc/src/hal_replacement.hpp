@@ -490,7 +490,7 @@ inline int hal_ni_cvtLabtoBGR(const uchar * src_data, size_t src_step, uchar * d
    @param src_data,src_step source image data and step
    @param dst_data,dst_step destination image data and step
    @param dst_width,dst_height destination image size
-   @param dcn destination image channels (3 or 4)
+   @param dcn destination image channels (3 or 4, 2 for packed BGR565)
    @param swapBlue if set to true B and R destination channels will be swapped (write RGB)
    @param uIdx U-channel index in the interleaved U/V plane (0 or 1)
    Convert from YUV (YUV420sp (or NV12/NV21) - Y plane followed by interleaved U/V plane) to BGR, RGB, BGRA or RGBA.
@@ -516,7 +516,7 @@ inline int hal_ni_cvtThreePlaneYUVtoBGR(const uchar * src_data, size_t src_step,
    @param src_data,src_step source image data and step
    @param dst_data,dst_step destination image data and step
    @param width,height image size
-   @param scn source image channels (3 or 4)
+   @param scn source image channels (3 or 4, 2 for packed BGR565)
    @param swapBlue if set to true B and R source channels will be swapped (treat as RGB)
    @param uIdx U-channel plane index (0 or 1)
    Convert from BGR, RGB, BGRA or RGBA to YUV (YUV420p (or YV12/YV21) - Y plane followed by U and V planes).
@@ -529,7 +529,7 @@ inline int hal_ni_cvtBGRtoThreePlaneYUV(const uchar * src_data, size_t src_step,
    @param src_data,src_step source image data and step
    @param dst_data,dst_step destination image data and step
    @param width,height image size
-   @param dcn destination image channels (3 or 4)
+   @param dcn destination image channels (3 or 4, 2 for packed BGR565)
    @param swapBlue if set to true B and R destination channels will be swapped (write RGB)
    @param uIdx U-channel index (0 or 1)
    @param ycn Y-channel index (0 or 1)
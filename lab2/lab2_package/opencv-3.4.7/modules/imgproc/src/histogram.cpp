@@ -3245,6 +3245,222 @@ private:
     int* lut_;
 };
 
+namespace cv {
+
+// Copies luma of a row of cn-channel YUV pixels, luma is the yIdx-th channel.
+static void copyLumaRow( const uchar* src, uchar* dst, int width, int cn, int yIdx )
+{
+    if( cn == 1 )
+    {
+        memcpy(dst, src, width);
+        return;
+    }
+
+    int x = 0;
+#if CV_SIMD
+    const int vsize = v_uint8::nlanes;
+    for( ; x <= width - vsize; x += vsize )
+    {
+        v_uint8 a, b;
+        v_load_deinterleave(src + 2*x, a, b);
+        v_store(dst + x, yIdx ? b : a);
+    }
+    vx_cleanup();
+#endif
+    for( ; x < width; x++ )
+        dst[x] = src[2*x + yIdx];
+}
+
+// Averages 2x2 blocks of luma of two rows with the same rounding as resize with INTER_AREA.
+static void downscaleLumaRow2( const uchar* src0, const uchar* src1, uchar* dst, int width, int cn, int yIdx )
+{
+    int x = 0;
+#if CV_SIMD
+    const int vsize = v_uint8::nlanes;
+    const v_uint16 v2 = vx_setall_u16(2);
+    for( ; x <= width - vsize; x += vsize )
+    {
+        v_uint8 a0, b0, a1, b1;
+        if( cn == 1 )
+        {
+            v_load_deinterleave(src0 + 2*x, a0, b0);
+            v_load_deinterleave(src1 + 2*x, a1, b1);
+        }
+        else
+        {
+            v_uint8 c0, c1, c2, c3;
+            v_load_deinterleave(src0 + 4*x, c0, c1, c2, c3);
+            a0 = yIdx ? c1 : c0; b0 = yIdx ? c3 : c2;
+            v_load_deinterleave(src1 + 4*x, c0, c1, c2, c3);
+            a1 = yIdx ? c1 : c0; b1 = yIdx ? c3 : c2;
+        }
+
+        v_uint16 s0, s1, t0, t1;
+        v_expand(a0, s0, s1);
+        v_expand(b0, t0, t1); s0 += t0; s1 += t1;
+        v_expand(a1, t0, t1); s0 += t0; s1 += t1;
+        v_expand(b1, t0, t1); s0 += t0; s1 += t1;
+        v_store(dst + x, v_pack((s0 + v2) >> 2, (s1 + v2) >> 2));
+    }
+    vx_cleanup();
+#endif
+    for( ; x < width; x++ )
+    {
+        const uchar* s0 = src0 + 2*cn*x + yIdx;
+        const uchar* s1 = src1 + 2*cn*x + yIdx;
+        dst[x] = (uchar)((s0[0] + s0[cn] + s1[0] + s1[cn] + 2) >> 2);
+    }
+}
+
+// Sums luma of scale rows into buf by columns, then averages scale x scale blocks of
+// the sums. The rounding is the same as resize with INTER_AREA does.
+static void downscaleLumaRow( const uchar* src, size_t sstep, uchar* dst, int width,
+                              int cn, int yIdx, int scale, ushort* buf )
+{
+    const int n = width*scale;
+    for( int k = 0; k < scale; k++, src += sstep )
+    {
+        int x = 0;
+#if CV_SIMD
+        const int vsize = v_uint8::nlanes;
+        for( ; x <= n - vsize; x += vsize )
+        {
+            v_uint8 a, b;
+            if( cn == 1 )
+                a = vx_load(src + x);
+            else
+            {
+                v_load_deinterleave(src + 2*x, a, b);
+                if( yIdx )
+                    a = b;
+            }
+
+            v_uint16 l, h;
+            v_expand(a, l, h);
+            if( k > 0 )
+            {
+                l += vx_load(buf + x);
+                h += vx_load(buf + x + v_uint16::nlanes);
+            }
+            v_store(buf + x, l);
+            v_store(buf + x + v_uint16::nlanes, h);
+        }
+        vx_cleanup();
+#endif
+        for( ; x < n; x++ )
+            buf[x] = (ushort)((k > 0 ? buf[x] : 0) + src[x*cn + yIdx]);
+    }
+
+    const float a = 1.f/(scale*scale);
+    for( int x = 0; x < width; x++, buf += scale )
+    {
+        int sum = 0;
+        for( int k = 0; k < scale; k++ )
+            sum += buf[k];
+        dst[x] = cv::saturate_cast<uchar>(sum*a);
+    }
+}
+
+class ExtractLumaCalcHist_Invoker : public cv::ParallelLoopBody
+{
+public:
+    enum {HIST_SZ = 256};
+
+    ExtractLumaCalcHist_Invoker(const cv::Mat& src, cv::Mat& dst, int cn, int yIdx, int scale,
+                                int* histogram, cv::Mutex* histogramLock)
+        : src_(src), dst_(dst), cn_(cn), yIdx_(yIdx), scale_(scale),
+          globalHistogram_(histogram), histogramLock_(histogramLock)
+    { }
+
+    void operator()( const cv::Range& rowRange ) const CV_OVERRIDE
+    {
+        int localHistogram[HIST_SZ] = {0, };
+
+        const size_t sstep = src_.step;
+        const int width = dst_.cols;
+        cv::AutoBuffer<ushort> _buf(scale_ > 2 ? width*scale_ : 0);
+
+        for( int y = rowRange.start; y < rowRange.end; y++ )
+        {
+            const uchar* sptr = src_.ptr<uchar>(y*scale_);
+            uchar* dptr = dst_.ptr<uchar>(y);
+
+            if( scale_ == 1 )
+                copyLumaRow(sptr, dptr, width, cn_, yIdx_);
+            else if( scale_ == 2 )
+                downscaleLumaRow2(sptr, sptr + sstep, dptr, width, cn_, yIdx_);
+            else
+                downscaleLumaRow(sptr, sstep, dptr, width, cn_, yIdx_, scale_, _buf.data());
+
+            if( !globalHistogram_ )
+                continue;
+
+            int x = 0;
+            for (; x <= width - 4; x += 4)
+            {
+                int t0 = dptr[x], t1 = dptr[x+1];
+                localHistogram[t0]++; localHistogram[t1]++;
+                t0 = dptr[x+2]; t1 = dptr[x+3];
+                localHistogram[t0]++; localHistogram[t1]++;
+            }
+
+            for (; x < width; ++x)
+                localHistogram[dptr[x]]++;
+        }
+
+        if( !globalHistogram_ )
+            return;
+
+        cv::AutoLock lock(*histogramLock_);
+
+        for( int i = 0; i < HIST_SZ; i++ )
+            globalHistogram_[i] += localHistogram[i];
+    }
+
+    static bool isWorthParallel( const cv::Mat& src )
+    {
+        return ( src.total() >= 640*480 );
+    }
+
+private:
+    ExtractLumaCalcHist_Invoker& operator=(const ExtractLumaCalcHist_Invoker&);
+
+    const cv::Mat& src_;
+    cv::Mat& dst_;
+    int cn_, yIdx_, scale_;
+    int* globalHistogram_;
+    cv::Mutex* histogramLock_;
+};
+
+// Builds the equalization table of the histogram of total pixels. Returns false if all
+// the pixels have the same value, the table maps everything to this value then.
+static bool calcEqualizeHistLut( const int* hist, int total, int* lut )
+{
+    const int hist_sz = EqualizeHistCalcHist_Invoker::HIST_SZ;
+
+    int i = 0;
+    while (!hist[i]) ++i;
+
+    if (hist[i] == total)
+    {
+        for (int j = 0; j < hist_sz; j++)
+            lut[j] = i;
+        return false;
+    }
+
+    float scale = (hist_sz - 1.f)/(total - hist[i]);
+    int sum = 0;
+
+    for (lut[i++] = 0; i < hist_sz; ++i)
+    {
+        sum += hist[i];
+        lut[i] = cv::saturate_cast<uchar>(sum * scale);
+    }
+    return true;
+}
+
+} // namespace cv
+
 CV_IMPL void cvEqualizeHist( const CvArr* srcarr, CvArr* dstarr )
 {
     cv::equalizeHist(cv::cvarrToMat(srcarr), cv::cvarrToMat(dstarr));
@@ -3372,26 +3588,74 @@ void cv::equalizeHist( InputArray _src, OutputArray _dst )
     else
         calcBody(heightRange);
 
-    int i = 0;
-    while (!hist[i]) ++i;
-
-    int total = (int)src.total();
-    if (hist[i] == total)
+    if (!calcEqualizeHistLut(hist, (int)src.total(), lut))
     {
-        dst.setTo(i);
+        dst.setTo(lut[0]);
         return;
     }
 
-    float scale = (hist_sz - 1.f)/(total - hist[i]);
-    int sum = 0;
+    if(EqualizeHistLut_Invoker::isWorthParallel(src))
+        parallel_for_(heightRange, lutBody);
+    else
+        lutBody(heightRange);
+}
 
-    for (lut[i++] = 0; i < hist_sz; ++i)
+void cv::extractLuma( InputArray _src, OutputArray _dst, int code, int scale, bool equalize )
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( 1 <= scale && scale <= 16 );
+
+    int stype = _src.type(), cn = 1, yIdx = 0;
+    Size lumaSz = _src.size();
+    switch( code )
     {
-        sum += hist[i];
-        lut[i] = saturate_cast<uchar>(sum * scale);
+    case COLOR_YUV2GRAY_420:
+        CV_Assert( stype == CV_8UC1 && lumaSz.width % 2 == 0 && lumaSz.height % 3 == 0 );
+        lumaSz.height = lumaSz.height * 2 / 3;
+        break;
+    case COLOR_YUV2GRAY_UYVY:
+    case COLOR_YUV2GRAY_YUY2:
+        CV_Assert( stype == CV_8UC2 );
+        cn = 2;
+        yIdx = code == COLOR_YUV2GRAY_UYVY ? 1 : 0;
+        break;
+    default:
+        CV_Error( CV_StsBadFlag, "Unknown/unsupported color conversion code" );
     }
 
-    if(EqualizeHistLut_Invoker::isWorthParallel(src))
+    Mat src = _src.getMat();
+    _dst.create( lumaSz.height / scale, lumaSz.width / scale, CV_8UC1 );
+    Mat dst = _dst.getMat();
+    if (dst.empty())
+        return;
+
+    Mutex histogramLockInstance;
+
+    const int hist_sz = ExtractLumaCalcHist_Invoker::HIST_SZ;
+    int hist[hist_sz] = {0,};
+    int lut[hist_sz];
+
+    ExtractLumaCalcHist_Invoker calcBody(src, dst, cn, yIdx, scale,
+                                         equalize ? hist : 0, &histogramLockInstance);
+    cv::Range heightRange(0, dst.rows);
+
+    if(ExtractLumaCalcHist_Invoker::isWorthParallel(src))
+        parallel_for_(heightRange, calcBody);
+    else
+        calcBody(heightRange);
+
+    if (!equalize)
+        return;
+
+    if (!calcEqualizeHistLut(hist, (int)dst.total(), lut))
+    {
+        dst.setTo(lut[0]);
+        return;
+    }
+
+    EqualizeHistLut_Invoker lutBody(dst, dst, lut);
+    if(EqualizeHistLut_Invoker::isWorthParallel(dst))
         parallel_for_(heightRange, lutBody);
     else
         lutBody(heightRange);
@@ -80,8 +80,10 @@ void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize);
 
 #ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
+// Computes the destination rows [rowRange.start, rowRange.end) of the columns
+// [colRange.start, colRange.end), the source is extended by ksize/2 columns.
 static void
-medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize )
+medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize, const Range& colRange, const Range& rowRange )
 {
     CV_INSTRUMENT_REGION();
 
@@ -132,22 +134,27 @@ medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize )
     HT* h_coarse = alignPtr(&_h_coarse[0], CV_ALIGNMENT);
     HT* h_fine = alignPtr(&_h_fine[0], CV_ALIGNMENT);
 
-    for( int x = 0; x < _dst.cols; x += STRIPE_SIZE )
+    for( int x = colRange.start; x < colRange.end; x += STRIPE_SIZE )
     {
-        int i, j, k, c, n = std::min(_dst.cols - x, STRIPE_SIZE) + r*2;
+        int i, j, k, c, n = std::min(colRange.end - x, STRIPE_SIZE) + r*2;
         const uchar* src = _src.ptr() + x*cn;
         uchar* dst = _dst.ptr() + (x - r)*cn;
 
         memset( h_coarse, 0, 16*n*cn*sizeof(h_coarse[0]) );
         memset( h_fine, 0, 16*16*n*cn*sizeof(h_fine[0]) );
 
-        // First row initialization
+        // First row initialization: the column histograms of the row before it
         for( c = 0; c < cn; c++ )
         {
-            for( j = 0; j < n; j++ )
-                COP( c, j, src[cn*j+c], += (HT)(r+2) );
+            i = rowRange.start - r - 1;
+            if( i < 0 )
+            {
+                for( j = 0; j < n; j++ )
+                    COP( c, j, src[cn*j+c], += (HT)(1 - i) );
+                i = 1;
+            }
 
-            for( i = 1; i < r; i++ )
+            for( ; i < rowRange.start + r; i++ )
             {
                 const uchar* p = src + sstep*std::min(i, m-1);
                 for ( j = 0; j < n; j++ )
@@ -155,7 +162,7 @@ medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize )
             }
         }
 
-        for( i = 0; i < m; i++ )
+        for( i = rowRange.start; i < rowRange.end; i++ )
         {
             const uchar* p0 = src + sstep * std::max( 0, i-r-1 );
             const uchar* p1 = src + sstep * std::min( m-1, i+r );
@@ -344,8 +351,10 @@ medianBlur_8u_O1( const Mat& _src, Mat& _dst, int ksize )
 #undef COP
 }
 
+// Computes the destination columns [colRange.start, colRange.end), the source
+// is extended by m/2 columns.
 static void
-medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m )
+medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m, const Range& colRange )
 {
     CV_INSTRUMENT_REGION();
 
@@ -370,7 +379,9 @@ medianBlur_8u_Om( const Mat& _src, Mat& _dst, int m )
     }
 
     //CV_Assert( size.height >= nx && size.width >= nx );
-    for( x = 0; x < size.width; x++, src += cn, dst += cn )
+    src += colRange.start*cn;
+    dst += colRange.start*cn;
+    for( x = colRange.start; x < colRange.end; x++, src += cn, dst += cn )
     {
         uchar* dst_cur = dst;
         const uchar* src_top = src;
@@ -943,6 +954,171 @@ medianBlur_SortNet( const Mat& _src, Mat& _dst, int m )
     }
 }
 
+// Runs the histogram based filters by tasks: stripes of columns first, and
+// stripes of rows too if there are not enough columns to load all the threads.
+// Om filter keeps the histogram of the whole column, so it's split by columns only.
+class MedianBlur8uInvoker : public ParallelLoopBody
+{
+public:
+    MedianBlur8uInvoker( const Mat& _src, Mat& _dst, int _ksize, bool _useOm ) :
+        src(&_src), dst(&_dst), ksize(_ksize), useOm(_useOm)
+    {
+        int nthreads = std::max(getNumThreads(), 1), cols = dst->cols;
+        colStripeSize = useOm ? std::max(cols/nthreads, 16) : std::min(cols, 512/dst->channels());
+        colStripes = (cols + colStripeSize - 1)/colStripeSize;
+        rowStripes = 1;
+        if( !useOm && colStripes < nthreads )
+            rowStripes = std::max(std::min((nthreads + colStripes - 1)/colStripes,
+                                           dst->rows/std::max(ksize*2, 32)), 1);
+    }
+
+    int tasks() const { return colStripes*rowStripes; }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        for( int t = range.start; t < range.end; t++ )
+        {
+            int cs = t % colStripes, rs = t / colStripes;
+            Range cols(cs*colStripeSize, std::min((cs + 1)*colStripeSize, dst->cols));
+            if( useOm )
+                medianBlur_8u_Om( *src, *dst, ksize, cols );
+            else
+                medianBlur_8u_O1( *src, *dst, ksize, cols,
+                                  Range(rs*dst->rows/rowStripes, (rs + 1)*dst->rows/rowStripes) );
+        }
+    }
+
+private:
+    const Mat* src;
+    Mat* dst;
+    int ksize;
+    bool useOm;
+    int colStripeSize, colStripes, rowStripes;
+};
+
+#if CV_SIMD_WIDTH > 16
+// Adapts the wide part of MinMaxVec* to the interface of the 128-bit one.
+template<class VecOp> struct MinMaxWideVec
+{
+    typedef typename VecOp::value_type value_type;
+    typedef typename VecOp::warg_type arg_type;
+    enum { SIZE = VecOp::WSIZE };
+    arg_type load(const value_type* ptr) { return vop.wload(ptr); }
+    void store(value_type* ptr, const arg_type &val) { vop.store(ptr, val); }
+    void operator()(arg_type& a, arg_type& b) const { vop(a, b); }
+    VecOp vop;
+};
+#endif
+
+enum { MEDIAN_SELECT_MAX_KSIZE = 9 };
+
+// Forgetful selection of the median of n values: a set of n/2 + 2 values can't
+// have both its minimum and maximum be the median, so they are dropped and the
+// next value is added until 3 values are left. The median of n values is the
+// median of the last 3. It takes about 3/8*n^2 compare-exchanges, which is less
+// than sorting for n <= 81, and works for vectors of pixels the same way.
+template<class Op, typename V, typename T> static inline V
+medianSelect( Op& op, const T* ptr, const int* ofs, int n, V* a )
+{
+    int i, k, size = n/2 + 2;
+    for( i = 0; i < size; i++ )
+        a[i] = op.load(ptr + ofs[i]);
+
+    for( k = size; k < n; k++, a++, size-- )
+    {
+        // the minimum and the maximum are found by two independent chains
+        // to hide latencies of compare-exchanges
+        V lo0 = a[0], hi0 = a[1], lo1 = a[2], hi1 = a[3];
+        op(lo0, hi0); op(lo1, hi1);
+        for( i = 4; i < size - 1; i += 2 )
+        {
+            V t0 = a[i], t1 = a[i+1];
+            op(lo0, t0); op(t0, hi0);
+            op(lo1, t1); op(t1, hi1);
+            a[i] = t0; a[i+1] = t1;
+        }
+        if( i < size )
+        {
+            V t = a[i];
+            op(lo0, t); op(t, hi0);
+            a[i] = t;
+        }
+        op(lo0, lo1); op(hi1, hi0);
+
+        // drop lo0 and hi0, the rest of values is a[1], ..., a[size-1]
+        a[1] = op.load(ptr + ofs[k]);
+        a[2] = lo1; a[3] = hi1;
+    }
+
+    op(a[0], a[1]); op(a[1], a[2]); op(a[0], a[1]);
+    return a[1];
+}
+
+// Median filter of the source extended by m/2 pixels from each side. It's used
+// for the aperture sizes up to MEDIAN_SELECT_MAX_KSIZE the histogram based
+// filters don't support.
+template<class Op, class VecOp>
+class MedianBlurSelectInvoker : public ParallelLoopBody
+{
+public:
+    typedef typename Op::value_type T;
+    typedef typename Op::arg_type WT;
+#if CV_SIMD_WIDTH > 16
+    typedef MinMaxWideVec<VecOp> SelectVecOp;
+#else
+    typedef VecOp SelectVecOp;
+#endif
+    typedef typename SelectVecOp::arg_type VT;
+
+    MedianBlurSelectInvoker( const Mat& _src, Mat& _dst, int _m ) :
+        src(&_src), dst(&_dst), m(_m)
+    {
+        CV_Assert( m <= MEDIAN_SELECT_MAX_KSIZE );
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        const int cn = dst->channels(), width = dst->cols*cn, n = m*m;
+        int ofs[MEDIAN_SELECT_MAX_KSIZE*MEDIAN_SELECT_MAX_KSIZE];
+        WT a[MEDIAN_SELECT_MAX_KSIZE*MEDIAN_SELECT_MAX_KSIZE/2 + 2];
+        Op op;
+
+        for( int dy = 0; dy < m; dy++ )
+            for( int dx = 0; dx < m; dx++ )
+                ofs[dy*m + dx] = dy*(int)(src->step/sizeof(T)) + dx*cn;
+
+        for( int y = range.start; y < range.end; y++ )
+        {
+            const T* S = src->ptr<T>(y);
+            T* D = dst->ptr<T>(y);
+            int j = 0;
+
+#if CV_SIMD
+            if( width >= SelectVecOp::SIZE )
+            {
+                VT va[MEDIAN_SELECT_MAX_KSIZE*MEDIAN_SELECT_MAX_KSIZE/2 + 2];
+                SelectVecOp vop;
+                for( ; j < width; j += SelectVecOp::SIZE )
+                {
+                    // the tail is processed by the last full vector
+                    j = std::min(j, width - (int)SelectVecOp::SIZE);
+                    vop.store(D + j, medianSelect(vop, S + j, ofs, n, va));
+                }
+            }
+#endif
+            for( ; j < width; j++ )
+                op.store(D + j, medianSelect(op, S + j, ofs, n, a));
+        }
+    }
+
+private:
+    const Mat* src;
+    Mat* dst;
+    int m;
+};
+
 } // namespace anon
 
 void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
@@ -976,20 +1152,35 @@ void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
 
         return;
     }
-    else
+    else if( src0.depth() == CV_8U && (src0.channels() == 1 || src0.channels() == 3 || src0.channels() == 4) )
     {
         // TODO AVX guard (external call)
         cv::copyMakeBorder( src0, src, 0, 0, ksize/2, ksize/2, BORDER_REPLICATE|BORDER_ISOLATED);
 
-        int cn = src0.channels();
-        CV_Assert( src.depth() == CV_8U && (cn == 1 || cn == 3 || cn == 4) );
-
         double img_size_mp = (double)(src0.total())/(1 << 20);
-        if( ksize <= 3 + (img_size_mp < 1 ? 12 : img_size_mp < 4 ? 6 : 2)*
-            (CV_SIMD ? 1 : 3))
-            medianBlur_8u_Om( src, dst, ksize );
+        bool useOm = ksize <= 3 + (img_size_mp < 1 ? 12 : img_size_mp < 4 ? 6 : 2)*
+            (CV_SIMD ? 1 : 3);
+        MedianBlur8uInvoker invoker( src, dst, ksize, useOm );
+        parallel_for_( Range(0, invoker.tasks()), invoker, invoker.tasks() );
+    }
+    else
+    {
+        CV_Assert( ksize <= MEDIAN_SELECT_MAX_KSIZE );
+        // TODO AVX guard (external call)
+        cv::copyMakeBorder( src0, src, ksize/2, ksize/2, ksize/2, ksize/2, BORDER_REPLICATE|BORDER_ISOLATED);
+
+        Range range(0, dst.rows);
+        double nstripes = std::max(std::min(dst.rows/8, getNumThreads()), 1);
+        if( src.depth() == CV_8U )
+            parallel_for_( range, MedianBlurSelectInvoker<MinMax8u, MinMaxVec8u>( src, dst, ksize ), nstripes );
+        else if( src.depth() == CV_16U )
+            parallel_for_( range, MedianBlurSelectInvoker<MinMax16u, MinMaxVec16u>( src, dst, ksize ), nstripes );
+        else if( src.depth() == CV_16S )
+            parallel_for_( range, MedianBlurSelectInvoker<MinMax16s, MinMaxVec16s>( src, dst, ksize ), nstripes );
+        else if( src.depth() == CV_32F )
+            parallel_for_( range, MedianBlurSelectInvoker<MinMax32f, MinMaxVec32f>( src, dst, ksize ), nstripes );
         else
-            medianBlur_8u_O1( src, dst, ksize );
+            CV_Error(CV_StsUnsupportedFormat, "");
     }
 }
 
@@ -87,6 +87,25 @@ Ptr<BaseFilter> getMorphologyFilter(int op, int type, InputArray _kernel, Point
 }
 
 
+// The default border value is replaced by the neutral element of the operation.
+static Scalar normalizeMorphologyBorderValue(int op, int type, const Scalar& borderValue)
+{
+    if( borderValue != morphologyDefaultBorderValue() )
+        return borderValue;
+    int depth = CV_MAT_DEPTH(type);
+    CV_Assert( depth == CV_8U || depth == CV_16U || depth == CV_16S ||
+               depth == CV_32F || depth == CV_64F );
+    if( op == MORPH_ERODE )
+        return Scalar::all( depth == CV_8U ? (double)UCHAR_MAX :
+                            depth == CV_16U ? (double)USHRT_MAX :
+                            depth == CV_16S ? (double)SHRT_MAX :
+                            depth == CV_32F ? (double)FLT_MAX : DBL_MAX);
+    return Scalar::all( depth == CV_8U || depth == CV_16U ?
+                            0. :
+                        depth == CV_16S ? (double)SHRT_MIN :
+                        depth == CV_32F ? (double)-FLT_MAX : -DBL_MAX);
+}
+
 Ptr<FilterEngine> createMorphologyFilter(
         int op, int type, InputArray _kernel,
         Point anchor, int _rowBorderType, int _columnBorderType,
@@ -109,23 +128,8 @@ Ptr<FilterEngine> createMorphologyFilter(
         filter2D = getMorphologyFilter(op, type, kernel, anchor);
 
     Scalar borderValue = _borderValue;
-    if( (_rowBorderType == BORDER_CONSTANT || _columnBorderType == BORDER_CONSTANT) &&
-            borderValue == morphologyDefaultBorderValue() )
-    {
-        int depth = CV_MAT_DEPTH(type);
-        CV_Assert( depth == CV_8U || depth == CV_16U || depth == CV_16S ||
-                   depth == CV_32F || depth == CV_64F );
-        if( op == MORPH_ERODE )
-            borderValue = Scalar::all( depth == CV_8U ? (double)UCHAR_MAX :
-                                       depth == CV_16U ? (double)USHRT_MAX :
-                                       depth == CV_16S ? (double)SHRT_MAX :
-                                       depth == CV_32F ? (double)FLT_MAX : DBL_MAX);
-        else
-            borderValue = Scalar::all( depth == CV_8U || depth == CV_16U ?
-                                           0. :
-                                       depth == CV_16S ? (double)SHRT_MIN :
-                                       depth == CV_32F ? (double)-FLT_MAX : -DBL_MAX);
-    }
+    if( _rowBorderType == BORDER_CONSTANT || _columnBorderType == BORDER_CONSTANT )
+        borderValue = normalizeMorphologyBorderValue(op, type, borderValue);
 
     return makePtr<FilterEngine>(filter2D, rowFilter, columnFilter,
                                  type, type, type, _rowBorderType, _columnBorderType, borderValue );
@@ -431,6 +435,143 @@ static bool ippMorph(int op, int src_type, int dst_type,
 
 // ===== 3. Fallback implementation
 
+// Returns the whole image which [roi] with offset [ofs] is a part of.
+static Mat getWholeImage(const Mat& roi, Size wholeSize, Point ofs)
+{
+    return Mat(wholeSize, roi.type(), (void*)(roi.data - roi.step*ofs.y - roi.elemSize()*ofs.x), roi.step);
+}
+
+// Applies morphological filter engine by horizontal stripes of the image. Every
+// stripe is processed as ROI of the whole source image.
+class MorphologyRunner : public ParallelLoopBody
+{
+public:
+    MorphologyRunner(int _op, const Mat& _src, Mat& _dst, Size _wholeSize, Point _ofs,
+                     const Mat& _kernel, Point _anchor, int _borderType, const Scalar& _borderValue)
+        : op(_op), src(_src), dst(_dst), wholeSize(_wholeSize), ofs(_ofs), kernel(_kernel),
+          anchor(_anchor), borderType(_borderType), borderValue(_borderValue)
+    {}
+
+    virtual void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        Ptr<FilterEngine> f = createMorphologyFilter(op, src.type(), kernel, anchor,
+                                                     borderType, borderType, borderValue);
+        Mat dstStripe = dst.rowRange(range);
+        f->apply(src.rowRange(range), dstStripe, wholeSize, Point(ofs.x, ofs.y + range.start));
+    }
+
+private:
+    int op;
+    const Mat& src;
+    Mat& dst;
+    Size wholeSize;
+    Point ofs;
+    const Mat& kernel;
+    Point anchor;
+    int borderType;
+    Scalar borderValue;
+};
+
+// Erosion or dilation by rectangular structuring element. Unlike FilterEngine,
+// every stripe filters a block of rows by the row filter and then passes all
+// of them to the column filter at once, so van Herk/Gil-Werman column filter
+// takes constant time per pixel. Border extrapolation is done the same way.
+class MorphologyRectRunner : public ParallelLoopBody
+{
+public:
+    MorphologyRectRunner(int _op, const Mat& _src, Mat& _dst, Size _wholeSize, Point _ofs,
+                         Size _ksize, Point _anchor, int _borderType, const Scalar& _borderValue)
+        : op(_op), src(_src), dst(_dst), wholeSize(_wholeSize), ofs(_ofs), ksize(_ksize),
+          anchor(_anchor), borderType(_borderType), borderValue(_borderValue)
+    {}
+
+    virtual void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        const int type = src.type(), cn = src.channels();
+        const size_t esz = src.elemSize();
+        const Mat whole = getWholeImage(src, wholeSize, ofs);
+        Ptr<BaseRowFilter> rowFilter = getMorphologyRowFilter(op, type, ksize.width, anchor.x);
+        Ptr<BaseColumnFilter> columnFilter = getMorphologyColumnFilter(op, type, ksize.height, anchor.y);
+
+        // Source row [x0, x0 + rowWidth) of the whole image is passed to the row
+        // filter, dx1 and dx2 pixels of it are out of the image.
+        const int x0 = ofs.x - anchor.x, rowWidth = src.cols + ksize.width - 1;
+        const int dx1 = std::max(-x0, 0), dx2 = std::max(x0 + rowWidth - wholeSize.width, 0);
+        std::vector<int> borderTab(dx1 + dx2);
+        for( int i = 0; i < dx1; i++ )
+            borderTab[i] = borderInterpolate(x0 + i, wholeSize.width, borderType);
+        for( int i = 0; i < dx2; i++ )
+            borderTab[dx1 + i] = borderInterpolate(wholeSize.width + i, wholeSize.width, borderType);
+        AutoBuffer<uchar> srcRow(rowWidth*esz), constRow;
+        uchar constVal[CV_CN_MAX*sizeof(double)];
+        if( borderType == BORDER_CONSTANT )
+        {
+            scalarToRawData(borderValue, constVal, type, 0);
+            constRow.allocate(rowWidth*esz);
+            for( int i = 0; i < rowWidth; i++ )
+                memcpy(constRow.data() + i*esz, constVal, esz);
+        }
+
+        // The stripe is processed by blocks of rows to keep the buffers in cache.
+        // Column filters expect aligned rows like in the ring buffer of FilterEngine.
+        const int blockRows = std::min(range.size(), std::max(ksize.height*2, 16));
+        const int bufRows = blockRows + ksize.height - 1;
+        const size_t bufStep = alignSize(src.cols*esz, CV_MALLOC_ALIGN);
+        AutoBuffer<uchar> buf(bufStep*bufRows + CV_MALLOC_ALIGN);
+        AutoBuffer<uchar*> rows(bufRows);
+        for( int y = 0; y < bufRows; y++ )
+            rows[y] = alignPtr(buf.data(), CV_MALLOC_ALIGN) + bufStep*y;
+
+        // Number of rows at the beginning of the buffer filtered for the previous block.
+        int ready = 0;
+        for( int y0 = range.start; y0 < range.end; y0 += blockRows )
+        {
+            const int count = std::min(blockRows, range.end - y0);
+            for( int y = ready; y < count + ksize.height - 1; y++ )
+            {
+                int sy = borderInterpolate(ofs.y + y0 - anchor.y + y, wholeSize.height, borderType);
+                const uchar* row;
+                if( sy < 0 )
+                    row = constRow.data();
+                else if( dx1 == 0 && dx2 == 0 )
+                    row = whole.ptr(sy) + x0*esz;
+                else
+                {
+                    const uchar* wholeRow = whole.ptr(sy);
+                    uchar* dstRow = srcRow.data();
+                    memcpy(dstRow + dx1*esz, wholeRow + (x0 + dx1)*esz, (rowWidth - dx1 - dx2)*esz);
+                    for( int i = 0; i < dx1 + dx2; i++ )
+                    {
+                        int x = i < dx1 ? i : rowWidth - dx2 + i - dx1;
+                        memcpy(dstRow + x*esz, borderTab[i] < 0 ? constVal : wholeRow + borderTab[i]*esz, esz);
+                    }
+                    row = dstRow;
+                }
+                (*rowFilter)(row, rows[y], src.cols, cn);
+            }
+            (*columnFilter)((const uchar**)rows.data(), dst.ptr(y0), (int)dst.step, count, src.cols*cn);
+
+            std::rotate(rows.data(), rows.data() + count, rows.data() + count + ksize.height - 1);
+            ready = ksize.height - 1;
+        }
+    }
+
+private:
+    int op;
+    const Mat& src;
+    Mat& dst;
+    Size wholeSize;
+    Point ofs;
+    Size ksize;
+    Point anchor;
+    int borderType;
+    Scalar borderValue;
+};
+
 static void ocvMorph(int op, int src_type, int dst_type,
                      uchar * src_data, size_t src_step,
                      uchar * dst_data, size_t dst_step,
@@ -444,15 +585,55 @@ static void ocvMorph(int op, int src_type, int dst_type,
     Mat kernel(Size(kernel_width, kernel_height), kernel_type, kernel_data, kernel_step);
     Point anchor(anchor_x, anchor_y);
     Vec<double, 4> borderVal(borderValue);
-    Ptr<FilterEngine> f = createMorphologyFilter(op, src_type, kernel, anchor, borderType, borderType, borderVal);
     Mat src(Size(width, height), src_type, src_data, src_step);
     Mat dst(Size(width, height), dst_type, dst_data, dst_step);
+
+    // Large rectangles are processed by van Herk/Gil-Werman filters.
+    if( (kernel_width >= MORPH_VHGW_MIN_ROW_KSIZE || kernel_height >= MORPH_VHGW_MIN_COLUMN_KSIZE) &&
+        borderType != BORDER_WRAP && countNonZero(kernel) == kernel_width*kernel_height )
+    {
+        Scalar value = borderType == BORDER_CONSTANT ?
+                       normalizeMorphologyBorderValue(op, src_type, borderVal) : Scalar(borderVal);
+        for( int i = 0; i < iterations; i++ )
+        {
+            Mat s = i == 0 ? src : dst;
+            Size wsz = i == 0 ? Size(roi_width, roi_height) : Size(roi_width2, roi_height2);
+            Point ofs = i == 0 ? Point(roi_x, roi_y) : Point(roi_x2, roi_y2);
+            if( s.data < dst_data + dst_step*height && dst_data < s.data + s.step*height )
+            {
+                // In-place: the source is copied with the pixels around it which the result depends on.
+                Rect area(ofs.x - kernel_width, ofs.y - kernel_height,
+                          width + kernel_width*2, height + kernel_height*2);
+                area &= Rect(Point(), wsz);
+                Mat copy = getWholeImage(s, wsz, ofs)(area).clone();
+                s = copy(Rect(ofs.x - area.x, ofs.y - area.y, width, height));
+                wsz = area.size();
+                ofs -= area.tl();
+            }
+            int nstripes = getFilterNumStripes(s.data, s.step, dst_data, dst_step, width, height, kernel_height);
+            parallel_for_(Range(0, height),
+                          MorphologyRectRunner(op, s, dst, wsz, ofs, kernel.size(), anchor, borderType, value),
+                          std::max(nstripes, 1));
+        }
+        return;
+    }
+
+    int nstripes = getFilterNumStripes(src_data, src_step, dst_data, dst_step, width, height, kernel_height);
+    if( nstripes > 1 )
+    {
+        parallel_for_(Range(0, height),
+                      MorphologyRunner(op, src, dst, Size(roi_width, roi_height), Point(roi_x, roi_y),
+                                       kernel, anchor, borderType, borderVal),
+                      nstripes);
+    }
+    else
     {
-        Point ofs(roi_x, roi_y);
-        Size wsz(roi_width, roi_height);
-        f->apply( src, dst, wsz, ofs );
+        Ptr<FilterEngine> f = createMorphologyFilter(op, src_type, kernel, anchor, borderType, borderType, borderVal);
+        f->apply(src, dst, Size(roi_width, roi_height), Point(roi_x, roi_y));
     }
+    if( iterations > 1 )
     {
+        Ptr<FilterEngine> f = createMorphologyFilter(op, src_type, kernel, anchor, borderType, borderType, borderVal);
         Point ofs(roi_x2, roi_y2);
         Size wsz(roi_width2, roi_height2);
         for( int i = 1; i < iterations; i++ )
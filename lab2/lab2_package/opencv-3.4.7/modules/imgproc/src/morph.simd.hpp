@@ -106,6 +106,14 @@ struct MorphNoVec
     int operator()(uchar**, int, uchar*, int) const { return 0; }
 };
 
+struct MorphVHGWNoVec
+{
+    int scanForward(const uchar*, uchar*, int b, int, int, int) const { return b; }
+    int scanBackward(const uchar*, uchar*, int, int e, int) const { return e; }
+    int update(const uchar*, const uchar*, uchar*, int) const { return 0; }
+    int column(const uchar**, uchar*, int, int, int, int) const { return 0; }
+};
+
 #if CV_SIMD
 
 template<class VecUpdate> struct MorphRowVec
@@ -417,6 +425,178 @@ template <typename T> struct VMax
     vtype operator()(const vtype& a, const vtype& b) const { return v_max(a,b); }
 };
 
+// Steps of in-register inclusive scan of the vector lanes of the same channel.
+// Lanes shifted out of the vector are taken from the fill vector.
+template<class VecUpdate, int shift, bool done = (shift >= VecUpdate::vtype::nlanes)> struct MorphVecScan
+{
+    typedef typename VecUpdate::vtype vtype;
+    static inline vtype forward(const vtype& x, const vtype& fill)
+    {
+        return MorphVecScan<VecUpdate, shift*2>::forward(VecUpdate()(x, v_rotate_left<shift>(x, fill)), fill);
+    }
+    static inline vtype backward(const vtype& x, const vtype& fill)
+    {
+        return MorphVecScan<VecUpdate, shift*2>::backward(VecUpdate()(x, v_rotate_right<shift>(x, fill)), fill);
+    }
+};
+
+template<class VecUpdate, int shift> struct MorphVecScan<VecUpdate, shift, true>
+{
+    typedef typename VecUpdate::vtype vtype;
+    static inline vtype forward(const vtype& x, const vtype&) { return x; }
+    static inline vtype backward(const vtype& x, const vtype&) { return x; }
+};
+
+static inline void morphCastVec(const v_uint8& a, v_uint8& b) { b = a; }
+static inline void morphCastVec(const v_uint8& a, v_uint16& b) { b = v_reinterpret_as_u16(a); }
+static inline void morphCastVec(const v_uint8& a, v_int16& b) { b = v_reinterpret_as_s16(a); }
+static inline void morphCastVec(const v_uint8& a, v_float32& b) { b = v_reinterpret_as_f32(a); }
+
+// Vectorized parts of van Herk/Gil-Werman filters.
+template<class VecUpdate> struct MorphVHGWVec
+{
+    typedef typename VecUpdate::vtype vtype;
+    typedef typename vtype::lane_type stype;
+
+    // Fills vector with the pixel of cn channels.
+    static inline vtype replicate(const stype* ptr, int cn)
+    {
+        uint64 val = 0;
+        memcpy(&val, ptr, cn*sizeof(ptr[0]));
+        v_uint8 v;
+        switch( cn*sizeof(ptr[0]) )
+        {
+        case 1: v = vx_setall_u8((uchar)val); break;
+        case 2: v = v_reinterpret_as_u8(vx_setall_u16((ushort)val)); break;
+        case 4: v = v_reinterpret_as_u8(vx_setall_u32((unsigned)val)); break;
+        default: v = v_reinterpret_as_u8(vx_setall_u64(val)); break;
+        }
+        vtype r;
+        morphCastVec(v, r);
+        return r;
+    }
+
+    // Only pixels of 1, 2, 4 or 8 bytes are vectorized, and vector should hold 2 pixels at least.
+    static inline bool supported(int cn)
+    {
+        const int sz = cn*(int)sizeof(stype);
+        return (sz == 1 || sz == 2 || sz == 4 || sz == 8) && cn*2 <= vtype::nlanes;
+    }
+
+    template<int cn> static int scanForward_(const stype* src, stype* g, int b, int e, int n)
+    {
+        VecUpdate updateOp;
+        vtype carry = replicate(src + b, cn);
+        int i = b;
+        for( ; i < e && i <= n - vtype::nlanes; i += vtype::nlanes )
+        {
+            vtype x = updateOp(MorphVecScan<VecUpdate, cn>::forward(vx_load(src + i), carry), carry);
+            v_store(g + i, x);
+            carry = replicate(g + i + vtype::nlanes - cn, cn);
+        }
+        return std::min(i, e);
+    }
+
+    template<int cn> static int scanBackward_(const stype* src, stype* h, int b, int e)
+    {
+        VecUpdate updateOp;
+        vtype carry = replicate(src + e - cn, cn);
+        int i = e;
+        for( ; i > b && i >= vtype::nlanes; i -= vtype::nlanes )
+        {
+            vtype x = updateOp(MorphVecScan<VecUpdate, cn>::backward(vx_load(src + i - vtype::nlanes), carry), carry);
+            v_store(h + i - vtype::nlanes, x);
+            carry = replicate(h + i - vtype::nlanes, cn);
+        }
+        return std::max(i, b);
+    }
+
+    // Computes running extremums from the block [b, e) start to g. Vectors
+    // can go out of the block, those values are rewritten by the next block
+    // scan. Returns index of the first value to be computed by the caller.
+    int scanForward(const uchar* src, uchar* g, int b, int e, int n, int cn) const
+    {
+        const stype* S = (const stype*)src;
+        stype* G = (stype*)g;
+        switch( supported(cn) ? cn : 0 )
+        {
+        case 1: return scanForward_<1>(S, G, b, e, n);
+        case 2: return scanForward_<2>(S, G, b, e, n);
+        case 4: return scanForward_<4>(S, G, b, e, n);
+        default: return b;
+        }
+    }
+
+    // Computes running extremums from the block [b, e) end to h. The blocks
+    // have to be processed from the last one. Returns end of the values to
+    // be computed by the caller.
+    int scanBackward(const uchar* src, uchar* h, int b, int e, int cn) const
+    {
+        const stype* S = (const stype*)src;
+        stype* H = (stype*)h;
+        switch( supported(cn) ? cn : 0 )
+        {
+        case 1: return scanBackward_<1>(S, H, b, e);
+        case 2: return scanBackward_<2>(S, H, b, e);
+        case 4: return scanBackward_<4>(S, H, b, e);
+        default: return e;
+        }
+    }
+
+    int update(const uchar* _a, const uchar* _b, uchar* _dst, int width) const
+    {
+        const stype* a = (const stype*)_a;
+        const stype* b = (const stype*)_b;
+        stype* dst = (stype*)_dst;
+        VecUpdate updateOp;
+        int i = 0;
+        for( ; i <= width - 2*vtype::nlanes; i += 2*vtype::nlanes )
+        {
+            v_store(dst + i, updateOp(vx_load(a + i), vx_load(b + i)));
+            v_store(dst + i + vtype::nlanes, updateOp(vx_load(a + i + vtype::nlanes), vx_load(b + i + vtype::nlanes)));
+        }
+        if( i <= width - vtype::nlanes )
+        {
+            v_store(dst + i, updateOp(vx_load(a + i), vx_load(b + i)));
+            i += vtype::nlanes;
+        }
+        return i;
+    }
+
+    // Processes a block of n output rows of the column filter.
+    int column(const uchar** _src, uchar* _dst, int dststep, int ksize, int n, int width) const
+    {
+        const stype** src = (const stype**)_src;
+        stype* dst = (stype*)_dst;
+        dststep /= sizeof(dst[0]);
+        VecUpdate updateOp;
+        int i = 0;
+        for( ; i <= width - vtype::nlanes; i += vtype::nlanes )
+        {
+            vtype h = vx_load(src[ksize - 1] + i);
+            if( ksize - 1 < n )
+                v_store(dst + dststep*(ksize - 1) + i, h);
+            for( int j = ksize - 2; j >= 0; j-- )
+            {
+                h = updateOp(h, vx_load(src[j] + i));
+                if( j < n )
+                    v_store(dst + dststep*j + i, h);
+            }
+            if( n > 1 )
+            {
+                vtype g = vx_load(src[ksize] + i);
+                v_store(dst + dststep + i, updateOp(vx_load(dst + dststep + i), g));
+                for( int j = 2; j < n; j++ )
+                {
+                    g = updateOp(g, vx_load(src[ksize + j - 1] + i));
+                    v_store(dst + dststep*j + i, updateOp(vx_load(dst + dststep*j + i), g));
+                }
+            }
+        }
+        return i;
+    }
+};
+
 typedef MorphRowVec<VMin<v_uint8> > ErodeRowVec8u;
 typedef MorphRowVec<VMax<v_uint8> > DilateRowVec8u;
 typedef MorphRowVec<VMin<v_uint16> > ErodeRowVec16u;
@@ -444,6 +624,15 @@ typedef MorphVec<VMax<v_int16> > DilateVec16s;
 typedef MorphVec<VMin<v_float32> > ErodeVec32f;
 typedef MorphVec<VMax<v_float32> > DilateVec32f;
 
+typedef MorphVHGWVec<VMin<v_uint8> > ErodeVHGWVec8u;
+typedef MorphVHGWVec<VMax<v_uint8> > DilateVHGWVec8u;
+typedef MorphVHGWVec<VMin<v_uint16> > ErodeVHGWVec16u;
+typedef MorphVHGWVec<VMax<v_uint16> > DilateVHGWVec16u;
+typedef MorphVHGWVec<VMin<v_int16> > ErodeVHGWVec16s;
+typedef MorphVHGWVec<VMax<v_int16> > DilateVHGWVec16s;
+typedef MorphVHGWVec<VMin<v_float32> > ErodeVHGWVec32f;
+typedef MorphVHGWVec<VMax<v_float32> > DilateVHGWVec32f;
+
 #else
 
 typedef MorphRowNoVec ErodeRowVec8u;
@@ -475,6 +664,15 @@ typedef MorphNoVec DilateVec16s;
 typedef MorphNoVec ErodeVec32f;
 typedef MorphNoVec DilateVec32f;
 
+typedef MorphVHGWNoVec ErodeVHGWVec8u;
+typedef MorphVHGWNoVec DilateVHGWVec8u;
+typedef MorphVHGWNoVec ErodeVHGWVec16u;
+typedef MorphVHGWNoVec DilateVHGWVec16u;
+typedef MorphVHGWNoVec ErodeVHGWVec16s;
+typedef MorphVHGWNoVec DilateVHGWVec16s;
+typedef MorphVHGWNoVec ErodeVHGWVec32f;
+typedef MorphVHGWNoVec DilateVHGWVec32f;
+
 #endif
 
 typedef MorphRowNoVec ErodeRowVec64f;
@@ -483,6 +681,8 @@ typedef MorphColumnNoVec ErodeColumnVec64f;
 typedef MorphColumnNoVec DilateColumnVec64f;
 typedef MorphNoVec ErodeVec64f;
 typedef MorphNoVec DilateVec64f;
+typedef MorphVHGWNoVec ErodeVHGWVec64f;
+typedef MorphVHGWNoVec DilateVHGWVec64f;
 
 
 template<class Op, class VecOp> struct MorphRowFilter : public BaseRowFilter
@@ -638,6 +838,112 @@ template<class Op, class VecOp> struct MorphColumnFilter : public BaseColumnFilt
 };
 
 
+// Van Herk/Gil-Werman algorithm: the row is split into blocks of ksize pixels,
+// and running extremums are computed from the starts (g) and to the ends (h) of
+// the blocks. Every window of ksize pixels covers end of one block and start of
+// the next one, so the result is op(h[x], g[x + ksize - 1]). It takes 3
+// comparisons per pixel regardless of the kernel size.
+template<class Op, class VecOp> struct MorphRowVHGWFilter : public BaseRowFilter
+{
+    typedef typename Op::rtype T;
+
+    MorphRowVHGWFilter( int _ksize, int _anchor )
+    {
+        ksize = _ksize;
+        anchor = _anchor;
+    }
+
+    void operator()(const uchar* src, uchar* dst, int width, int cn) CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        const T* S = (const T*)src;
+        T* D = (T*)dst;
+        Op op;
+        const int n = (width + ksize - 1)*cn, blockSize = ksize*cn;
+        buf.resize(n*2);
+        T* g = &buf[0];
+        T* h = g + n;
+
+        for( int b = 0; b < n; b += blockSize )
+        {
+            const int e = std::min(b + blockSize, n);
+            int i = vecOp.scanForward(src, (uchar*)g, b, e, n, cn);
+            for( ; i < e; i++ )
+                g[i] = i < b + cn ? S[i] : op(g[i - cn], S[i]);
+        }
+        for( int b = (n - 1)/blockSize*blockSize; b >= 0; b -= blockSize )
+        {
+            const int e = std::min(b + blockSize, n);
+            int i = vecOp.scanBackward(src, (uchar*)h, b, e, cn);
+            for( ; i > b; i-- )
+                h[i - 1] = i > e - cn ? S[i - 1] : op(h[i - 1 + cn], S[i - 1]);
+        }
+
+        const T* G = g + (ksize - 1)*cn;
+        int i = vecOp.update((const uchar*)h, (const uchar*)G, dst, width*cn);
+        for( ; i < width*cn; i++ )
+            D[i] = op(h[i], G[i]);
+    }
+
+    std::vector<T> buf;
+    VecOp vecOp;
+};
+
+
+// Van Herk/Gil-Werman algorithm by columns. Output rows are processed by blocks
+// of ksize: extremums of the block rows to the end of the block are written to
+// the outputs first, then they are updated by running extremums of the next
+// block rows. Every output takes 3 comparisons if count is large enough.
+template<class Op, class VecOp> struct MorphColumnVHGWFilter : public BaseColumnFilter
+{
+    typedef typename Op::rtype T;
+
+    MorphColumnVHGWFilter( int _ksize, int _anchor )
+    {
+        ksize = _ksize;
+        anchor = _anchor;
+    }
+
+    void operator()(const uchar** _src, uchar* dst, int dststep, int count, int width) CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        const T** src = (const T**)_src;
+        const int step = dststep/(int)sizeof(T);
+        Op op;
+
+        for( ; count > 0; count -= ksize, _src += ksize, src += ksize, dst += dststep*ksize )
+        {
+            const int n = std::min(ksize, count);
+            int i = vecOp.column(_src, dst, dststep, ksize, n, width);
+            for( ; i < width; i++ )
+            {
+                T* d = (T*)dst + i;
+                T h = src[ksize - 1][i];
+                if( ksize - 1 < n )
+                    d[step*(ksize - 1)] = h;
+                for( int j = ksize - 2; j >= 0; j-- )
+                {
+                    h = op(h, src[j][i]);
+                    if( j < n )
+                        d[step*j] = h;
+                }
+                T g = n > 1 ? src[ksize][i] : h;
+                for( int j = 1; j < n; j++ )
+                {
+                    if( j > 1 )
+                        g = op(g, src[ksize + j - 1][i]);
+                    d[step*j] = op(d[step*j], g);
+                }
+            }
+        }
+    }
+
+    VecOp vecOp;
+};
+
+
 template<class Op, class VecOp> struct MorphFilter : BaseFilter
 {
     typedef typename Op::rtype T;
@@ -716,6 +1022,35 @@ Ptr<BaseRowFilter> getMorphologyRowFilter(int op, int type, int ksize, int ancho
     if( anchor < 0 )
         anchor = ksize/2;
     CV_Assert( op == MORPH_ERODE || op == MORPH_DILATE );
+    if( ksize >= MORPH_VHGW_MIN_ROW_KSIZE )
+    {
+        if( op == MORPH_ERODE )
+        {
+            if( depth == CV_8U )
+                return makePtr<MorphRowVHGWFilter<MinOp<uchar>, ErodeVHGWVec8u> >(ksize, anchor);
+            if( depth == CV_16U )
+                return makePtr<MorphRowVHGWFilter<MinOp<ushort>, ErodeVHGWVec16u> >(ksize, anchor);
+            if( depth == CV_16S )
+                return makePtr<MorphRowVHGWFilter<MinOp<short>, ErodeVHGWVec16s> >(ksize, anchor);
+            if( depth == CV_32F )
+                return makePtr<MorphRowVHGWFilter<MinOp<float>, ErodeVHGWVec32f> >(ksize, anchor);
+            if( depth == CV_64F )
+                return makePtr<MorphRowVHGWFilter<MinOp<double>, ErodeVHGWVec64f> >(ksize, anchor);
+        }
+        if( op == MORPH_DILATE )
+        {
+            if( depth == CV_8U )
+                return makePtr<MorphRowVHGWFilter<MaxOp<uchar>, DilateVHGWVec8u> >(ksize, anchor);
+            if( depth == CV_16U )
+                return makePtr<MorphRowVHGWFilter<MaxOp<ushort>, DilateVHGWVec16u> >(ksize, anchor);
+            if( depth == CV_16S )
+                return makePtr<MorphRowVHGWFilter<MaxOp<short>, DilateVHGWVec16s> >(ksize, anchor);
+            if( depth == CV_32F )
+                return makePtr<MorphRowVHGWFilter<MaxOp<float>, DilateVHGWVec32f> >(ksize, anchor);
+            if( depth == CV_64F )
+                return makePtr<MorphRowVHGWFilter<MaxOp<double>, DilateVHGWVec64f> >(ksize, anchor);
+        }
+    }
     if( op == MORPH_ERODE )
     {
         if( depth == CV_8U )
@@ -764,6 +1099,35 @@ Ptr<BaseColumnFilter> getMorphologyColumnFilter(int op, int type, int ksize, int
     if( anchor < 0 )
         anchor = ksize/2;
     CV_Assert( op == MORPH_ERODE || op == MORPH_DILATE );
+    if( ksize >= MORPH_VHGW_MIN_COLUMN_KSIZE )
+    {
+        if( op == MORPH_ERODE )
+        {
+            if( depth == CV_8U )
+                return makePtr<MorphColumnVHGWFilter<MinOp<uchar>, ErodeVHGWVec8u> >(ksize, anchor);
+            if( depth == CV_16U )
+                return makePtr<MorphColumnVHGWFilter<MinOp<ushort>, ErodeVHGWVec16u> >(ksize, anchor);
+            if( depth == CV_16S )
+                return makePtr<MorphColumnVHGWFilter<MinOp<short>, ErodeVHGWVec16s> >(ksize, anchor);
+            if( depth == CV_32F )
+                return makePtr<MorphColumnVHGWFilter<MinOp<float>, ErodeVHGWVec32f> >(ksize, anchor);
+            if( depth == CV_64F )
+                return makePtr<MorphColumnVHGWFilter<MinOp<double>, ErodeVHGWVec64f> >(ksize, anchor);
+        }
+        if( op == MORPH_DILATE )
+        {
+            if( depth == CV_8U )
+                return makePtr<MorphColumnVHGWFilter<MaxOp<uchar>, DilateVHGWVec8u> >(ksize, anchor);
+            if( depth == CV_16U )
+                return makePtr<MorphColumnVHGWFilter<MaxOp<ushort>, DilateVHGWVec16u> >(ksize, anchor);
+            if( depth == CV_16S )
+                return makePtr<MorphColumnVHGWFilter<MaxOp<short>, DilateVHGWVec16s> >(ksize, anchor);
+            if( depth == CV_32F )
+                return makePtr<MorphColumnVHGWFilter<MaxOp<float>, DilateVHGWVec32f> >(ksize, anchor);
+            if( depth == CV_64F )
+                return makePtr<MorphColumnVHGWFilter<MaxOp<double>, DilateVHGWVec64f> >(ksize, anchor);
+        }
+    }
     if( op == MORPH_ERODE )
     {
         if( depth == CV_8U )
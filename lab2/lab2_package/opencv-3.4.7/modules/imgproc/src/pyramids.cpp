@@ -719,236 +719,419 @@ template <> int PyrUpVecV<float, float>(float** src, float** dst, int width)
 
 #endif
 
-template<class CastOp> void
-pyrDown_( const Mat& _src, Mat& _dst, int borderType )
+// Computes rows of pyrDown. The ring buffer of horizontally filtered source rows
+// is kept between the calls, so the rows can be produced by portions.
+template<class CastOp> class PyrDownRows
 {
-    const int PD_SZ = 5;
+public:
     typedef typename CastOp::type1 WT;
     typedef typename CastOp::rtype T;
+    enum { PD_SZ = 5 };
 
-    CV_Assert( !_src.empty() );
-    Size ssize = _src.size(), dsize = _dst.size();
-    int cn = _src.channels();
-    int bufstep = (int)alignSize(dsize.width*cn, 16);
-    AutoBuffer<WT> _buf(bufstep*PD_SZ + 16);
-    WT* buf = alignPtr((WT*)_buf.data(), 16);
-    int tabL[CV_CN_MAX*(PD_SZ+2)], tabR[CV_CN_MAX*(PD_SZ+2)];
-    AutoBuffer<int> _tabM(dsize.width*cn);
-    int* tabM = _tabM.data();
-    WT* rows[PD_SZ];
-    CastOp castOp;
-
-    CV_Assert( ssize.width > 0 && ssize.height > 0 &&
-               std::abs(dsize.width*2 - ssize.width) <= 2 &&
-               std::abs(dsize.height*2 - ssize.height) <= 2 );
-    int k, x, sy0 = -PD_SZ/2, sy = sy0, width0 = std::min((ssize.width-PD_SZ/2-1)/2 + 1, dsize.width);
-
-    for( x = 0; x <= PD_SZ+1; x++ )
+    PyrDownRows( const Mat& src, Mat& dst, int _borderType ) :
+        _src(&src), _dst(&dst), borderType(_borderType), nextRow(-1)
     {
-        int sx0 = borderInterpolate(x - PD_SZ/2, ssize.width, borderType)*cn;
-        int sx1 = borderInterpolate(x + width0*2 - PD_SZ/2, ssize.width, borderType)*cn;
-        for( k = 0; k < cn; k++ )
+        ssize = src.size();
+        dsize = dst.size();
+        cn = src.channels();
+        bufstep = (int)alignSize(dsize.width*cn, 16);
+        _buf.allocate(bufstep*PD_SZ + 16);
+        buf = alignPtr((WT*)_buf.data(), 16);
+        _tabM.allocate(dsize.width*cn);
+        tabM = _tabM.data();
+        sy = -PD_SZ/2;
+        width0 = std::min((ssize.width-PD_SZ/2-1)/2 + 1, dsize.width);
+
+        int k, x;
+        for( x = 0; x <= PD_SZ+1; x++ )
         {
-            tabL[x*cn + k] = sx0 + k;
-            tabR[x*cn + k] = sx1 + k;
+            int sx0 = borderInterpolate(x - PD_SZ/2, ssize.width, borderType)*cn;
+            int sx1 = borderInterpolate(x + width0*2 - PD_SZ/2, ssize.width, borderType)*cn;
+            for( k = 0; k < cn; k++ )
+            {
+                tabL[x*cn + k] = sx0 + k;
+                tabR[x*cn + k] = sx1 + k;
+            }
         }
-    }
 
-    ssize.width *= cn;
-    dsize.width *= cn;
-    width0 *= cn;
+        ssize.width *= cn;
+        dsize.width *= cn;
+        width0 *= cn;
 
-    for( x = 0; x < dsize.width; x++ )
-        tabM[x] = (x/cn)*2*cn + x % cn;
+        for( x = 0; x < dsize.width; x++ )
+            tabM[x] = (x/cn)*2*cn + x % cn;
+    }
 
-    for( int y = 0; y < dsize.height; y++ )
+    // computes the destination rows [y0, y1)
+    void operator()( int y0, int y1 )
     {
-        T* dst = _dst.ptr<T>(y);
-        WT *row0, *row1, *row2, *row3, *row4;
+        const int sy0 = -PD_SZ/2;
+        WT* rows[PD_SZ];
+        CastOp castOp;
+        int k, x;
+
+        if( y0 != nextRow )
+            sy = y0*2 - PD_SZ/2;
+        nextRow = y1;
 
-        // fill the ring buffer (horizontal convolution and decimation)
-        for( ; sy <= y*2 + 2; sy++ )
+        for( int y = y0; y < y1; y++ )
         {
-            WT* row = buf + ((sy - sy0) % PD_SZ)*bufstep;
-            int _sy = borderInterpolate(sy, ssize.height, borderType);
-            const T* src = _src.ptr<T>(_sy);
-            int limit = cn;
-            const int* tab = tabL;
+            T* dst = _dst->ptr<T>(y);
+            WT *row0, *row1, *row2, *row3, *row4;
 
-            for( x = 0;;)
+            for( ; sy <= y*2 + 2; sy++ )
             {
-                for( ; x < limit; x++ )
+                WT* row = buf + ((sy - sy0) % PD_SZ)*bufstep;
+                int _sy = borderInterpolate(sy, ssize.height, borderType);
+                const T* src = _src->ptr<T>(_sy);
+                int limit = cn;
+                const int* tab = tabL;
+
+                for( x = 0;;)
                 {
-                    row[x] = src[tab[x+cn*2]]*6 + (src[tab[x+cn]] + src[tab[x+cn*3]])*4 +
-                        src[tab[x]] + src[tab[x+cn*4]];
-                }
+                    for( ; x < limit; x++ )
+                    {
+                        row[x] = src[tab[x+cn*2]]*6 + (src[tab[x+cn]] + src[tab[x+cn*3]])*4 +
+                            src[tab[x]] + src[tab[x+cn*4]];
+                    }
 
-                if( x == dsize.width )
-                    break;
+                    if( x == dsize.width )
+                        break;
 
-                if( cn == 1 )
-                {
-                    x += PyrDownVecH<T, WT, 1>(src + x * 2 - 2, row + x, width0 - x);
-                    for( ; x < width0; x++ )
-                        row[x] = src[x*2]*6 + (src[x*2 - 1] + src[x*2 + 1])*4 +
-                            src[x*2 - 2] + src[x*2 + 2];
-                }
-                else if( cn == 2 )
-                {
-                    x += PyrDownVecH<T, WT, 2>(src + x * 2 - 4, row + x, width0 - x);
-                    for( ; x < width0; x += 2 )
+                    if( cn == 1 )
                     {
-                        const T* s = src + x*2;
-                        WT t0 = s[0] * 6 + (s[-2] + s[2]) * 4 + s[-4] + s[4];
-                        WT t1 = s[1] * 6 + (s[-1] + s[3]) * 4 + s[-3] + s[5];
-                        row[x] = t0; row[x + 1] = t1;
+                        x += PyrDownVecH<T, WT, 1>(src + x * 2 - 2, row + x, width0 - x);
+                        for( ; x < width0; x++ )
+                            row[x] = src[x*2]*6 + (src[x*2 - 1] + src[x*2 + 1])*4 +
+                                src[x*2 - 2] + src[x*2 + 2];
                     }
-                }
-                else if( cn == 3 )
-                {
-                    x += PyrDownVecH<T, WT, 3>(src + x * 2 - 6, row + x, width0 - x);
-                    for( ; x < width0; x += 3 )
+                    else if( cn == 2 )
                     {
-                        const T* s = src + x*2;
-                        WT t0 = s[0]*6 + (s[-3] + s[3])*4 + s[-6] + s[6];
-                        WT t1 = s[1]*6 + (s[-2] + s[4])*4 + s[-5] + s[7];
-                        WT t2 = s[2]*6 + (s[-1] + s[5])*4 + s[-4] + s[8];
-                        row[x] = t0; row[x+1] = t1; row[x+2] = t2;
+                        x += PyrDownVecH<T, WT, 2>(src + x * 2 - 4, row + x, width0 - x);
+                        for( ; x < width0; x += 2 )
+                        {
+                            const T* s = src + x*2;
+                            WT t0 = s[0] * 6 + (s[-2] + s[2]) * 4 + s[-4] + s[4];
+                            WT t1 = s[1] * 6 + (s[-1] + s[3]) * 4 + s[-3] + s[5];
+                            row[x] = t0; row[x + 1] = t1;
+                        }
                     }
-                }
-                else if( cn == 4 )
-                {
-                    x += PyrDownVecH<T, WT, 4>(src + x * 2 - 8, row + x, width0 - x);
-                    for( ; x < width0; x += 4 )
+                    else if( cn == 3 )
                     {
-                        const T* s = src + x*2;
-                        WT t0 = s[0]*6 + (s[-4] + s[4])*4 + s[-8] + s[8];
-                        WT t1 = s[1]*6 + (s[-3] + s[5])*4 + s[-7] + s[9];
-                        row[x] = t0; row[x+1] = t1;
-                        t0 = s[2]*6 + (s[-2] + s[6])*4 + s[-6] + s[10];
-                        t1 = s[3]*6 + (s[-1] + s[7])*4 + s[-5] + s[11];
-                        row[x+2] = t0; row[x+3] = t1;
+                        x += PyrDownVecH<T, WT, 3>(src + x * 2 - 6, row + x, width0 - x);
+                        for( ; x < width0; x += 3 )
+                        {
+                            const T* s = src + x*2;
+                            WT t0 = s[0]*6 + (s[-3] + s[3])*4 + s[-6] + s[6];
+                            WT t1 = s[1]*6 + (s[-2] + s[4])*4 + s[-5] + s[7];
+                            WT t2 = s[2]*6 + (s[-1] + s[5])*4 + s[-4] + s[8];
+                            row[x] = t0; row[x+1] = t1; row[x+2] = t2;
+                        }
                     }
-                }
-                else
-                {
-                    for( ; x < width0; x++ )
+                    else if( cn == 4 )
+                    {
+                        x += PyrDownVecH<T, WT, 4>(src + x * 2 - 8, row + x, width0 - x);
+                        for( ; x < width0; x += 4 )
+                        {
+                            const T* s = src + x*2;
+                            WT t0 = s[0]*6 + (s[-4] + s[4])*4 + s[-8] + s[8];
+                            WT t1 = s[1]*6 + (s[-3] + s[5])*4 + s[-7] + s[9];
+                            row[x] = t0; row[x+1] = t1;
+                            t0 = s[2]*6 + (s[-2] + s[6])*4 + s[-6] + s[10];
+                            t1 = s[3]*6 + (s[-1] + s[7])*4 + s[-5] + s[11];
+                            row[x+2] = t0; row[x+3] = t1;
+                        }
+                    }
+                    else
                     {
-                        int sx = tabM[x];
-                        row[x] = src[sx]*6 + (src[sx - cn] + src[sx + cn])*4 +
-                            src[sx - cn*2] + src[sx + cn*2];
+                        for( ; x < width0; x++ )
+                        {
+                            int sx = tabM[x];
+                            row[x] = src[sx]*6 + (src[sx - cn] + src[sx + cn])*4 +
+                                src[sx - cn*2] + src[sx + cn*2];
+                        }
                     }
-                }
 
-                limit = dsize.width;
-                tab = tabR - x;
+                    limit = dsize.width;
+                    tab = tabR - x;
+                }
             }
-        }
 
-        // do vertical convolution and decimation and write the result to the destination image
-        for( k = 0; k < PD_SZ; k++ )
-            rows[k] = buf + ((y*2 - PD_SZ/2 + k - sy0) % PD_SZ)*bufstep;
-        row0 = rows[0]; row1 = rows[1]; row2 = rows[2]; row3 = rows[3]; row4 = rows[4];
+            // do vertical convolution and decimation and write the result to the destination image
+            for( k = 0; k < PD_SZ; k++ )
+                rows[k] = buf + ((y*2 - PD_SZ/2 + k - sy0) % PD_SZ)*bufstep;
+            row0 = rows[0]; row1 = rows[1]; row2 = rows[2]; row3 = rows[3]; row4 = rows[4];
 
-        x = PyrDownVecV<WT, T>(rows, dst, dsize.width);
-        for( ; x < dsize.width; x++ )
-            dst[x] = castOp(row2[x]*6 + (row1[x] + row3[x])*4 + row0[x] + row4[x]);
+            x = PyrDownVecV<WT, T>(rows, dst, dsize.width);
+            for( ; x < dsize.width; x++ )
+                dst[x] = castOp(row2[x]*6 + (row1[x] + row3[x])*4 + row0[x] + row4[x]);
+        }
     }
+
+private:
+    const Mat* _src;
+    Mat* _dst;
+    int borderType, nextRow, sy;
+    Size ssize, dsize;
+    int cn, bufstep, width0;
+    AutoBuffer<WT> _buf;
+    WT* buf;
+    int tabL[CV_CN_MAX*(PD_SZ+2)], tabR[CV_CN_MAX*(PD_SZ+2)];
+    AutoBuffer<int> _tabM;
+    int* tabM;
+};
+
+// Number of stripes to split the rows of the smaller image for pyramid functions
+// to. The stripes should be large enough to amortize the ring buffer initialization.
+static int getPyrNumStripes( Size largeSize, int rows )
+{
+    int nstripes = std::min(rows/16, (int)(((int64)largeSize.width*largeSize.height) >> 16));
+    return std::max(std::min(nstripes, getNumThreads()), 1);
 }
 
+template<class CastOp> class PyrDownInvoker : public ParallelLoopBody
+{
+public:
+    PyrDownInvoker( const Mat& src, Mat& dst, int _borderType ) :
+        _src(&src), _dst(&dst), borderType(_borderType) {}
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        PyrDownRows<CastOp> rows(*_src, *_dst, borderType);
+        rows(range.start, range.end);
+    }
+
+private:
+    const Mat* _src;
+    Mat* _dst;
+    int borderType;
+};
 
 template<class CastOp> void
-pyrUp_( const Mat& _src, Mat& _dst, int)
+pyrDown_( const Mat& _src, Mat& _dst, int borderType )
 {
-    const int PU_SZ = 3;
-    typedef typename CastOp::type1 WT;
-    typedef typename CastOp::rtype T;
-
     Size ssize = _src.size(), dsize = _dst.size();
-    int cn = _src.channels();
-    int bufstep = (int)alignSize((dsize.width+1)*cn, 16);
-    AutoBuffer<WT> _buf(bufstep*PU_SZ + 16);
-    WT* buf = alignPtr((WT*)_buf.data(), 16);
-    AutoBuffer<int> _dtab(ssize.width*cn);
-    int* dtab = _dtab.data();
-    WT* rows[PU_SZ];
-    T* dsts[2];
-    CastOp castOp;
-    //PyrUpVecH<T, WT> vecOpH;
+    CV_Assert( !_src.empty() );
+    CV_Assert( ssize.width > 0 && ssize.height > 0 &&
+               std::abs(dsize.width*2 - ssize.width) <= 2 &&
+               std::abs(dsize.height*2 - ssize.height) <= 2 );
 
-    CV_Assert( std::abs(dsize.width - ssize.width*2) == dsize.width % 2 &&
-               std::abs(dsize.height - ssize.height*2) == dsize.height % 2);
-    int k, x, sy0 = -PU_SZ/2, sy = sy0;
+    parallel_for_(Range(0, dsize.height), PyrDownInvoker<CastOp>(_src, _dst, borderType),
+                  getPyrNumStripes(ssize, dsize.height));
+}
 
-    ssize.width *= cn;
-    dsize.width *= cn;
+// Builds the pyramid by horizontal stripes. Every stripe produces the rows of
+// the next level as soon as the rows they depend on are ready, so the rows of
+// the current level are still in cache. The rows of the levels below the first
+// one that depend on several stripes are computed after that.
+template<class CastOp> class PyramidInvoker : public ParallelLoopBody
+{
+public:
+    enum { CHUNK_ROWS = 8 };
 
-    for( x = 0; x < ssize.width; x++ )
-        dtab[x] = (x/cn)*2*cn + x % cn;
+    PyramidInvoker( std::vector<Mat>& pyr, int _borderType, const std::vector<std::vector<Range> >& _rows ) :
+        _pyr(&pyr), borderType(_borderType), rows(&_rows) {}
 
-    for( int y = 0; y < ssize.height; y++ )
+    void operator()( const Range& range ) const CV_OVERRIDE
     {
-        T* dst0 = _dst.ptr<T>(y*2);
-        T* dst1 = _dst.ptr<T>(std::min(y*2+1, dsize.height-1));
-        WT *row0, *row1, *row2;
+        std::vector<Mat>& pyr = *_pyr;
+        const std::vector<std::vector<Range> >& r = *rows;
+        const int maxlevel = (int)pyr.size() - 1;
+        std::vector<Ptr<PyrDownRows<CastOp> > > filters(maxlevel + 1);
+        std::vector<int> next(maxlevel + 1);
 
-        // fill the ring buffer (horizontal convolution and decimation)
-        for( ; sy <= y + 1; sy++ )
+        for( int i = range.start; i < range.end; i++ )
         {
-            WT* row = buf + ((sy - sy0) % PU_SZ)*bufstep;
-            int _sy = borderInterpolate(sy*2, ssize.height*2, BORDER_REFLECT_101)/2;
-            const T* src = _src.ptr<T>(_sy);
-
-            if( ssize.width == cn )
+            for( int k = 1; k <= maxlevel; k++ )
             {
-                for( x = 0; x < cn; x++ )
-                    row[x] = row[x + cn] = src[x]*8;
-                continue;
+                filters[k].reset(new PyrDownRows<CastOp>(pyr[k-1], pyr[k], borderType));
+                next[k] = r[k][i].start;
             }
 
-            for( x = 0; x < cn; x++ )
+            while( next[1] < r[1][i].end )
             {
-                int dx = dtab[x];
-                WT t0 = src[x]*6 + src[x + cn]*2;
-                WT t1 = (src[x] + src[x + cn])*4;
-                row[dx] = t0; row[dx + cn] = t1;
-                dx = dtab[ssize.width - cn + x];
-                int sx = ssize.width - cn + x;
-                t0 = src[sx - cn] + src[sx]*7;
-                t1 = src[sx]*8;
-                row[dx] = t0; row[dx + cn] = t1;
-
-                if (dsize.width > ssize.width*2)
+                int end = std::min(next[1] + (int)CHUNK_ROWS, r[1][i].end);
+                (*filters[1])(next[1], end);
+                next[1] = end;
+
+                for( int k = 2; k <= maxlevel; k++ )
                 {
-                    row[(_dst.cols-1) + x] = row[dx + cn];
+                    // row y depends on the rows [y*2 - 2, y*2 + 2] of the previous level
+                    end = next[k-1] == r[k-1][i].end ? r[k][i].end : std::min((next[k-1] - 1)/2, r[k][i].end);
+                    if( end <= next[k] )
+                        break;
+                    (*filters[k])(next[k], end);
+                    next[k] = end;
                 }
             }
+        }
+    }
 
-            for( x = cn; x < ssize.width - cn; x++ )
-            {
-                int dx = dtab[x];
-                WT t0 = src[x-cn] + src[x]*6 + src[x+cn];
-                WT t1 = (src[x] + src[x+cn])*4;
-                row[dx] = t0;
-                row[dx+cn] = t1;
-            }
+private:
+    std::vector<Mat>* _pyr;
+    int borderType;
+    const std::vector<std::vector<Range> >* rows;
+};
+
+template<class CastOp> void
+buildPyramid_( std::vector<Mat>& pyr, int borderType )
+{
+    const int maxlevel = (int)pyr.size() - 1;
+    CV_Assert( maxlevel >= 1 && !pyr[0].empty() );
+
+    const int nstripes = getPyrNumStripes(pyr[0].size(), pyr[1].rows);
+    std::vector<std::vector<Range> > rows(maxlevel + 1, std::vector<Range>(nstripes));
+    for( int i = 0; i < nstripes; i++ )
+    {
+        rows[1][i] = Range(pyr[1].rows*i/nstripes, pyr[1].rows*(i + 1)/nstripes);
+        for( int k = 2; k <= maxlevel; k++ )
+        {
+            const Range& r = rows[k-1][i];
+            rows[k][i] = Range(r.start == 0 ? 0 : (r.start + 3)/2,
+                               r.end == pyr[k-1].rows ? pyr[k].rows : std::max((r.end - 1)/2, 0));
+        }
+    }
+
+    parallel_for_(Range(0, nstripes), PyramidInvoker<CastOp>(pyr, borderType, rows), nstripes);
+
+    for( int k = 2; k <= maxlevel && nstripes > 1; k++ )
+    {
+        std::vector<uchar> done(pyr[k].rows, (uchar)0);
+        for( int i = 0; i < nstripes; i++ )
+            for( int y = rows[k][i].start; y < rows[k][i].end; y++ )
+                done[y] = 1;
+
+        PyrDownRows<CastOp> filter(pyr[k-1], pyr[k], borderType);
+        for( int y = 0; y < pyr[k].rows; y++ )
+        {
+            if( done[y] )
+                continue;
+            int end = y + 1;
+            while( end < pyr[k].rows && !done[end] )
+                end++;
+            filter(y, end);
+            y = end;
         }
+    }
+}
 
-        // do vertical convolution and decimation and write the result to the destination image
-        for( k = 0; k < PU_SZ; k++ )
-            rows[k] = buf + ((y - PU_SZ/2 + k - sy0) % PU_SZ)*bufstep;
-        row0 = rows[0]; row1 = rows[1]; row2 = rows[2];
-        dsts[0] = dst0; dsts[1] = dst1;
 
-        x = PyrUpVecV<WT, T>(rows, dsts, dsize.width);
-        for( ; x < dsize.width; x++ )
+template<class CastOp> class PyrUpInvoker : public ParallelLoopBody
+{
+public:
+    PyrUpInvoker( const Mat& src, Mat& dst ) : _src(&src), _dst(&dst) {}
+
+    // computes the destination rows produced by the source rows of the range
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        const int PU_SZ = 3;
+        typedef typename CastOp::type1 WT;
+        typedef typename CastOp::rtype T;
+
+        Size ssize = _src->size(), dsize = _dst->size();
+        int cn = _src->channels();
+        int bufstep = (int)alignSize((dsize.width+1)*cn, 16);
+        AutoBuffer<WT> _buf(bufstep*PU_SZ + 16);
+        WT* buf = alignPtr((WT*)_buf.data(), 16);
+        AutoBuffer<int> _dtab(ssize.width*cn);
+        int* dtab = _dtab.data();
+        WT* rows[PU_SZ];
+        T* dsts[2];
+        CastOp castOp;
+        //PyrUpVecH<T, WT> vecOpH;
+
+        int k, x, sy0 = -PU_SZ/2, sy = range.start + sy0;
+
+        ssize.width *= cn;
+        dsize.width *= cn;
+
+        for( x = 0; x < ssize.width; x++ )
+            dtab[x] = (x/cn)*2*cn + x % cn;
+
+        for( int y = range.start; y < range.end; y++ )
         {
-            T t1 = castOp((row1[x] + row2[x])*4);
-            T t0 = castOp(row0[x] + row1[x]*6 + row2[x]);
-            dst1[x] = t1; dst0[x] = t0;
+            T* dst0 = _dst->ptr<T>(y*2);
+            T* dst1 = _dst->ptr<T>(std::min(y*2+1, dsize.height-1));
+            WT *row0, *row1, *row2;
+
+            // fill the ring buffer (horizontal convolution and decimation)
+            for( ; sy <= y + 1; sy++ )
+            {
+                WT* row = buf + ((sy - sy0) % PU_SZ)*bufstep;
+                int _sy = borderInterpolate(sy*2, ssize.height*2, BORDER_REFLECT_101)/2;
+                const T* src = _src->ptr<T>(_sy);
+
+                if( ssize.width == cn )
+                {
+                    for( x = 0; x < cn; x++ )
+                        row[x] = row[x + cn] = src[x]*8;
+                    continue;
+                }
+
+                for( x = 0; x < cn; x++ )
+                {
+                    int dx = dtab[x];
+                    WT t0 = src[x]*6 + src[x + cn]*2;
+                    WT t1 = (src[x] + src[x + cn])*4;
+                    row[dx] = t0; row[dx + cn] = t1;
+                    dx = dtab[ssize.width - cn + x];
+                    int sx = ssize.width - cn + x;
+                    t0 = src[sx - cn] + src[sx]*7;
+                    t1 = src[sx]*8;
+                    row[dx] = t0; row[dx + cn] = t1;
+
+                    if (dsize.width > ssize.width*2)
+                    {
+                        row[(_dst->cols-1) + x] = row[dx + cn];
+                    }
+                }
+
+                for( x = cn; x < ssize.width - cn; x++ )
+                {
+                    int dx = dtab[x];
+                    WT t0 = src[x-cn] + src[x]*6 + src[x+cn];
+                    WT t1 = (src[x] + src[x+cn])*4;
+                    row[dx] = t0;
+                    row[dx+cn] = t1;
+                }
+            }
+
+            // do vertical convolution and decimation and write the result to the destination image
+            for( k = 0; k < PU_SZ; k++ )
+                rows[k] = buf + ((y - PU_SZ/2 + k - sy0) % PU_SZ)*bufstep;
+            row0 = rows[0]; row1 = rows[1]; row2 = rows[2];
+            dsts[0] = dst0; dsts[1] = dst1;
+
+            x = PyrUpVecV<WT, T>(rows, dsts, dsize.width);
+            for( ; x < dsize.width; x++ )
+            {
+                T t1 = castOp((row1[x] + row2[x])*4);
+                T t0 = castOp(row0[x] + row1[x]*6 + row2[x]);
+                dst1[x] = t1; dst0[x] = t0;
+            }
         }
     }
 
+private:
+    const Mat* _src;
+    Mat* _dst;
+};
+
+template<class CastOp> void
+pyrUp_( const Mat& _src, Mat& _dst, int)
+{
+    typedef typename CastOp::rtype T;
+
+    Size ssize = _src.size(), dsize = _dst.size();
+    int x;
+
+    CV_Assert( std::abs(dsize.width - ssize.width*2) == dsize.width % 2 &&
+               std::abs(dsize.height - ssize.height*2) == dsize.height % 2);
+
+    parallel_for_(Range(0, ssize.height), PyrUpInvoker<CastOp>(_src, _dst),
+                  getPyrNumStripes(dsize, ssize.height));
+
+    dsize.width *= _src.channels();
     if (dsize.height > ssize.height*2)
     {
         T* dst0 = _dst.ptr<T>(ssize.height*2-2);
@@ -962,6 +1145,7 @@ pyrUp_( const Mat& _src, Mat& _dst, int)
 }
 
 typedef void (*PyrFunc)(const Mat&, Mat&, int);
+typedef void (*PyramidFunc)(std::vector<Mat>&, int);
 
 #ifdef HAVE_OPENCL
 
@@ -1518,6 +1702,38 @@ void cv::buildPyramid( InputArray _src, OutputArrayOfArrays _dst, int maxlevel,
     CV_IPP_RUN(((IPP_VERSION_X100 >= 810) && ((borderType & ~BORDER_ISOLATED) == BORDER_DEFAULT && (!_src.isSubmatrix() || ((borderType & BORDER_ISOLATED) != 0)))),
         ipp_buildpyramid( _src,  _dst,  maxlevel,  borderType));
 
+    // The levels are produced together by rows, so the top rows of the level
+    // can't depend on the bottom ones.
+    PyramidFunc func = 0;
+    if( maxlevel >= 1 && !src.empty() && (borderType & ~BORDER_ISOLATED) != BORDER_WRAP )
+    {
+        int depth = src.depth();
+        if( depth == CV_8U )
+            func = buildPyramid_< FixPtCast<uchar, 8> >;
+        else if( depth == CV_16S )
+            func = buildPyramid_< FixPtCast<short, 8> >;
+        else if( depth == CV_16U )
+            func = buildPyramid_< FixPtCast<ushort, 8> >;
+        else if( depth == CV_32F )
+            func = buildPyramid_< FltCast<float, 8> >;
+        else if( depth == CV_64F )
+            func = buildPyramid_< FltCast<double, 8> >;
+    }
+
+    if( func )
+    {
+        std::vector<Mat> pyr(maxlevel + 1);
+        pyr[0] = src;
+        for( ; i <= maxlevel; i++ )
+        {
+            Mat& dst = _dst.getMatRef(i);
+            dst.create((pyr[i-1].rows + 1)/2, (pyr[i-1].cols + 1)/2, src.type());
+            pyr[i] = dst;
+        }
+        func(pyr, borderType);
+        return;
+    }
+
     for( ; i <= maxlevel; i++ )
         pyrDown( _dst.getMatRef(i-1), _dst.getMatRef(i), Size(), borderType );
 }
@@ -34,18 +34,16 @@ public:
         const int sqsumstep = (int)(_sqsumstep/sizeof(double));
         const int ops_per_line = width * num_channels;
 
-        // Clear the first line of the sum as per spec (see integral documentation)
-        // Also adjust the index of sum and sqsum to be at the real 0th element
-        // and not point to the border pixel so it stays in sync with the src pointer
-        memset( sum, 0, (ops_per_line+num_channels)*sizeof(double));
+        // The first line of the sum is initialized by the caller (it's zeroes for
+        // the whole image). Adjust the index of sum and sqsum to be at the real 0th
+        // element and not point to the border pixel so it stays in sync with the src pointer
         sum += num_channels;
 
         if (sqsum) {
-            memset( sqsum, 0, (ops_per_line+num_channels)*sizeof(double));
             sqsum += num_channels;
         }
 
-        // Now calculate the integral over the whole image one line at a time
+        // Now calculate the integral one line at a time
         for(int y = 0; y < height; y++) {
             const uchar * src_line    = &src[y*srcstep];
             double      * sum_above   = &sum[y*sumstep];
@@ -49,6 +49,7 @@
 namespace cv
 {
 
+// Computes the rows 1..height of the integrals. Their row 0 is initialized by the caller.
 template <typename T, typename ST, typename QT>
 struct Integral_SIMD
 {
@@ -62,70 +63,96 @@ struct Integral_SIMD
     }
 };
 
+#if CV_SIMD && CV_SIMD_WIDTH <= 64
 
-template <>
-struct Integral_SIMD<uchar, double, double> {
-    Integral_SIMD() {};
-
-
-    bool operator()(const uchar *src, size_t _srcstep,
-                    double *sum,      size_t _sumstep,
-                    double *sqsum,    size_t _sqsumstep,
-                    double *tilted,   size_t _tiltedstep,
-                    int width, int height, int cn) const
-    {
-#if CV_TRY_AVX512_SKX
-        CV_UNUSED(_tiltedstep);
-        // TODO:  Add support for 1 channel input (WIP)
-        if (CV_CPU_HAS_SUPPORT_AVX512_SKX && !tilted && (cn <= 4)){
-            opt_AVX512_SKX::calculate_integral_avx512(src, _srcstep, sum, _sumstep,
-                                                      sqsum, _sqsumstep, width, height, cn);
-            return true;
-        }
-#else
-        // Avoid warnings in some builds
-        CV_UNUSED(src); CV_UNUSED(_srcstep); CV_UNUSED(sum); CV_UNUSED(_sumstep);
-        CV_UNUSED(sqsum); CV_UNUSED(_sqsumstep); CV_UNUSED(tilted); CV_UNUSED(_tiltedstep);
-        CV_UNUSED(width); CV_UNUSED(height); CV_UNUSED(cn);
+static inline v_int32 v_integral_scan(const v_int32& a)
+{
+    v_int32 r = a + v_rotate_left<1>(a);
+    r += v_rotate_left<2>(r);
+#if CV_SIMD_WIDTH >= 32
+    r += v_rotate_left<4>(r);
+#if CV_SIMD_WIDTH == 64
+    r += v_rotate_left<8>(r);
 #endif
-        return false;
-    }
+#endif
+    return r;
+}
 
-};
+static inline v_int32 v_integral_last(const v_int32& a)
+{
+    return vx_setall_s32(v_rotate_right<v_int32::nlanes - 1>(a).get0());
+}
 
-#if CV_SIMD && CV_SIMD_WIDTH <= 64
+static inline void v_integral_store(int* dst, const int* prev, const v_int32& a)
+{
+    v_store(dst, a + vx_load(prev));
+}
 
-template <>
-struct Integral_SIMD<uchar, int, double>
+static inline void v_integral_store(float* dst, const float* prev, const v_int32& a)
 {
-    Integral_SIMD() {}
+    v_store(dst, v_cvt_f32(a) + vx_load(prev));
+}
+
+#if CV_SIMD_64F
+static inline void v_integral_store(double* dst, const double* prev, const v_int32& a)
+{
+    v_store(dst, v_cvt_f64(a) + vx_load(prev));
+    v_store(dst + v_float64::nlanes, v_cvt_f64_high(a) + vx_load(prev + v_float64::nlanes));
+}
+#endif
 
+// Integrals of single channel 8-bit images. Running sums of the rows are kept in
+// 32-bit integers and converted to the output types when they are added to the
+// previous rows, so the results are the same as the scalar ones.
+template <typename ST, typename QT>
+struct Integral8u_SIMD
+{
     bool operator()(const uchar * src, size_t _srcstep,
-                    int * sum, size_t _sumstep,
-                    double * sqsum, size_t,
-                    int * tilted, size_t,
+                    ST * sum, size_t _sumstep,
+                    QT * sqsum, size_t _sqsumstep,
+                    ST * tilted, size_t,
                     int width, int height, int cn) const
     {
-        if (sqsum || tilted || cn != 1)
+        // the running sums must be exact and fit 32-bit integers
+        if (tilted || cn != 1 ||
+            (sizeof(ST) == sizeof(float) && !std::numeric_limits<ST>::is_integer && width >= (1 << 16)) ||
+            (sqsum && sizeof(QT) == sizeof(float) && !std::numeric_limits<QT>::is_integer) ||
+            (sqsum && !std::numeric_limits<QT>::is_integer && width >= (1 << 15)))
             return false;
 
-        // the first iteration
-        memset(sum, 0, (width + 1) * sizeof(int));
+        if (sqsum)
+            calc<true>(src, _srcstep, sum, _sumstep, sqsum, _sqsumstep, width, height);
+        else
+            calc<false>(src, _srcstep, sum, _sumstep, sqsum, _sqsumstep, width, height);
+        vx_cleanup();
+
+        return true;
+    }
 
-        // the others
+    template <bool withSqsum>
+    static void calc(const uchar * src, size_t _srcstep,
+                     ST * sum, size_t _sumstep,
+                     QT * sqsum, size_t _sqsumstep,
+                     int width, int height)
+    {
         for (int i = 0; i < height; ++i)
         {
             const uchar * src_row = src + _srcstep * i;
-            int * prev_sum_row = (int *)((uchar *)sum + _sumstep * i) + 1;
-            int * sum_row = (int *)((uchar *)sum + _sumstep * (i + 1)) + 1;
+            ST * prev_sum_row = (ST *)((uchar *)sum + _sumstep * i) + 1;
+            ST * sum_row = (ST *)((uchar *)sum + _sumstep * (i + 1)) + 1;
+            QT * prev_sqsum_row = withSqsum ? (QT *)((uchar *)sqsum + _sqsumstep * i) + 1 : 0;
+            QT * sqsum_row = withSqsum ? (QT *)((uchar *)sqsum + _sqsumstep * (i + 1)) + 1 : 0;
 
             sum_row[-1] = 0;
+            if (withSqsum)
+                sqsum_row[-1] = 0;
 
-            v_int32 prev = vx_setzero_s32();
+            v_int32 prev = vx_setzero_s32(), prevsq = vx_setzero_s32();
             int j = 0;
             for ( ; j + v_uint16::nlanes <= width; j += v_uint16::nlanes)
             {
-                v_int16 el8 = v_reinterpret_as_s16(vx_load_expand(src_row + j));
+                v_uint16 el = vx_load_expand(src_row + j);
+                v_int16 el8 = v_reinterpret_as_s16(el);
                 v_int32 el4l, el4h;
 #if CV_AVX2 && CV_SIMD_WIDTH == 32
                 __m256i vsum = _mm256_add_epi16(el8.val, _mm256_slli_si256(el8.val, 2));
@@ -147,128 +174,102 @@ struct Integral_SIMD<uchar, int, double>
                 v_expand(el8, el4l, el4h);
                 el4l += prev;
                 el4h += el4l;
-                prev = vx_setall_s32(v_rotate_right<v_int32::nlanes - 1>(el4h).get0());
+                prev = v_integral_last(el4h);
 #endif
-                v_store(sum_row + j                  , el4l + vx_load(prev_sum_row + j                  ));
-                v_store(sum_row + j + v_int32::nlanes, el4h + vx_load(prev_sum_row + j + v_int32::nlanes));
+                v_integral_store(sum_row + j                  , prev_sum_row + j                  , el4l);
+                v_integral_store(sum_row + j + v_int32::nlanes, prev_sum_row + j + v_int32::nlanes, el4h);
+
+                if (withSqsum)
+                {
+                    v_uint32 sq0, sq1;
+                    v_mul_expand(el, el, sq0, sq1);
+                    v_int32 sq4l = v_integral_scan(v_reinterpret_as_s32(sq0)) + prevsq;
+                    v_int32 sq4h = v_integral_scan(v_reinterpret_as_s32(sq1)) + v_integral_last(sq4l);
+                    prevsq = v_integral_last(sq4h);
+                    v_integral_store(sqsum_row + j                  , prev_sqsum_row + j                  , sq4l);
+                    v_integral_store(sqsum_row + j + v_int32::nlanes, prev_sqsum_row + j + v_int32::nlanes, sq4h);
+                }
             }
 
-            for (int v = sum_row[j - 1] - prev_sum_row[j - 1]; j < width; ++j)
-                sum_row[j] = (v += src_row[j]) + prev_sum_row[j];
+            int v = prev.get0(), vsq = prevsq.get0();
+            for ( ; j < width; ++j)
+            {
+                int it = src_row[j];
+                sum_row[j] = prev_sum_row[j] + (ST)(v += it);
+                if (withSqsum)
+                    sqsum_row[j] = prev_sqsum_row[j] + (QT)(vsq += it*it);
+            }
         }
-        vx_cleanup();
-
-        return true;
     }
 };
 
-template <>
-struct Integral_SIMD<uchar, float, double>
-{
-    Integral_SIMD() {}
-
-    bool operator()(const uchar * src, size_t _srcstep,
-        float * sum, size_t _sumstep,
-        double * sqsum, size_t,
-        float * tilted, size_t,
-        int width, int height, int cn) const
-    {
-        if (sqsum || tilted || cn != 1)
-            return false;
+template <> struct Integral_SIMD<uchar, int, double> : Integral8u_SIMD<int, double> {};
+template <> struct Integral_SIMD<uchar, int, float> : Integral8u_SIMD<int, float> {};
+template <> struct Integral_SIMD<uchar, int, int> : Integral8u_SIMD<int, int> {};
+template <> struct Integral_SIMD<uchar, float, double> : Integral8u_SIMD<float, double> {};
+template <> struct Integral_SIMD<uchar, float, float> : Integral8u_SIMD<float, float> {};
 
-        // the first iteration
-        memset(sum, 0, (width + 1) * sizeof(int));
+#endif
 
-        // the others
-        for (int i = 0; i < height; ++i)
-        {
-            const uchar * src_row = src + _srcstep * i;
-            float * prev_sum_row = (float *)((uchar *)sum + _sumstep * i) + 1;
-            float * sum_row = (float *)((uchar *)sum + _sumstep * (i + 1)) + 1;
+template <>
+struct Integral_SIMD<uchar, double, double> {
+    Integral_SIMD() {};
 
-            sum_row[-1] = 0;
 
-            v_float32 prev = vx_setzero_f32();
-            int j = 0;
-            for (; j + v_uint16::nlanes <= width; j += v_uint16::nlanes)
-            {
-                v_int16 el8 = v_reinterpret_as_s16(vx_load_expand(src_row + j));
-                v_float32 el4l, el4h;
-#if CV_AVX2 && CV_SIMD_WIDTH == 32
-                __m256i vsum = _mm256_add_epi16(el8.val, _mm256_slli_si256(el8.val, 2));
-                vsum = _mm256_add_epi16(vsum, _mm256_slli_si256(vsum, 4));
-                vsum = _mm256_add_epi16(vsum, _mm256_slli_si256(vsum, 8));
-                __m256i shmask = _mm256_set1_epi32(7);
-                el4l.val = _mm256_add_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_v256_extract_low(vsum))), prev.val);
-                el4h.val = _mm256_add_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_v256_extract_high(vsum))), _mm256_permutevar8x32_ps(el4l.val, shmask));
-                prev.val = _mm256_permutevar8x32_ps(el4h.val, shmask);
-#else
-                el8 += v_rotate_left<1>(el8);
-                el8 += v_rotate_left<2>(el8);
-#if CV_SIMD_WIDTH >= 32
-                el8 += v_rotate_left<4>(el8);
-#if CV_SIMD_WIDTH == 64
-                el8 += v_rotate_left<8>(el8);
-#endif
+    bool operator()(const uchar *src, size_t _srcstep,
+                    double *sum,      size_t _sumstep,
+                    double *sqsum,    size_t _sqsumstep,
+                    double *tilted,   size_t _tiltedstep,
+                    int width, int height, int cn) const
+    {
+#if CV_TRY_AVX512_SKX
+        // TODO:  Add support for 1 channel input (WIP)
+        if (CV_CPU_HAS_SUPPORT_AVX512_SKX && !tilted && (cn <= 4)){
+            opt_AVX512_SKX::calculate_integral_avx512(src, _srcstep, sum, _sumstep,
+                                                      sqsum, _sqsumstep, width, height, cn);
+            return true;
+        }
 #endif
-                v_int32 el4li, el4hi;
-                v_expand(el8, el4li, el4hi);
-                el4l = v_cvt_f32(el4li) + prev;
-                el4h = v_cvt_f32(el4hi) + el4l;
-                prev = vx_setall_f32(v_rotate_right<v_float32::nlanes - 1>(el4h).get0());
+#if CV_SIMD_64F && CV_SIMD_WIDTH <= 64
+        return Integral8u_SIMD<double, double>()(src, _srcstep, sum, _sumstep,
+                                                 sqsum, _sqsumstep, tilted, _tiltedstep,
+                                                 width, height, cn);
+#else
+        // Avoid warnings in some builds
+        CV_UNUSED(src); CV_UNUSED(_srcstep); CV_UNUSED(sum); CV_UNUSED(_sumstep);
+        CV_UNUSED(sqsum); CV_UNUSED(_sqsumstep); CV_UNUSED(tilted); CV_UNUSED(_tiltedstep);
+        CV_UNUSED(width); CV_UNUSED(height); CV_UNUSED(cn);
+        return false;
 #endif
-                v_store(sum_row + j                    , el4l + vx_load(prev_sum_row + j                    ));
-                v_store(sum_row + j + v_float32::nlanes, el4h + vx_load(prev_sum_row + j + v_float32::nlanes));
-            }
-
-            for (float v = sum_row[j - 1] - prev_sum_row[j - 1]; j < width; ++j)
-                sum_row[j] = (v += src_row[j]) + prev_sum_row[j];
-        }
-        vx_cleanup();
-
-        return true;
     }
-};
 
-#endif
+};
 
+// Computes the rows 1..height of the sums and the squared sums (if sqsum != 0)
+// from their row 0, which is initialized by the caller.
 template<typename T, typename ST, typename QT>
-void integral_( const T* src, size_t _srcstep, ST* sum, size_t _sumstep,
-                QT* sqsum, size_t _sqsumstep, ST* tilted, size_t _tiltedstep,
-                int width, int height, int cn )
+void integralRows_( const T* src, size_t _srcstep, ST* sum, size_t _sumstep,
+                    QT* sqsum, size_t _sqsumstep, int width, int height, int cn )
 {
     int x, y, k;
 
     if (Integral_SIMD<T, ST, QT>()(src, _srcstep,
                                    sum, _sumstep,
                                    sqsum, _sqsumstep,
-                                   tilted, _tiltedstep,
+                                   0, 0,
                                    width, height, cn))
         return;
 
     int srcstep = (int)(_srcstep/sizeof(T));
     int sumstep = (int)(_sumstep/sizeof(ST));
-    int tiltedstep = (int)(_tiltedstep/sizeof(ST));
     int sqsumstep = (int)(_sqsumstep/sizeof(QT));
 
     width *= cn;
-
-    memset( sum, 0, (width+cn)*sizeof(sum[0]));
     sum += sumstep + cn;
-
     if( sqsum )
-    {
-        memset( sqsum, 0, (width+cn)*sizeof(sqsum[0]));
         sqsum += sqsumstep + cn;
-    }
-
-    if( tilted )
-    {
-        memset( tilted, 0, (width+cn)*sizeof(tilted[0]));
-        tilted += tiltedstep + cn;
-    }
 
-    if( sqsum == 0 && tilted == 0 )
+    if( sqsum == 0 )
     {
         for( y = 0; y < height; y++, src += srcstep - cn, sum += sumstep - cn )
         {
@@ -283,7 +284,7 @@ void integral_( const T* src, size_t _srcstep, ST* sum, size_t _sumstep,
             }
         }
     }
-    else if( tilted == 0 )
+    else
     {
         for( y = 0; y < height; y++, src += srcstep - cn,
                         sum += sumstep - cn, sqsum += sqsumstep - cn )
@@ -305,96 +306,252 @@ void integral_( const T* src, size_t _srcstep, ST* sum, size_t _sumstep,
             }
         }
     }
-    else
+}
+
+// Sums of integers are exact, so they can be accumulated in any order.
+template<typename T, typename WT> static inline bool isExactSum()
+{
+    return std::numeric_limits<T>::is_integer &&
+           (std::numeric_limits<WT>::is_integer || sizeof(WT) == sizeof(double));
+}
+
+// Two-pass parallel integral by row stripes. The first pass computes sums of the
+// source columns over every stripe, then the integral rows on the stripe borders
+// are computed from them, and the second pass computes the rest of the rows of
+// every stripe starting from its border row.
+template<typename T, typename ST, typename QT>
+class IntegralInvoker : public ParallelLoopBody
+{
+public:
+    IntegralInvoker( const T* _src, size_t _srcstep, ST* _sum, size_t _sumstep,
+                     QT* _sqsum, size_t _sqsumstep, int _width, int _height, int _cn,
+                     const std::vector<int>& _stripes, ST* _colsum, QT* _colsqsum ) :
+        src(_src), srcstep(_srcstep), sum(_sum), sumstep(_sumstep), sqsum(_sqsum), sqsumstep(_sqsumstep),
+        width(_width), height(_height), cn(_cn), stripes(&_stripes), colsum(_colsum), colsqsum(_colsqsum)
     {
-        AutoBuffer<ST> _buf(width+cn);
-        ST* buf = _buf.data();
-        ST s;
-        QT sq;
-        for( k = 0; k < cn; k++, src++, sum++, tilted++, buf++ )
+    }
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        const std::vector<int>& ys = *stripes;
+        const int len = width*cn, nstripes = (int)ys.size() - 1;
+        for( int i = range.start; i < range.end; i++ )
         {
-            sum[-cn] = tilted[-cn] = 0;
+            if( colsum )
+            {
+                // the first pass, the last stripe isn't needed for the border rows
+                if( i == nstripes - 1 )
+                    continue;
+                ST* s = colsum + (size_t)i*len;
+                QT* sq = sqsum ? colsqsum + (size_t)i*len : 0;
+                memset(s, 0, len*sizeof(s[0]));
+                if( sq )
+                    memset(sq, 0, len*sizeof(sq[0]));
+                for( int y = ys[i]; y < ys[i+1]; y++ )
+                {
+                    const T* srow = (const T*)((const uchar*)src + srcstep*y);
+                    for( int x = 0; x < len; x++ )
+                        s[x] += srow[x];
+                    if( sq )
+                        for( int x = 0; x < len; x++ )
+                            sq[x] += (QT)srow[x]*srow[x];
+                }
+            }
+            else
+            {
+                // the second pass, the last row of the stripe is the border row of the next one
+                int y0 = ys[i], y1 = i < nstripes - 1 ? ys[i+1] - 1 : height;
+                integralRows_((const T*)((const uchar*)src + srcstep*y0), srcstep,
+                              (ST*)((uchar*)sum + sumstep*y0), sumstep,
+                              sqsum ? (QT*)((uchar*)sqsum + sqsumstep*y0) : 0, sqsumstep,
+                              width, y1 - y0, cn);
+            }
+        }
+    }
+
+private:
+    const T* src;
+    size_t srcstep;
+    ST* sum;
+    size_t sumstep;
+    QT* sqsum;
+    size_t sqsumstep;
+    int width, height, cn;
+    const std::vector<int>* stripes;
+    ST* colsum;
+    QT* colsqsum;
+};
 
-            for( x = 0, s = 0, sq = 0; x < width; x += cn )
+// Computes the integral row y from the sums of the source columns over the rows [0, y)
+template<typename ST, typename WT> static void
+integralRowFromColumnSums( const WT* colsum, ST* row, int width, int cn )
+{
+    for( int k = 0; k < cn; k++ )
+    {
+        ST s = row[k] = 0;
+        for( int x = k; x < width*cn; x += cn )
+        {
+            s += colsum[x];
+            row[x + cn] = s;
+        }
+    }
+}
+
+template<typename T, typename ST, typename QT>
+void integral_( const T* src, size_t _srcstep, ST* sum, size_t _sumstep,
+                QT* sqsum, size_t _sqsumstep, ST* tilted, size_t _tiltedstep,
+                int width, int height, int cn )
+{
+    int x, y, k;
+
+    memset( sum, 0, (width+1)*cn*sizeof(sum[0]));
+    if( sqsum )
+        memset( sqsum, 0, (width+1)*cn*sizeof(sqsum[0]));
+
+    if( !tilted )
+    {
+        int nstripes = std::min(std::min(getNumThreads(), height/16), (int)(((int64)width*height*cn) >> 16));
+        if( nstripes > 1 && isExactSum<T, ST>() && (!sqsum || isExactSum<T, QT>()) )
+        {
+            const int len = width*cn;
+            std::vector<int> ys(nstripes + 1);
+            for( int i = 0; i <= nstripes; i++ )
+                ys[i] = height*i/nstripes;
+            AutoBuffer<ST> _colsum((size_t)(nstripes - 1)*len);
+            AutoBuffer<QT> _colsqsum(sqsum ? (size_t)(nstripes - 1)*len : 1);
+            ST* colsum = _colsum.data();
+            QT* colsqsum = _colsqsum.data();
+
+            parallel_for_(Range(0, nstripes), IntegralInvoker<T, ST, QT>(src, _srcstep, sum, _sumstep, sqsum, _sqsumstep,
+                                                                        width, height, cn, ys, colsum, colsqsum), nstripes);
+
+            for( int i = 1; i < nstripes; i++ )
             {
-                T it = src[x];
-                buf[x] = tilted[x] = it;
-                s += it;
-                sq += (QT)it*it;
-                sum[x] = s;
+                // accumulate the column sums over the stripes above
+                ST* s = colsum + (size_t)(i - 1)*len;
+                QT* sq = colsqsum + (size_t)(i - 1)*len;
+                if( i > 1 )
+                {
+                    for( x = 0; x < len; x++ )
+                        s[x] += s[x - len];
+                    if( sqsum )
+                        for( x = 0; x < len; x++ )
+                            sq[x] += sq[x - len];
+                }
+                integralRowFromColumnSums(s, (ST*)((uchar*)sum + _sumstep*ys[i]), width, cn);
                 if( sqsum )
-                    sqsum[x] = sq;
+                    integralRowFromColumnSums(sq, (QT*)((uchar*)sqsum + _sqsumstep*ys[i]), width, cn);
             }
 
-            if( width == cn )
-                buf[cn] = 0;
+            parallel_for_(Range(0, nstripes), IntegralInvoker<T, ST, QT>(src, _srcstep, sum, _sumstep, sqsum, _sqsumstep,
+                                                                        width, height, cn, ys, 0, 0), nstripes);
+        }
+        else
+            integralRows_(src, _srcstep, sum, _sumstep, sqsum, _sqsumstep, width, height, cn);
+        return;
+    }
+
+    int srcstep = (int)(_srcstep/sizeof(T));
+    int sumstep = (int)(_sumstep/sizeof(ST));
+    int tiltedstep = (int)(_tiltedstep/sizeof(ST));
+    int sqsumstep = (int)(_sqsumstep/sizeof(QT));
+
+    width *= cn;
+
+    sum += sumstep + cn;
+    if( sqsum )
+        sqsum += sqsumstep + cn;
+
+    memset( tilted, 0, (width+cn)*sizeof(tilted[0]));
+    tilted += tiltedstep + cn;
+
+    AutoBuffer<ST> _buf(width+cn);
+    ST* buf = _buf.data();
+    ST s;
+    QT sq;
+    for( k = 0; k < cn; k++, src++, sum++, tilted++, buf++ )
+    {
+        sum[-cn] = tilted[-cn] = 0;
 
+        for( x = 0, s = 0, sq = 0; x < width; x += cn )
+        {
+            T it = src[x];
+            buf[x] = tilted[x] = it;
+            s += it;
+            sq += (QT)it*it;
+            sum[x] = s;
             if( sqsum )
-            {
-                sqsum[-cn] = 0;
-                sqsum++;
-            }
+                sqsum[x] = sq;
         }
 
-        for( y = 1; y < height; y++ )
+        if( width == cn )
+            buf[cn] = 0;
+
+        if( sqsum )
         {
-            src += srcstep - cn;
-            sum += sumstep - cn;
-            tilted += tiltedstep - cn;
-            buf += -cn;
+            sqsum[-cn] = 0;
+            sqsum++;
+        }
+    }
 
-            if( sqsum )
-                sqsum += sqsumstep - cn;
+    for( y = 1; y < height; y++ )
+    {
+        src += srcstep - cn;
+        sum += sumstep - cn;
+        tilted += tiltedstep - cn;
+        buf += -cn;
 
-            for( k = 0; k < cn; k++, src++, sum++, tilted++, buf++ )
-            {
-                T it = src[0];
-                ST t0 = s = it;
-                QT tq0 = sq = (QT)it*it;
+        if( sqsum )
+            sqsum += sqsumstep - cn;
 
-                sum[-cn] = 0;
-                if( sqsum )
-                    sqsum[-cn] = 0;
-                tilted[-cn] = tilted[-tiltedstep];
+        for( k = 0; k < cn; k++, src++, sum++, tilted++, buf++ )
+        {
+            T it = src[0];
+            ST t0 = s = it;
+            QT tq0 = sq = (QT)it*it;
 
-                sum[0] = sum[-sumstep] + t0;
-                if( sqsum )
-                    sqsum[0] = sqsum[-sqsumstep] + tq0;
-                tilted[0] = tilted[-tiltedstep] + t0 + buf[cn];
+            sum[-cn] = 0;
+            if( sqsum )
+                sqsum[-cn] = 0;
+            tilted[-cn] = tilted[-tiltedstep];
 
-                for( x = cn; x < width - cn; x += cn )
-                {
-                    ST t1 = buf[x];
-                    buf[x - cn] = t1 + t0;
-                    t0 = it = src[x];
-                    tq0 = (QT)it*it;
-                    s += t0;
-                    sq += tq0;
-                    sum[x] = sum[x - sumstep] + s;
-                    if( sqsum )
-                        sqsum[x] = sqsum[x - sqsumstep] + sq;
-                    t1 += buf[x + cn] + t0 + tilted[x - tiltedstep - cn];
-                    tilted[x] = t1;
-                }
+            sum[0] = sum[-sumstep] + t0;
+            if( sqsum )
+                sqsum[0] = sqsum[-sqsumstep] + tq0;
+            tilted[0] = tilted[-tiltedstep] + t0 + buf[cn];
 
-                if( width > cn )
-                {
-                    ST t1 = buf[x];
-                    buf[x - cn] = t1 + t0;
-                    t0 = it = src[x];
-                    tq0 = (QT)it*it;
-                    s += t0;
-                    sq += tq0;
-                    sum[x] = sum[x - sumstep] + s;
-                    if( sqsum )
-                        sqsum[x] = sqsum[x - sqsumstep] + sq;
-                    tilted[x] = t0 + t1 + tilted[x - tiltedstep - cn];
-                    buf[x] = t0;
-                }
+            for( x = cn; x < width - cn; x += cn )
+            {
+                ST t1 = buf[x];
+                buf[x - cn] = t1 + t0;
+                t0 = it = src[x];
+                tq0 = (QT)it*it;
+                s += t0;
+                sq += tq0;
+                sum[x] = sum[x - sumstep] + s;
+                if( sqsum )
+                    sqsum[x] = sqsum[x - sqsumstep] + sq;
+                t1 += buf[x + cn] + t0 + tilted[x - tiltedstep - cn];
+                tilted[x] = t1;
+            }
 
+            if( width > cn )
+            {
+                ST t1 = buf[x];
+                buf[x - cn] = t1 + t0;
+                t0 = it = src[x];
+                tq0 = (QT)it*it;
+                s += t0;
+                sq += tq0;
+                sum[x] = sum[x - sumstep] + s;
                 if( sqsum )
-                    sqsum++;
+                    sqsum[x] = sqsum[x - sqsumstep] + sq;
+                tilted[x] = t0 + t1 + tilted[x - tiltedstep - cn];
+                buf[x] = t0;
             }
+
+            if( sqsum )
+                sqsum++;
         }
     }
 }
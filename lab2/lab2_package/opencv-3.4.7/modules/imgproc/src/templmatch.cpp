@@ -838,11 +838,10 @@ static void matchTemplateMask( InputArray _img, InputArray _templ, OutputArray _
         CV_Error(Error::StsNotImplemented, "");
 }
 
-static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method, int cn )
+// Computes the result of matchTemplate from the cross-correlation in result
+// and the integrals of the image, sqsum is not used for CV_TM_CCOEFF.
+static void common_matchTemplate( const Mat& sum, const Mat& sqsum, const Mat& templ, Mat& result, int method, int cn )
 {
-    if( method == CV_TM_CCORR )
-        return;
-
     int numType = method == CV_TM_CCORR || method == CV_TM_CCORR_NORMED ? 0 :
                   method == CV_TM_CCOEFF || method == CV_TM_CCOEFF_NORMED ? 1 : 2;
     bool isNormed = method == CV_TM_CCORR_NORMED ||
@@ -851,19 +850,16 @@ static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method,
 
     double invArea = 1./((double)templ.rows * templ.cols);
 
-    Mat sum, sqsum;
     Scalar templMean, templSdv;
     double *q0 = 0, *q1 = 0, *q2 = 0, *q3 = 0;
     double templNorm = 0, templSum2 = 0;
 
     if( method == CV_TM_CCOEFF )
     {
-        integral(img, sum, CV_64F);
         templMean = mean(templ);
     }
     else
     {
-        integral(img, sum, sqsum, CV_64F);
         meanStdDev( templ, templMean, templSdv );
 
         templNorm = templSdv[0]*templSdv[0] + templSdv[1]*templSdv[1] + templSdv[2]*templSdv[2] + templSdv[3]*templSdv[3];
@@ -962,6 +958,175 @@ static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method,
         }
     }
 }
+
+static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method, int cn )
+{
+    if( method == CV_TM_CCORR )
+        return;
+
+    Mat sum, sqsum;
+    if( method == CV_TM_CCOEFF )
+        integral(img, sum, CV_64F);
+    else
+        integral(img, sum, sqsum, CV_64F);
+
+    common_matchTemplate(sum, sqsum, templ, result, method, cn);
+}
+
+// Copies the channel k of src to the top left corner of the DFT buffer dst and
+// zeroes the rest of its first src.rows rows, the rest rows are skipped by DFT.
+static void fillDFTPlane( const Mat& src, int k, Mat& dst )
+{
+    Mat dst1(dst, Rect(0, 0, src.cols, src.rows));
+    if( src.channels() > 1 )
+    {
+        Mat plane;
+        extractChannel(src, plane, k);
+        plane.convertTo(dst1, dst.depth());
+    }
+    else
+        src.convertTo(dst1, dst.depth());
+
+    if( dst.cols > src.cols )
+        Mat(dst, Range(0, src.rows), Range(src.cols, dst.cols)) = Scalar::all(0);
+}
+
+// Matches several templates against the same image. The cross-correlations are
+// computed by DFTs of the whole image size rather than by blocks: there is no
+// wraparound in the valid part of a circular correlation then, so the spectrum
+// of the image, as well as its integrals, is computed once for all the templates.
+// Templates are processed in parallel.
+class MatchTemplatesInvoker : public ParallelLoopBody
+{
+public:
+    MatchTemplatesInvoker( const Mat& _img, const std::vector<Mat>& _templs,
+                           std::vector<Mat>& _results, int _method ) :
+        templs(&_templs), results(&_results), method(_method), cn(_img.channels())
+    {
+        dftDepth = _img.depth() > CV_8S ? CV_64F : CV_32F;
+        dftSize.width = std::max(getOptimalDFTSize(_img.cols), 2);
+        dftSize.height = getOptimalDFTSize(_img.rows);
+        if( dftSize.width <= 0 || dftSize.height <= 0 )
+            CV_Error( CV_StsOutOfRange, "the input arrays are too big" );
+
+        dftImg.create(dftSize.height*cn, dftSize.width, dftDepth);
+        Ptr<hal::DFT2D> c = hal::DFT2D::create(dftSize.width, dftSize.height, dftDepth, 1, 1,
+                                               CV_HAL_DFT_IS_INPLACE, _img.rows);
+        for( int k = 0; k < cn; k++ )
+        {
+            Mat dst = dftImg.rowRange(k*dftSize.height, (k + 1)*dftSize.height);
+            fillDFTPlane(_img, k, dst);
+            c->apply(dst.data, (int)dst.step, dst.data, (int)dst.step);
+        }
+
+        if( method == CV_TM_CCOEFF )
+            integral(_img, sum, CV_64F);
+        else if( method != CV_TM_CCORR )
+            integral(_img, sum, sqsum, CV_64F);
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        Mat dftTempl(dftSize, dftDepth), dftCorr(dftSize, dftDepth);
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const Mat& templ = (*templs)[i];
+            Mat& result = (*results)[i];
+
+            Ptr<hal::DFT2D> cF = hal::DFT2D::create(dftSize.width, dftSize.height, dftDepth, 1, 1,
+                                                    CV_HAL_DFT_IS_INPLACE, templ.rows);
+            for( int k = 0; k < cn; k++ )
+            {
+                fillDFTPlane(templ, k, dftTempl);
+                cF->apply(dftTempl.data, (int)dftTempl.step, dftTempl.data, (int)dftTempl.step);
+
+                Mat dftImg1 = dftImg.rowRange(k*dftSize.height, (k + 1)*dftSize.height);
+                if( k == 0 )
+                    mulSpectrums(dftImg1, dftTempl, dftCorr, 0, true);
+                else
+                {
+                    mulSpectrums(dftImg1, dftTempl, dftTempl, 0, true);
+                    add(dftCorr, dftTempl, dftCorr);
+                }
+            }
+
+            Ptr<hal::DFT2D> cR = hal::DFT2D::create(dftSize.width, dftSize.height, dftDepth, 1, 1,
+                                                    CV_HAL_DFT_IS_INPLACE | CV_HAL_DFT_INVERSE | CV_HAL_DFT_SCALE,
+                                                    result.rows);
+            cR->apply(dftCorr.data, (int)dftCorr.step, dftCorr.data, (int)dftCorr.step);
+            dftCorr(Rect(0, 0, result.cols, result.rows)).convertTo(result, CV_32F);
+
+            if( method != CV_TM_CCORR )
+                common_matchTemplate(sum, sqsum, templ, result, method, cn);
+        }
+    }
+
+private:
+    const std::vector<Mat>* templs;
+    std::vector<Mat>* results;
+    int method, cn, dftDepth;
+    Size dftSize;
+    Mat dftImg, sum, sqsum;
+};
+
+static Point bestMatchLoc( const Mat& result, int method )
+{
+    Point minLoc, maxLoc;
+    minMaxLoc(result, 0, 0, &minLoc, &maxLoc);
+    return method == CV_TM_SQDIFF || method == CV_TM_SQDIFF_NORMED ? minLoc : maxLoc;
+}
+
+// Coarse-to-fine search: the exhaustive search on the level maxLevel of the
+// pyramids, then the neighbourhood of the best match is refined on every finer
+// level. The rest of the results is filled by the worst score.
+static void matchTemplatesPyr( const Mat& img, const std::vector<Mat>& templs,
+                               std::vector<Mat>& results, int method, int maxLevel )
+{
+    // radius of the neighbourhood to refine on the finer level, in pixels of that level
+    const int radius = 3;
+    size_t i, ntempls = templs.size();
+
+    std::vector<Mat> imgPyr;
+    buildPyramid(img, imgPyr, maxLevel);
+    std::vector<std::vector<Mat> > templPyrs(ntempls);
+    std::vector<Mat> coarseTempls(ntempls), coarseResults(ntempls);
+    for( i = 0; i < ntempls; i++ )
+    {
+        buildPyramid(templs[i], templPyrs[i], maxLevel);
+        coarseTempls[i] = templPyrs[i][maxLevel];
+        const Mat& coarseImg = imgPyr[maxLevel];
+        coarseResults[i].create(coarseImg.rows - coarseTempls[i].rows + 1,
+                                coarseImg.cols - coarseTempls[i].cols + 1, CV_32F);
+    }
+
+    MatchTemplatesInvoker invoker(imgPyr[maxLevel], coarseTempls, coarseResults, method);
+    parallel_for_(Range(0, (int)ntempls), invoker, (double)ntempls);
+
+    float worst = method == CV_TM_SQDIFF || method == CV_TM_SQDIFF_NORMED ? FLT_MAX : -FLT_MAX;
+    for( i = 0; i < ntempls; i++ )
+    {
+        Point best = bestMatchLoc(coarseResults[i], method);
+        for( int level = maxLevel - 1; level >= 0; level-- )
+        {
+            const Mat& levelImg = imgPyr[level];
+            const Mat& levelTempl = templPyrs[i][level];
+            Rect roi = Rect(best.x*2 - radius, best.y*2 - radius, radius*2 + 1, radius*2 + 1) &
+                       Rect(0, 0, levelImg.cols - levelTempl.cols + 1, levelImg.rows - levelTempl.rows + 1);
+            Mat part;
+            matchTemplate(levelImg(Rect(roi.x, roi.y, roi.width + levelTempl.cols - 1,
+                                        roi.height + levelTempl.rows - 1)), levelTempl, part, method);
+            best = bestMatchLoc(part, method) + roi.tl();
+
+            if( level == 0 )
+            {
+                results[i] = Scalar::all(worst);
+                part.copyTo(results[i](roi));
+            }
+        }
+    }
+}
+
 }
 
 
@@ -1132,6 +1297,50 @@ void cv::matchTemplate( InputArray _img, InputArray _templ, OutputArray _result,
     common_matchTemplate(img, templ, result, method, cn);
 }
 
+void cv::matchTemplates( InputArray _img, InputArrayOfArrays _templs, OutputArrayOfArrays _results,
+                        int method, int maxLevel )
+{
+    CV_INSTRUMENT_REGION();
+
+    int type = _img.type(), depth = CV_MAT_DEPTH(type);
+    CV_Assert( CV_TM_SQDIFF <= method && method <= CV_TM_CCOEFF_NORMED );
+    CV_Assert( (depth == CV_8U || depth == CV_32F) && _img.dims() <= 2 && maxLevel >= 0 );
+
+    Mat img = _img.getMat();
+    std::vector<Mat> templs;
+    _templs.getMatVector(templs);
+    int i, ntempls = (int)templs.size();
+
+    _results.create(ntempls, 1, CV_32F);
+    std::vector<Mat> results(ntempls);
+    int minTemplSize = INT_MAX;
+    for( i = 0; i < ntempls; i++ )
+    {
+        const Mat& templ = templs[i];
+        CV_Assert( templ.type() == type && templ.dims <= 2 && !templ.empty() &&
+                   templ.cols <= img.cols && templ.rows <= img.rows );
+        _results.create(img.rows - templ.rows + 1, img.cols - templ.cols + 1, CV_32F, i);
+        results[i] = _results.getMat(i);
+        minTemplSize = std::min(minTemplSize, std::min(templ.cols, templ.rows));
+    }
+    if( ntempls == 0 )
+        return;
+
+    // templates on the coarsest level have to keep enough details to be matched
+    const int minCoarseTemplSize = 8;
+    while( maxLevel > 0 && (minTemplSize >> maxLevel) < minCoarseTemplSize )
+        maxLevel--;
+
+    if( maxLevel > 0 )
+    {
+        matchTemplatesPyr(img, templs, results, method, maxLevel);
+        return;
+    }
+
+    MatchTemplatesInvoker invoker(img, templs, results, method);
+    parallel_for_(Range(0, ntempls), invoker, ntempls);
+}
+
 CV_IMPL void
 cvMatchTemplate( const CvArr* _img, const CvArr* _templ, CvArr* _result, int method )
 {
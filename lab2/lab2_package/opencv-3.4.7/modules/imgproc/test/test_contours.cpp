@@ -485,6 +485,52 @@ TEST(Imgproc_FindContours, border)
     ASSERT_EQ(0, cvtest::norm(img, img_draw_contours, NORM_INF));
 }
 
+// Contours are traced in parallel by bands the connected components don't cross.
+// Contours and hierarchy have to be the same as single threaded ones.
+TEST(Imgproc_FindContours, parallel_bands)
+{
+    const int threads = getNumThreads();
+    RNG& rng = theRNG();
+    Mat blobs = Mat::zeros(512, 640, CV_8UC1), strips = Mat::zeros(512, 640, CV_8UC1);
+    for( int i = 0; i < 200; i++ )
+    {
+        Point center(rng.uniform(0, blobs.cols), rng.uniform(0, blobs.rows));
+        Size axes(rng.uniform(1, 25), rng.uniform(1, 25));
+        ellipse(blobs, center, axes, rng.uniform(0, 180), 0, 360, Scalar::all(rng.uniform(0, 2)), -1);
+    }
+    // many nested contours in strips separated by empty rows
+    for( int y = 4; y + 24 < strips.rows; y += 30 )
+        for( int x = 4; x + 10 < strips.cols; x += 10 )
+        {
+            rectangle(strips, Rect(x, y + (x/10) % 4, 8, 20), Scalar::all(255), -1);
+            rectangle(strips, Rect(x + 2, y + (x/10) % 4 + 2, 4, 16), Scalar::all(0), -1);
+            strips.at<uchar>(y + (x/10) % 4 + 10, x + 4) = 255;
+        }
+
+    const int modes[] = { RETR_EXTERNAL, RETR_LIST, RETR_CCOMP, RETR_TREE };
+    const int methods[] = { CHAIN_APPROX_NONE, CHAIN_APPROX_SIMPLE, CHAIN_APPROX_TC89_KCOS };
+    for( int k = 0; k < 2; k++ )
+    {
+        const Mat& img = k == 0 ? blobs : strips;
+        for( size_t m = 0; m < sizeof(modes)/sizeof(modes[0]); m++ )
+            for( size_t a = 0; a < sizeof(methods)/sizeof(methods[0]); a++ )
+            {
+                SCOPED_TRACE(cv::format("image=%d mode=%d method=%d", k, modes[m], methods[a]));
+                std::vector<std::vector<Point> > contours1, contoursN;
+                std::vector<Vec4i> hierarchy1, hierarchyN;
+
+                setNumThreads(1);
+                findContours(img, contours1, hierarchy1, modes[m], methods[a], Point(3, -2));
+                setNumThreads(std::max(threads, 4));
+                findContours(img, contoursN, hierarchyN, modes[m], methods[a], Point(3, -2));
+
+                EXPECT_TRUE(contours1 == contoursN);
+                EXPECT_TRUE(hierarchy1 == hierarchyN);
+            }
+    }
+    setNumThreads(threads);
+}
+
 TEST(Imgproc_PointPolygonTest, regression_10222)
 {
     vector<Point> contour;
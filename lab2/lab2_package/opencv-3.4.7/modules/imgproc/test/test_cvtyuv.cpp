@@ -724,4 +724,79 @@ INSTANTIATE_TEST_CASE_P(cvt422, Imgproc_ColorYUV,
                       (int)COLOR_YUV2RGBA_YUY2, (int)COLOR_YUV2BGRA_YUY2, (int)COLOR_YUV2RGBA_YVYU, (int)COLOR_YUV2BGRA_YVYU,
                       (int)COLOR_YUV2GRAY_UYVY, (int)COLOR_YUV2GRAY_YUY2));
 
+// Direct conversions to BGR565 must be the same as conversions through BGR
+TEST(Imgproc_ColorYUV2BGR565, accuracy)
+{
+    const int codes[][2] = {
+        { COLOR_YUV2BGR565_NV12, COLOR_YUV2BGR_NV12 }, { COLOR_YUV2BGR565_NV21, COLOR_YUV2BGR_NV21 },
+        { COLOR_YUV2BGR565_UYVY, COLOR_YUV2BGR_UYVY }, { COLOR_YUV2BGR565_YUY2, COLOR_YUV2BGR_YUY2 },
+        { COLOR_YUV2BGR565_YVYU, COLOR_YUV2BGR_YVYU }
+    };
+    RNG& random = theRNG();
+
+    for(size_t k = 0; k < sizeof(codes)/sizeof(codes[0]); k++)
+    {
+        const int code = codes[k][0];
+        const bool is420 = code == COLOR_YUV2BGR565_NV12 || code == COLOR_YUV2BGR565_NV21;
+        for(int iter = 0; iter < 10; ++iter)
+        {
+            Size sz(random.uniform(1, 321)*2, random.uniform(1, 241)*2);
+            int ofs = random.uniform(0, 6);
+
+            Mat src = is420 ? Mat(sz.height/2*3, sz.width, CV_8UC1) : Mat(sz, CV_8UC2);
+            random.fill(src, RNG::UNIFORM, 0, 256);
+
+            Mat bgr, gold;
+            cv::cvtColor(src, bgr, codes[k][1]);
+            cv::cvtColor(bgr, gold, COLOR_BGR2BGR565);
+
+            Mat dst_full(sz.height + ofs, sz.width + ofs, CV_8UC2, Scalar::all(0));
+            Mat dst = dst_full(Rect(ofs, ofs, sz.width, sz.height));
+            cv::cvtColor(src, dst, code);
+
+            EXPECT_EQ(0, countOfDifferencies(gold, dst, 0)) << "code: " << code << ", size: " << sz;
+        }
+    }
+}
+
+TEST(Imgproc_ColorBGR5652YUV, accuracy)
+{
+    const int codes[] = { COLOR_BGR5652YUV_I420, COLOR_BGR5652YUV_YV12, COLOR_BGR5652YUV_NV12, COLOR_BGR5652YUV_NV21 };
+    RNG& random = theRNG();
+
+    for(size_t k = 0; k < sizeof(codes)/sizeof(codes[0]); k++)
+    {
+        const int code = codes[k];
+        for(int iter = 0; iter < 10; ++iter)
+        {
+            Size sz(random.uniform(1, 321)*2, random.uniform(1, 241)*2);
+            int ofs = random.uniform(0, 6);
+
+            Mat src_full(sz.height + ofs, sz.width + ofs, CV_8UC2);
+            random.fill(src_full, RNG::UNIFORM, 0, 256);
+            Mat src = src_full(Rect(ofs, ofs, sz.width, sz.height));
+
+            Mat bgr, gold;
+            cv::cvtColor(src, bgr, COLOR_BGR5652BGR);
+            cv::cvtColor(bgr, gold, code == COLOR_BGR5652YUV_YV12 || code == COLOR_BGR5652YUV_NV21 ?
+                                    COLOR_BGR2YUV_YV12 : COLOR_BGR2YUV_I420);
+            if(code == COLOR_BGR5652YUV_NV12 || code == COLOR_BGR5652YUV_NV21)
+            {
+                // interleave the chroma planes
+                const int area = sz.width*sz.height/4;
+                Mat planes[] = { Mat(sz.height/2, sz.width/2, CV_8UC1, gold.ptr() + sz.width*sz.height),
+                                 Mat(sz.height/2, sz.width/2, CV_8UC1, gold.ptr() + sz.width*sz.height + area) };
+                Mat uv;
+                merge(planes, 2, uv);
+                uv.reshape(1, sz.height/2).copyTo(gold.rowRange(sz.height, gold.rows));
+            }
+
+            Mat dst;
+            cv::cvtColor(src, dst, code);
+
+            EXPECT_EQ(0, countOfDifferencies(gold, dst, 0)) << "code: " << code << ", size: " << sz;
+        }
+    }
+}
+
 }} // namespace
@@ -583,4 +583,126 @@ TEST(Drawing, line)
     ASSERT_THROW(line(mat, Point(1,1),Point(99,99),Scalar(255),0), cv::Exception);
 }
 
+static void drawOverlayRef(Mat& img, const std::vector<Rect>& boxes, const std::vector<String>& labels,
+                           const std::vector<Scalar>& colors, int thickness, int fontFace, double fontScale,
+                           const Scalar& textColor, int lineType)
+{
+    for (size_t i = 0; i < boxes.size(); i++)
+    {
+        Scalar color = colors[colors.size() == 1 ? 0 : i];
+        if (thickness != 0)
+            cv::rectangle(img, boxes[i], color, thickness, lineType);
+        if (labels.empty() || labels[i].empty())
+            continue;
+        int baseLine = 0;
+        Size size = getTextSize(labels[i], fontFace, fontScale, 1, &baseLine);
+        Point org(boxes[i].x, boxes[i].y - size.height - baseLine);
+        org.x = std::max(std::min(org.x, img.cols - size.width), 0);
+        org.y = std::max(org.y, 0);
+        cv::rectangle(img, Rect(org, Size(size.width, size.height + baseLine)), color, FILLED);
+        putText(img, labels[i], Point(org.x, org.y + size.height), fontFace, fontScale, textColor, 1, lineType);
+    }
+}
+
+static void generateDetections(RNG& rng, Size sz, int n, std::vector<Rect>& boxes,
+                               std::vector<String>& labels, std::vector<Scalar>& colors)
+{
+    static const char* names[] = { "person", "car", "bicycle", "dog", "traffic light" };
+    for (int i = 0; i < n; i++)
+    {
+        Point tl(rng.uniform(-20, sz.width - 10), rng.uniform(-20, sz.height - 10));
+        boxes.push_back(Rect(tl, Size(rng.uniform(5, 200), rng.uniform(5, 200))));
+        labels.push_back(format("%s %.1f%%", names[rng.uniform(0, 5)], rng.uniform(0., 100.)));
+        colors.push_back(Scalar(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256)));
+    }
+}
+
+typedef testing::TestWithParam<tuple<int, int> > Drawing_Overlay;
+TEST_P(Drawing_Overlay, regression)
+{
+    const int fontFace = get<0>(GetParam()), thickness = get<1>(GetParam());
+    RNG& rng = theRNG();
+    Size sz(320, 240);
+    std::vector<Rect> boxes;
+    std::vector<String> labels;
+    std::vector<Scalar> colors;
+    generateDetections(rng, sz, 30, boxes, labels, colors);
+    labels[3] = "";
+
+    Mat src(sz, CV_8UC3);
+    rng.fill(src, RNG::UNIFORM, 0, 256);
+
+    // glyphs are placed exactly as putText does when pen positions are multiples of quarter pixel,
+    // antialiased ones are blended with rounding errors and aren't clipped near the image border
+    Mat ref, dst;
+    for (int lineType = LINE_8; lineType <= LINE_AA; lineType += LINE_AA - LINE_8)
+    {
+        const bool aa = lineType == LINE_AA;
+        const Rect roi = aa ? Rect(4, 4, sz.width - 8, sz.height - 8) : Rect(Point(), sz);
+        for (double fontScale = 0.5; fontScale <= 1; fontScale += 0.5)
+        {
+            ref = src.clone(); dst = src.clone();
+            drawOverlayRef(ref, boxes, labels, colors, thickness, fontFace, fontScale, Scalar(0, 0, 0), lineType);
+            drawOverlay(dst, boxes, labels, colors, thickness, fontFace, fontScale, Scalar(0, 0, 0), lineType);
+            EXPECT_LE(cvtest::norm(ref(roi), dst(roi), NORM_INF), aa ? 8 : 0) << "lineType=" << lineType << " fontScale=" << fontScale;
+        }
+
+        // otherwise they are shifted by 1/8 pixel at most
+        ref = src.clone(); dst = src.clone();
+        drawOverlayRef(ref, boxes, labels, colors, thickness, fontFace, 0.7, Scalar(0, 0, 0), lineType);
+        drawOverlay(dst, boxes, labels, colors, thickness, fontFace, 0.7, Scalar(0, 0, 0), lineType);
+        Mat diff;
+        cv::absdiff(ref(roi), dst(roi), diff);
+        cv::cvtColor(diff, diff, COLOR_BGR2GRAY);
+        EXPECT_LT(cv::countNonZero(diff > (aa ? 64 : 0)), sz.area()/100) << "lineType=" << lineType;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Drawing_Overlay, testing::Combine(
+    testing::Values(FONT_HERSHEY_SIMPLEX, FONT_HERSHEY_COMPLEX | FONT_ITALIC, FONT_HERSHEY_SCRIPT_SIMPLEX),
+    testing::Values(1, 2, -1, 0)
+));
+
+TEST(Drawing, overlay_bgr565)
+{
+    RNG& rng = theRNG();
+    Size sz(320, 240);
+    std::vector<Rect> boxes;
+    std::vector<String> labels;
+    std::vector<Scalar> colors;
+    generateDetections(rng, sz, 20, boxes, labels, colors);
+
+    Mat bgr(sz, CV_8UC3), ref, dst;
+    rng.fill(bgr, RNG::UNIFORM, 0, 256);
+    cv::cvtColor(bgr, dst, COLOR_BGR2BGR565);
+    cv::cvtColor(dst, bgr, COLOR_BGR5652BGR);
+
+    drawOverlay(bgr, boxes, labels, colors, 2, FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255));
+    cv::cvtColor(bgr, ref, COLOR_BGR2BGR565);
+    Mat src565 = dst.clone();
+    drawOverlay(dst, boxes, labels, colors, 2, FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255), LINE_8, OVERLAY_BGR565);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+
+    // LINE_AA: boxes are drawn as LINE_8 ones, both outlines and filled ones
+    for (int thickness = 2; thickness >= -1; thickness -= 3)
+    {
+        ref = src565.clone(); dst = src565.clone();
+        drawOverlay(ref, boxes, std::vector<String>(), colors, thickness, FONT_HERSHEY_SIMPLEX, 0.5, Scalar(), LINE_8, OVERLAY_BGR565);
+        drawOverlay(dst, boxes, std::vector<String>(), colors, thickness, FONT_HERSHEY_SIMPLEX, 0.5, Scalar(), LINE_AA, OVERLAY_BGR565);
+        EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << "thickness=" << thickness;
+    }
+
+    // and glyphs are antialiased as in BGR images, up to rounding errors of blending
+    // and 8 levels of 5-bit channels of packed pixels
+    const Rect roi(4, 4, sz.width - 8, sz.height - 8);
+    cv::cvtColor(src565, bgr, COLOR_BGR5652BGR);
+    dst = src565.clone();
+    drawOverlay(bgr, boxes, labels, colors, 0, FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255), LINE_AA);
+    drawOverlay(dst, boxes, labels, colors, 0, FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255, 255, 255), LINE_AA, OVERLAY_BGR565);
+    cv::cvtColor(dst, ref, COLOR_BGR5652BGR);
+    EXPECT_LE(cvtest::norm(bgr(roi), ref(roi), NORM_INF), 24);
+
+    EXPECT_THROW(drawOverlay(bgr, boxes, labels, colors, 2, FONT_HERSHEY_SIMPLEX, 0.5, Scalar(), LINE_8, OVERLAY_BGR565), cv::Exception);
+}
+
 }} // namespace
@@ -2272,6 +2272,78 @@ TEST(Imgproc_MedianBlur, hires_regression_13409)
     ASSERT_EQ(0.0, cvtest::norm(dst_hires(Rect(516, 516, 1016, 1016)), dst_ref(Rect(4, 4, 1016, 1016)), NORM_INF));
 }
 
+template<typename T> static void
+test_medianFilterSort( const Mat& src0, Mat& dst, int m )
+{
+    Mat src;
+    cv::copyMakeBorder(src0, src, m/2, m/2, m/2, m/2, BORDER_REPLICATE);
+    dst.create(src0.size(), src0.type());
+    int cn = src0.channels();
+    std::vector<T> buf(m*m);
+    for( int y = 0; y < dst.rows; y++ )
+        for( int x = 0; x < dst.cols*cn; x++ )
+        {
+            for( int dy = 0; dy < m; dy++ )
+                for( int dx = 0; dx < m; dx++ )
+                    buf[dy*m + dx] = src.ptr<T>(y + dy)[x + dx*cn];
+            std::nth_element(buf.begin(), buf.begin() + m*m/2, buf.end());
+            dst.ptr<T>(y)[x] = buf[m*m/2];
+        }
+}
+
+TEST(Imgproc_MedianBlur, large_aperture_types)
+{
+    const int types[] = { CV_8UC2, CV_16UC1, CV_16SC3, CV_32FC1, CV_32FC4 };
+    RNG& rng = theRNG();
+    for( size_t t = 0; t < sizeof(types)/sizeof(types[0]); t++ )
+        for( int ksize = 7; ksize <= 9; ksize += 2 )
+        {
+            SCOPED_TRACE(cv::format("type=%d ksize=%d", types[t], ksize));
+            Mat src(37, 29, types[t]), dst, ref;
+            int depth = src.depth();
+            rng.fill(src, RNG::UNIFORM, depth == CV_16S || depth == CV_32F ? -1000 : 0, depth == CV_8U ? 256 : 1000);
+
+            cv::medianBlur(src, dst, ksize);
+            switch( depth )
+            {
+            case CV_8U: test_medianFilterSort<uchar>(src, ref, ksize); break;
+            case CV_16U: test_medianFilterSort<ushort>(src, ref, ksize); break;
+            case CV_16S: test_medianFilterSort<short>(src, ref, ksize); break;
+            default: test_medianFilterSort<float>(src, ref, ksize); break;
+            }
+            EXPECT_EQ(0, cvtest::norm(dst, ref, NORM_INF));
+
+            cv::medianBlur(src, src, ksize);
+            EXPECT_EQ(0, cvtest::norm(src, ref, NORM_INF));
+        }
+    EXPECT_THROW(cv::medianBlur(Mat(16, 16, CV_32FC1, Scalar::all(0)), Mat(), 11), cv::Exception);
+}
+
+// The histogram based filters are split by stripes of columns and rows, the
+// results have to be the same as single threaded ones.
+TEST(Imgproc_MedianBlur, parallel_stripes)
+{
+    const int threads = getNumThreads();
+    const int types[] = { CV_8UC1, CV_8UC3, CV_32FC1 };
+    const int ksizes[] = { 7, 9, 17, 31 };
+    for( size_t t = 0; t < sizeof(types)/sizeof(types[0]); t++ )
+        for( size_t k = 0; k < sizeof(ksizes)/sizeof(ksizes[0]); k++ )
+        {
+            if( CV_MAT_DEPTH(types[t]) != CV_8U && ksizes[k] > 9 )
+                continue;
+            SCOPED_TRACE(cv::format("type=%d ksize=%d", types[t], ksizes[k]));
+            Mat src(480, 643, types[t]), dst1, dstN;
+            randu(src, 0, 256);
+
+            setNumThreads(1);
+            cv::medianBlur(src, dst1, ksizes[k]);
+            setNumThreads(std::max(threads, 4));
+            cv::medianBlur(src, dstN, ksizes[k]);
+            EXPECT_EQ(0, cvtest::norm(dst1, dstN, NORM_INF));
+        }
+    setNumThreads(threads);
+}
+
 TEST(Imgproc_Sobel, s16_regression_13506)
 {
     Mat src = (Mat_<short>(8, 16) << 127, 138, 130, 102, 118,  97,  76,  84, 124,  90, 146,  63, 130,  87, 212,  85,
@@ -2295,6 +2367,116 @@ TEST(Imgproc_Sobel, s16_regression_13506)
     ASSERT_EQ(0.0, cvtest::norm(dst, ref, NORM_INF));
 }
 
+// Filters process images by stripes in parallel. Results have to be the same
+// as single threaded ones including stripe seams and ROI borders.
+TEST(Imgproc_Filtering, parallel_stripes)
+{
+    Mat big(1100, 700, CV_8UC3);
+    randu(big, 0, 256);
+    const Mat src = big(Rect(10, 30, 640, 1040));
+    Mat kernel2D(5, 5, CV_32F);
+    randu(kernel2D, -1, 1);
+    const int borders[] = {BORDER_CONSTANT, BORDER_REPLICATE, BORDER_REFLECT_101,
+                           BORDER_REFLECT_101 | BORDER_ISOLATED};
+    const int threads = getNumThreads();
+    for (int i = 0; i < 4; ++i)
+    {
+        Mat dst[2][5];
+        for (int j = 0; j < 2; ++j)
+        {
+            setNumThreads(j == 0 ? 1 : std::max(threads, 4));
+            GaussianBlur(src, dst[j][0], Size(7, 7), 1.5, 0, borders[i]);
+            Sobel(src, dst[j][1], CV_16S, 1, 1, 3, 1, 0, borders[i]);
+            Laplacian(src, dst[j][2], CV_32F, 5, 1, 0, borders[i]);
+            cv::filter2D(src, dst[j][3], CV_16S, kernel2D, Point(-1, -1), 0, borders[i]);
+            // In-place.
+            dst[j][4] = src.clone();
+            cv::filter2D(dst[j][4], dst[j][4], -1, kernel2D, Point(1, 3), 3, borders[i]);
+        }
+        setNumThreads(threads);
+        for (int k = 0; k < 5; ++k)
+            EXPECT_EQ(0, cvtest::norm(dst[0][k], dst[1][k], NORM_INF)) << "border: " << borders[i] << " filter: " << k;
+    }
+}
+
+TEST(Imgproc_Morphology, parallel_stripes)
+{
+    Mat big(1100, 700, CV_8UC3);
+    randu(big, 0, 256);
+    const Mat src = big(Rect(10, 30, 640, 1040));
+    const Mat ellipse = getStructuringElement(MORPH_ELLIPSE, Size(7, 5));
+    const Mat rect = getStructuringElement(MORPH_RECT, Size(35, 9));
+    const int borders[] = {BORDER_CONSTANT, BORDER_REPLICATE, BORDER_REFLECT_101,
+                           BORDER_REFLECT_101 | BORDER_ISOLATED};
+    const int threads = getNumThreads();
+    for (int i = 0; i < 4; ++i)
+    {
+        Mat dst[2][5];
+        for (int j = 0; j < 2; ++j)
+        {
+            setNumThreads(j == 0 ? 1 : std::max(threads, 4));
+            cv::erode(src, dst[j][0], ellipse, Point(-1, -1), 1, borders[i]);
+            cv::dilate(src, dst[j][1], ellipse, Point(2, 1), 2, borders[i]);
+            cv::erode(src, dst[j][2], rect, Point(-1, -1), 1, borders[i]);
+            cv::dilate(src, dst[j][3], rect, Point(30, 1), 2, borders[i]);
+            // In-place.
+            dst[j][4] = src.clone();
+            cv::erode(dst[j][4], dst[j][4], ellipse, Point(-1, -1), 1, borders[i]);
+        }
+        setNumThreads(threads);
+        for (int k = 0; k < 5; ++k)
+            EXPECT_EQ(0, cvtest::norm(dst[0][k], dst[1][k], NORM_INF)) << "border: " << borders[i] << " filter: " << k;
+    }
+}
+
+// Large rectangular kernels are processed by van Herk/Gil-Werman filters.
+// Reference is computed by brute force on the source with border added.
+TEST(Imgproc_Morphology, vHGW_rect_kernels)
+{
+    const int types[] = {CV_8UC1, CV_8UC3, CV_8UC4, CV_16UC4, CV_16SC2, CV_32FC1, CV_32FC2, CV_64FC1};
+    const Size ksizes[] = {Size(64, 1), Size(1, 16), Size(9, 20), Size(40, 40), Size(70, 3), Size(65, 17)};
+    const int borders[] = {BORDER_CONSTANT, BORDER_REPLICATE, BORDER_REFLECT, BORDER_REFLECT_101};
+    RNG& rng = theRNG();
+    for (int t = 0; t < 8; ++t)
+    {
+        for (int k = 0; k < 6; ++k)
+        {
+            const Size ksize = ksizes[k];
+            const Mat kernel = getStructuringElement(MORPH_RECT, ksize);
+            for (int b = 0; b < 4; ++b)
+            {
+                // The whole image or ROI far from the image edges.
+                const bool roi = b % 2 == 1;
+                Mat big(61 + (roi ? 2 * ksize.height : 0), 47 + (roi ? 2 * ksize.width : 0), types[t]);
+                randu(big, 0, 200);
+                const Mat src = roi ? big(Rect(ksize.width, ksize.height, 47, 61)) : big;
+                const Point anchor(rng.uniform(0, ksize.width), rng.uniform(0, ksize.height));
+                for (int op = MORPH_ERODE; op <= MORPH_DILATE; ++op)
+                {
+                    Mat dst, ref, padded;
+                    double neutral = op == MORPH_ERODE ? 255 : -1000;
+                    cv::copyMakeBorder(src, padded, anchor.y, ksize.height - anchor.y - 1,
+                                       anchor.x, ksize.width - anchor.x - 1, borders[b], Scalar::all(neutral));
+                    if (op == MORPH_ERODE)
+                    {
+                        cv::erode(src, dst, kernel, anchor, 1, borders[b]);
+                        cvtest::erode(padded, ref, kernel, anchor, BORDER_REPLICATE);
+                    }
+                    else
+                    {
+                        cv::dilate(src, dst, kernel, anchor, 1, borders[b]);
+                        cvtest::dilate(padded, ref, kernel, anchor, BORDER_REPLICATE);
+                    }
+                    ref = ref(Rect(anchor.x, anchor.y, src.cols, src.rows));
+                    ASSERT_EQ(0, cvtest::norm(ref, dst, NORM_INF))
+                        << "type: " << types[t] << " ksize: " << ksize << " anchor: " << anchor
+                        << " border: " << borders[b] << " op: " << op;
+                }
+            }
+        }
+    }
+}
+
 TEST(Imgproc_Pyrdown, issue_12961)
 {
     Mat src(9, 9, CV_8UC1, Scalar::all(0));
@@ -2303,4 +2485,119 @@ TEST(Imgproc_Pyrdown, issue_12961)
     ASSERT_EQ(0.0, cv::norm(dst));
 }
 
+TEST(Imgproc_Integral, parallel_stripes)
+{
+    const int types[] = {CV_8UC1, CV_8UC1, CV_8UC1, CV_8UC1, CV_8UC1, CV_8UC3, CV_16UC1, CV_16SC2};
+    const int sdepths[] = {CV_32S, CV_32S, CV_32F, CV_64F, CV_32S, CV_32S, CV_64F, CV_64F};
+    const int sqdepths[] = {CV_64F, CV_32S, CV_64F, CV_64F, CV_32F, CV_64F, CV_64F, CV_64F};
+    const Size sizes[] = {Size(1283, 1001), Size(64, 2049), Size(31, 700)};
+    const int threads = getNumThreads();
+    for (int t = 0; t < 8; ++t)
+    {
+        for (int s = 0; s < 3; ++s)
+        {
+            Mat src(sizes[s], types[t]);
+            randu(src, CV_MAT_DEPTH(types[t]) == CV_16S ? -1000 : 0, CV_MAT_DEPTH(types[t]) == CV_8U ? 256 : 1000);
+
+            // the reference in doubles is exact for these sizes
+            const int cn = src.channels();
+            Mat srcd, ref(src.rows + 1, src.cols + 1, CV_64FC(cn), Scalar::all(0));
+            Mat refsq(ref.size(), ref.type(), Scalar::all(0));
+            src.convertTo(srcd, CV_64F);
+            for (int y = 0; y < src.rows; ++y)
+            {
+                const double* srow = srcd.ptr<double>(y);
+                const double *prev = ref.ptr<double>(y), *prevsq = refsq.ptr<double>(y);
+                double *row = ref.ptr<double>(y + 1), *rowsq = refsq.ptr<double>(y + 1);
+                for (int k = 0; k < cn; ++k)
+                {
+                    double v = 0, vsq = 0;
+                    for (int x = 0; x < src.cols; ++x)
+                    {
+                        double it = srow[x*cn + k];
+                        v += it;
+                        vsq += it*it;
+                        row[(x + 1)*cn + k] = prev[(x + 1)*cn + k] + v;
+                        rowsq[(x + 1)*cn + k] = prevsq[(x + 1)*cn + k] + vsq;
+                    }
+                }
+            }
+
+            Mat sum[2], sqsum[2];
+            for (int j = 0; j < 2; ++j)
+            {
+                setNumThreads(j == 0 ? 1 : std::max(threads, 4));
+                cv::integral(src, sum[j], sqsum[j], sdepths[t], sqdepths[t]);
+            }
+            setNumThreads(threads);
+
+            const double sumEps = sdepths[t] == CV_32F ? 1e-4 : 0;
+            const double sqsumEps = sqdepths[t] == CV_32F ? 1e-4 : 0;
+            for (int j = 0; j < 2; ++j)
+            {
+                Mat sumd, sqsumd;
+                sum[j].convertTo(sumd, CV_64F);
+                sqsum[j].convertTo(sqsumd, CV_64F);
+                EXPECT_LE(cvtest::norm(ref, sumd, NORM_INF | NORM_RELATIVE), sumEps)
+                    << "type: " << types[t] << " sdepth: " << sdepths[t] << " size: " << sizes[s] << " threads: " << j;
+                if (sqdepths[t] != CV_32S) // 32-bit squared sums may overflow
+                {
+                    EXPECT_LE(cvtest::norm(refsq, sqsumd, NORM_INF | NORM_RELATIVE), sqsumEps)
+                        << "type: " << types[t] << " sqdepth: " << sqdepths[t] << " size: " << sizes[s] << " threads: " << j;
+                }
+            }
+            EXPECT_EQ(0, cvtest::norm(sum[0], sum[1], NORM_INF));
+            EXPECT_EQ(0, cvtest::norm(sqsum[0], sqsum[1], NORM_INF));
+        }
+    }
+}
+
+TEST(Imgproc_Pyramid, parallel_stripes)
+{
+    const int types[] = {CV_8UC1, CV_8UC3, CV_16SC1, CV_32FC4, CV_64FC1};
+    const Size sizes[] = {Size(1280, 1047), Size(333, 998), Size(2001, 75)};
+    const int borders[] = {BORDER_REFLECT_101, BORDER_REPLICATE, BORDER_REFLECT};
+    const int maxlevel = 5;
+    const int threads = getNumThreads();
+    for (int t = 0; t < 5; ++t)
+    {
+        for (int s = 0; s < 3; ++s)
+        {
+            Mat src(sizes[s], types[t]);
+            randu(src, -100, 200);
+            for (int b = 0; b < 3; ++b)
+            {
+                Mat down[2], up[2];
+                std::vector<Mat> pyr[2], chain(maxlevel + 1);
+                for (int j = 0; j < 2; ++j)
+                {
+                    setNumThreads(j == 0 ? 1 : std::max(threads, 4));
+                    cv::pyrDown(src, down[j], Size(), borders[b]);
+                    cv::pyrUp(src, up[j]);
+                    cv::buildPyramid(src, pyr[j], maxlevel, borders[b]);
+                }
+                setNumThreads(1);
+                chain[0] = src;
+                for (int k = 1; k <= maxlevel; ++k)
+                    cv::pyrDown(chain[k-1], chain[k], Size(), borders[b]);
+                setNumThreads(threads);
+
+                EXPECT_EQ(0, cvtest::norm(down[0], down[1], NORM_INF)) << "type: " << types[t] << " size: " << sizes[s] << " border: " << borders[b];
+                EXPECT_EQ(0, cvtest::norm(up[0], up[1], NORM_INF)) << "type: " << types[t] << " size: " << sizes[s];
+                for (int j = 0; j < 2; ++j)
+                {
+                    ASSERT_EQ(maxlevel + 1, (int)pyr[j].size());
+                    for (int k = 1; k <= maxlevel; ++k)
+                    {
+                        ASSERT_EQ(chain[k].size(), pyr[j][k].size());
+                        EXPECT_EQ(0, cvtest::norm(chain[k], pyr[j][k], NORM_INF))
+                            << "type: " << types[t] << " size: " << sizes[s] << " border: " << borders[b]
+                            << " threads: " << j << " level: " << k;
+                    }
+                }
+            }
+        }
+    }
+}
+
 }} // namespace
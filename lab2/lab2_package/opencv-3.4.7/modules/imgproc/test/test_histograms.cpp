@@ -1948,5 +1948,60 @@ TEST(Imgproc_Hist_Calc, calcHist_regression_11544)
     }
 }
 
+typedef testing::TestWithParam<tuple<int, int, bool> > Imgproc_ExtractLuma;
+
+TEST_P(Imgproc_ExtractLuma, accuracy)
+{
+    const int code = get<0>(GetParam());
+    const int scale = get<1>(GetParam());
+    const bool equalize = get<2>(GetParam());
+    RNG& rng = theRNG();
+
+    for (int iter = 0; iter < 10; iter++)
+    {
+        // whole blocks and dropped remainders, small sizes go to the scalar tails
+        Size sz(rng.uniform(1, 96) * 2 * scale, rng.uniform(1, 64) * 2 * scale);
+        if (iter % 2)
+        {
+            sz.width += rng.uniform(0, scale) * 2;
+            sz.height += rng.uniform(0, scale) * 2;
+        }
+
+        Mat src;
+        if (code == COLOR_YUV2GRAY_420)
+            src.create(sz.height / 2 * 3, sz.width, CV_8UC1);
+        else
+            src.create(sz, CV_8UC2);
+        // narrow range makes equalization nontrivial
+        rng.fill(src, RNG::UNIFORM, 16, iter < 5 ? 256 : 96);
+
+        Mat gray, ref;
+        cv::cvtColor(src, gray, code);
+        gray = gray(Rect(0, 0, gray.cols / scale * scale, gray.rows / scale * scale));
+        cv::resize(gray, ref, Size(gray.cols / scale, gray.rows / scale), 0, 0, INTER_AREA);
+        if (equalize)
+            cv::equalizeHist(ref, ref);
+
+        Mat dst;
+        cv::extractLuma(src, dst, code, scale, equalize);
+
+        ASSERT_EQ(ref.size(), dst.size()) << sz;
+        EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << sz;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_ExtractLuma, testing::Combine(
+    testing::Values((int)COLOR_YUV2GRAY_420, (int)COLOR_YUV2GRAY_UYVY, (int)COLOR_YUV2GRAY_YUY2),
+    testing::Values(1, 2, 3, 4, 7),
+    testing::Bool()));
+
+TEST(Imgproc_ExtractLumaEqualize, constant)
+{
+    Mat src(48, 64, CV_8UC2, Scalar(77, 128)), dst;
+    cv::extractLuma(src, dst, COLOR_YUV2GRAY_YUY2, 4, true);
+    EXPECT_EQ(Size(16, 12), dst.size());
+    EXPECT_EQ(0, cvtest::norm(dst, Mat(dst.size(), CV_8UC1, Scalar(77)), NORM_INF));
+}
+
 }} // namespace
 /* End Of File */
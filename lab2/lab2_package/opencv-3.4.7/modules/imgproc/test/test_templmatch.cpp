@@ -334,4 +334,70 @@ void CV_TemplMatchTest::prepare_to_validation( int /*test_case_idx*/ )
 
 TEST(Imgproc_MatchTemplate, accuracy) { CV_TemplMatchTest test; test.safe_run(); }
 
+TEST(Imgproc_MatchTemplates, accuracy)
+{
+    const int types[] = { CV_8UC1, CV_8UC3, CV_32FC1 };
+    const Size templSizes[] = { Size(5, 5), Size(17, 9), Size(30, 41) };
+    const int ntempls = (int)(sizeof(templSizes)/sizeof(templSizes[0]));
+    for( size_t t = 0; t < sizeof(types)/sizeof(types[0]); t++ )
+    {
+        Mat img(123, 157, types[t]);
+        randu(img, 0, 256);
+        cv::GaussianBlur(img, img, Size(5, 5), 1.5);
+        std::vector<Mat> templs;
+        for( int i = 0; i < ntempls; i++ )
+            templs.push_back(img(Rect(Point(i*37, i*29), templSizes[i])).clone());
+
+        for( int method = TM_SQDIFF; method <= TM_CCOEFF_NORMED; method++ )
+        {
+            SCOPED_TRACE(cv::format("type=%d method=%d", types[t], method));
+            std::vector<Mat> results;
+            cv::matchTemplates(img, templs, results, method);
+            ASSERT_EQ((size_t)ntempls, results.size());
+            for( int i = 0; i < ntempls; i++ )
+            {
+                Mat ref;
+                cv::matchTemplate(img, templs[i], ref, method);
+                ASSERT_EQ(ref.size(), results[i].size());
+                double maxVal = std::max(cvtest::norm(ref, NORM_INF), 1.);
+                EXPECT_LE(cvtest::norm(results[i], ref, NORM_INF), maxVal*1e-4);
+            }
+        }
+    }
+}
+
+TEST(Imgproc_MatchTemplates, coarse_to_fine)
+{
+    Mat img(480, 640, CV_8UC1);
+    randu(img, 0, 256);
+    cv::GaussianBlur(img, img, Size(7, 7), 2);
+    const Point locs[] = { Point(123, 77), Point(401, 300), Point(0, 431) };
+    const Size templSize(48, 40);
+    std::vector<Mat> templs;
+    for( size_t i = 0; i < sizeof(locs)/sizeof(locs[0]); i++ )
+        templs.push_back(img(Rect(locs[i], templSize)).clone());
+
+    const int methods[] = { TM_SQDIFF, TM_SQDIFF_NORMED, TM_CCORR_NORMED, TM_CCOEFF_NORMED };
+    for( size_t m = 0; m < sizeof(methods)/sizeof(methods[0]); m++ )
+    {
+        SCOPED_TRACE(cv::format("method=%d", methods[m]));
+        std::vector<Mat> results;
+        cv::matchTemplates(img, templs, results, methods[m], 2);
+        for( size_t i = 0; i < templs.size(); i++ )
+        {
+            Mat ref;
+            cv::matchTemplate(img, templs[i], ref, methods[m]);
+            double minVal, maxVal;
+            Point minLoc, maxLoc;
+            cv::minMaxLoc(results[i], &minVal, &maxVal, &minLoc, &maxLoc);
+            bool sqdiff = methods[m] == TM_SQDIFF || methods[m] == TM_SQDIFF_NORMED;
+            Point best = sqdiff ? minLoc : maxLoc;
+            EXPECT_EQ(locs[i], best);
+            double eps = methods[m] == TM_SQDIFF ? 255. * 255. * templSize.area() * 1e-6 : 1e-3;
+            EXPECT_NEAR(ref.at<float>(best), results[i].at<float>(best), eps);
+            EXPECT_EQ(sqdiff ? FLT_MAX : -FLT_MAX, sqdiff ? maxVal : minVal);
+        }
+    }
+}
+
 }} // namespace